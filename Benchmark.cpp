@@ -0,0 +1,358 @@
+// ************************************************************************************* //
+//      Benchmark of the programs of the Facility Location Reformulation of the          //
+//    General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) //
+//	 																					 //
+//	  Runs every program of the benchmark file on every instance, with every seed	 //
+//	  and every number of threads (options seed=<n> and threads=<n> of the			 //
+//	  programs), and collects the records of the runs (RCLSP-MSL_Results.h) in one	 //
+//	  table: objective function value, gap to the bound of the run (the linear		 //
+//	  relaxation for the heuristics), time, time of the first incumbent and peak		 //
+//	  memory. With a baseline (a table of a previous benchmark) the runs that are		 //
+//	  worse than the baseline beyond the tolerances are flagged as regressions		 //
+//																						 //
+//	  Benchmark file, one list in each line (# begins a comment):					 //
+//	     programs RCLSP-MSL RFH SH_v1 SH_v2 SH_v2_FO SH_v3 SH_v4 SH_v4_FO			 //
+//	     instances <input data file> ...											 //
+//	     seeds 1 2 3																 //
+//	     threads 1 4																 //
+//	     options <name=value> ... (given to all the runs)							 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Json.h"
+
+
+using namespace std;
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+//Run of the benchmark: program, instance, seed, threads and the values
+//of its record (NAN if the record does not have the value)
+struct BenchmarkRun {
+
+	string program, instance;
+	int seed, threads;
+
+	string status;
+	double OF, Bound, Gap, Time, FirstIncumbent, Memory, Wall;
+	string regression;												  //reasons of the regression (empty: none)
+
+	BenchmarkRun() : seed(0), threads(1), status("NoRecord"), OF(NAN), Bound(NAN), Gap(NAN), Time(NAN),
+					 FirstIncumbent(NAN), Memory(NAN), Wall(NAN) {}
+
+	string key() const
+	{
+		ostringstream k;
+		k << program << "," << instance << "," << seed << "," << threads;
+		return k.str();
+	}
+
+};
+
+
+
+
+//Read the lists of the benchmark file
+//Return false if there is no program or no instance
+static bool ReadBenchmark(istream &in, map<string, vector<string> > &lists)
+{
+	string line, word, name;
+
+	while (getline(in, line)) {
+		if (line.find('#') != string::npos) line.erase(line.find('#'));
+
+		istringstream words(line);
+		if (!(words >> name)) continue;
+
+		while (words >> word)
+			lists[name].push_back(word);
+	}
+
+	return !lists["programs"].empty() && !lists["instances"].empty();
+}
+
+
+
+
+//Values of the last record of the results file of a run
+static void ReadRecord(const string &file, BenchmarkRun &run)
+{
+	ifstream in(file.c_str());
+	string line, last;
+
+	while (getline(in, line))
+		if (!line.empty()) last = line;
+
+	RCLSPMSL_Json rec;
+	if (last.empty() || !ReadJson(last, rec)) return;
+
+	run.status = rec.getString("status", "NoSolution");
+	run.Bound = rec.getNum("bound", NAN);
+	run.Memory = rec.getNum("peak_rss_mb", NAN);
+
+	if (rec.getBool("solved", false)) {
+		run.OF = rec.getNum("OF", NAN);
+		run.Gap = rec.getNum("gap", NAN);
+		run.Time = rec.getNum("time", NAN);
+		run.FirstIncumbent = rec.getNum("first_incumbent", NAN);
+	}
+}
+
+
+
+
+//Number of a field of the table (empty: NAN)
+static double Field(const vector<string> &f, size_t n)
+{
+	return ((n < f.size()) && !f[n].empty()) ? atof(f[n].c_str()) : NAN;
+}
+
+
+//Read the table of a previous benchmark (the runs by key)
+static bool ReadTable(istream &in, map<string, BenchmarkRun> &table)
+{
+	string line, field;
+
+	if (!getline(in, line)) return false;
+
+	while (getline(in, line)) {
+		if (!line.empty() && (line[line.size()-1] == '\r')) line.erase(line.size()-1);
+
+		vector<string> f;
+		istringstream fields(line);
+		while (getline(fields, field, ','))
+			f.push_back(field);
+		if (f.size() < 12) continue;
+
+		BenchmarkRun run;
+		run.program = f[0];
+		run.instance = f[1];
+		run.seed = atoi(f[2].c_str());
+		run.threads = atoi(f[3].c_str());
+		run.status = f[4];
+		run.OF = Field(f, 5);
+		run.Bound = Field(f, 6);
+		run.Gap = Field(f, 7);
+		run.Time = Field(f, 8);
+		run.FirstIncumbent = Field(f, 9);
+		run.Memory = Field(f, 10);
+		run.Wall = Field(f, 11);
+		table[run.key()] = run;
+	}
+
+	return true;
+}
+
+
+//Write a value of the table (empty if it is NAN)
+static string Value(double v)
+{
+	if (std::isnan(v)) return "";
+
+	char text[40];
+	sprintf(text, "%.10g", v);
+	return text;
+}
+
+
+static void WriteRun(ostream &out, const BenchmarkRun &run)
+{
+	out << run.key() << "," << run.status << "," << Value(run.OF) << "," << Value(run.Bound) << "," << Value(run.Gap) << ","
+		<< Value(run.Time) << "," << Value(run.FirstIncumbent) << "," << Value(run.Memory) << "," << Value(run.Wall) << ","
+		<< run.regression << endl;
+}
+
+
+
+
+//Compare the run with the baseline: a solution lost, an objective function
+//value, a time or a peak memory worse than the baseline beyond the
+//tolerances (%); the times below one second are not compared
+static string Regression(const BenchmarkRun &run, const BenchmarkRun &base, double tolOF, double tolTime, double tolMemory)
+{
+	string r;
+
+	if (!std::isnan(base.OF) && std::isnan(run.OF)) r += "solution ";
+	if (!std::isnan(base.OF) && (run.OF > base.OF + fabs(base.OF)*tolOF/100 + 1e-6)) r += "OF ";
+	if (!std::isnan(base.Time) && (run.Time > base.Time*(1 + tolTime/100)) && (run.Time - base.Time > 1)) r += "time ";
+	if (!std::isnan(base.Memory) && (run.Memory > base.Memory*(1 + tolMemory/100))) r += "memory ";
+
+	if (!r.empty()) r.erase(r.size() - 1);
+	return r;
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 3) {
+		cerr << "Usage: Benchmark <benchmark file> <results table> [baseline=file] [bin=directory] [work=directory] "
+				"[of_tol=%] [time_tol=%] [memory_tol=%]" << endl;
+		return 1;
+	}
+
+
+	//Benchmark File
+	ifstream in(argv[1]);
+	map<string, vector<string> > lists;
+
+	if (!in || !ReadBenchmark(in, lists)) {
+		cerr << "No programs or instances in the file: " << argv[1] << endl;
+		return 1;
+	}
+
+	if (lists["seeds"].empty()) lists["seeds"].push_back("0");
+	if (lists["threads"].empty()) lists["threads"].push_back("1");
+
+
+	//Options: baseline - table of a previous benchmark (no comparison if it is not given)
+	//bin  - directory of the programs; work - directory of the output files of the runs
+	//of_tol, time_tol, memory_tol - tolerances (%) of the regressions
+	RCLSPMSL_Options Options(argc, argv, 3);
+	string Baseline = Options.getString("baseline", "");
+	string Bin = Options.getString("bin", ".");
+	string Work = Options.getString("work", ".");
+	double Tol_OF = Options.getNum("of_tol", 0.1);
+	double Tol_Time = Options.getNum("time_tol", 20);
+	double Tol_Memory = Options.getNum("memory_tol", 20);
+
+	string RunOptions;
+	for(size_t a = 0; a < lists["options"].size(); a++)
+		RunOptions += " " + lists["options"][a];
+
+
+	map<string, BenchmarkRun> base;
+
+	if (!Baseline.empty()) {
+		ifstream inbase(Baseline.c_str());
+
+		if (!inbase || !ReadTable(inbase, base)) {
+			cerr << "No such file: " << Baseline << endl;
+			return 1;
+		}
+	}
+
+
+	//Results Table
+	ofstream out(argv[2]);
+	out << "program,instance,seed,threads,status,OF,bound,gap,time,first_incumbent,peak_memory_mb,wall,regression" << endl;
+
+
+
+	// ***** Runs: programs x instances x seeds x threads *****
+
+	vector<BenchmarkRun> runs;
+	int regressions = 0, n = 0;
+
+	for(size_t p = 0; p < lists["programs"].size(); p++)
+		for(size_t i = 0; i < lists["instances"].size(); i++)
+			for(size_t s = 0; s < lists["seeds"].size(); s++)
+				for(size_t t = 0; t < lists["threads"].size(); t++){
+					BenchmarkRun run;
+					run.program = lists["programs"][p];
+					run.instance = lists["instances"][i];
+					run.seed = atoi(lists["seeds"][s].c_str());
+					run.threads = atoi(lists["threads"][t].c_str());
+
+					//Output data file and record of the run, in the work directory
+					ostringstream name;
+					name << Work << "/" << run.program << "_" << i+1 << "_s" << run.seed << "_t" << run.threads;
+					string Record = name.str() + ".json";
+					remove(Record.c_str());
+
+					ostringstream command;
+					command << Bin << "/" << run.program << " " << run.instance << " " << name.str() << ".out results=" << Record
+							<< " seed=" << run.seed << " threads=" << run.threads << RunOptions << " > " << name.str() << ".stdout 2>&1";
+
+					cout << "Run " << ++n << ": " << run.key() << endl;
+
+					std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+					if (system(command.str().c_str()) != 0) cout << "    the run did not end normally" << endl;
+					run.Wall = Elapsed(begin);
+
+					ReadRecord(Record, run);
+
+					map<string, BenchmarkRun>::const_iterator b = base.find(run.key());
+					if (b != base.end()) run.regression = Regression(run, b->second, Tol_OF, Tol_Time, Tol_Memory);
+					if (!run.regression.empty()) regressions++;
+
+					WriteRun(out, run);
+					out.flush();
+					runs.push_back(run);
+				}
+
+
+
+	// ****************************************************************************************************
+	//Print in the standard output: averages of each program over its solved
+	//runs and the largest peak memory
+	cout << endl;
+	cout << setw(12) << left << "Program" << right << setw(8) << "Runs" << setw(8) << "Solved" << setw(12) << "Gap (%)"
+		 << setw(12) << "Time" << setw(14) << "Incumbent" << setw(14) << "Memory (MB)" << setw(13) << "Regressions" << endl;
+
+	for(size_t p = 0; p < lists["programs"].size(); p++){
+		int nruns = 0, solved = 0, ninc = 0, nreg = 0;
+		double gap = 0, time = 0, inc = 0, memory = 0;
+
+		for(size_t a = 0; a < runs.size(); a++)
+			if (runs[a].program == lists["programs"][p]) {
+				nruns++;
+				if (!runs[a].regression.empty()) nreg++;
+				if (!std::isnan(runs[a].Memory)) memory = max(memory, runs[a].Memory);
+				if (std::isnan(runs[a].OF)) continue;
+
+				solved++;
+				gap += (std::isnan(runs[a].Gap)) ? 0 : runs[a].Gap;
+				time += runs[a].Time;
+				if (!std::isnan(runs[a].FirstIncumbent)) {
+					ninc++;
+					inc += runs[a].FirstIncumbent;
+				}
+			}
+
+		cout << setw(12) << left << lists["programs"][p] << right << setw(8) << nruns << setw(8) << solved << fixed << setprecision(4)
+			 << setw(12) << ((solved > 0) ? gap/solved : 0) << setprecision(2) << setw(12) << ((solved > 0) ? time/solved : 0)
+			 << setw(14) << ((ninc > 0) ? inc/ninc : 0) << setw(14) << memory << setw(13) << nreg << endl;
+		cout.unsetf(ios::fixed);
+	}
+
+	cout << endl;
+	cout << "Runs = " << runs.size() << endl;
+	if (!Baseline.empty()) cout << "Regressions = " << regressions << endl;
+	// ****************************************************************************************************
+
+
+	return (regressions > 0) ? 4 : 0;
+
+}
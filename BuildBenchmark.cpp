@@ -0,0 +1,365 @@
+// ************************************************************************************* //
+//     Micro-benchmark of the construction of the Facility Location Reformulation of    //
+//    the General Capacitated Lot-Sizing Problem with Multiple Storage Locations        //
+//    (RCLSP-MSL), for each family of variables and constraints                         //
+//	 																					 //
+//	  The variables, the objective function and each of the nine families of			 //
+//	  constraints are built apart, on generated instances of several sizes			 //
+//	  (RCLSP-MSL_Generator.h), by each construction path: a proxy of the programs	 //
+//	  in Concert (RCLSP-MSL_ConcertRows.h, an expression for each row like the		 //
+//	  programs, but not their own code) and the compressed sparse rows				 //
+//	  (RCLSP-MSL_Sparse.h). For each block: rows, nonzeros, time, nanoseconds per	 //
+//	  row and per nonzero, allocations (operator new) and speedup over Concert. A	 //
+//	  new path is a function for each block and a line in the table Paths			 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <ilcplex/ilocplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_ConcertRows.h"
+#include "RCLSP-MSL_Generator.h"
+
+
+
+//macro necessary for portability
+ILOSTLBEGIN
+
+
+
+//Allocations through operator new (calls and bytes); the memory of the
+//objects of Concert allocated in the environment (new (env)) is not counted
+static std::atomic<long long> NewCalls(0), NewBytes(0);
+
+void *operator new(size_t n)
+{
+	NewCalls++;
+	NewBytes += n;
+
+	void *p = malloc((n > 0) ? n : 1);
+	if (p == NULL) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+//Blocks of the construction: variables, objective function and
+//the families of constraints (BLOCK_ROWS + ROW_* of RCLSP-MSL_Sparse.h)
+enum { BLOCK_VARIABLES, BLOCK_OBJECTIVE, BLOCK_ROWS, BLOCK_N = BLOCK_ROWS + ROW_NFAMILIES };
+
+static string BlockName(int b)
+{
+	if (b == BLOCK_VARIABLES) return "Variables";
+	if (b == BLOCK_OBJECTIVE) return "Objective";
+	return RowFamily(b - BLOCK_ROWS);
+}
+
+
+
+
+//Objects of the construction of a path: the instance and its columns
+//(the same numbering for all the paths), and the objects of each path
+struct BuildContext {
+
+	const RCLSPMSL_Instance *inst;
+	RCLSPMSL_Columns col;
+
+	//Concert (a new environment for each repetition)
+	IloEnv *env;
+	IloModel model;
+	IloNumVarArray x;
+
+	//Compressed sparse rows
+	RCLSPMSL_Columns columns;
+	vector<RCLSPMSL_Rows> rows;
+
+	BuildContext() : inst(NULL), env(NULL) {}
+
+};
+
+
+
+
+// ***** Concert: an expression for each row, a proxy of the construction in the programs ***** //
+
+static void ConcertBegin(BuildContext &c)
+{
+	c.env = new IloEnv();
+	c.model = IloModel(*c.env);
+	c.x = IloNumVarArray(*c.env, c.col.size());
+}
+
+static bool ConcertBlock(BuildContext &c, int b)
+{
+	if (b == BLOCK_VARIABLES) BuildConcertVariables(*c.env, *c.inst, c.x, c.col);
+	  else if (b == BLOCK_OBJECTIVE) BuildConcertObjective(*c.env, c.model, c.x, c.col);
+	  else AddConcertRows(*c.env, c.model, *c.inst, c.x, c.col, b - BLOCK_ROWS);
+
+	return true;
+}
+
+static void ConcertEnd(BuildContext &c)
+{
+	c.env->end();
+	delete c.env;
+	c.env = NULL;
+}
+
+
+
+
+// ***** Compressed sparse rows: the columns (with the objective function) and the rows of each family ***** //
+
+static void SparseBegin(BuildContext &c)
+{
+	c.rows.assign(ROW_NFAMILIES, RCLSPMSL_Rows());
+}
+
+static bool SparseBlock(BuildContext &c, int b)
+{
+	if (b == BLOCK_OBJECTIVE) return false;
+
+	if (b == BLOCK_VARIABLES) c.columns.build(*c.inst, false);
+	  else BuildRows(*c.inst, c.col, b - BLOCK_ROWS, c.rows[b - BLOCK_ROWS]);
+
+	return true;
+}
+
+static void SparseEnd(BuildContext &c)
+{
+	c.rows.clear();
+	c.columns = RCLSPMSL_Columns();
+}
+
+
+
+
+//Construction paths: the first one is the reference of the speedups
+//(block returns false if the path does not have the block)
+struct BuildPath {
+
+	const char *name;
+	const char *description;										  //printed in the header of the output
+	void (*begin)(BuildContext &);
+	bool (*block)(BuildContext &, int);
+	void (*end)(BuildContext &);
+
+};
+
+static const BuildPath Paths[] = {
+	{ "concert", "proxy of the programs: Concert, an expression for each row (RCLSP-MSL_ConcertRows.h)",
+	  ConcertBegin, ConcertBlock, ConcertEnd },
+	{ "sparse", "compressed sparse rows (RCLSP-MSL_Sparse.h)", SparseBegin, SparseBlock, SparseEnd }
+};
+
+static const int NPaths = sizeof(Paths)/sizeof(Paths[0]);
+
+
+
+
+//Measure of a block of a path: best time of the repetitions and
+//allocations of the last repetition
+struct BlockMeasure {
+
+	bool built;
+	double time;
+	long long calls, bytes;
+
+	BlockMeasure() : built(false), time(0), calls(0), bytes(0) {}
+
+};
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 2) {
+		cerr << "Usage: BuildBenchmark <output data file> [sizes=TxIxL,...] [repeats=n] [paths=name,...] [seed=n] [csv=file]" << endl;
+		return 1;
+	}
+
+
+	//Output Data File
+	ofstream out(argv[1]);
+
+
+	//Options: sizes   - sizes of the generated instances (T x I x L)
+	//repeats - repetitions of each path (the best time is kept)
+	//paths   - paths to measure (all if it is not given)
+	//seed    - seed of the instances; csv - table of the measures
+	RCLSPMSL_Options Options(argc, argv, 2);
+	string Sizes = Options.getString("sizes", "12x20x5,24x50x10,52x100x20");
+	int Repeats = max(1, Options.getInt("repeats", 3));
+	string Selected = "," + Options.getString("paths", "") + ",";
+	unsigned Seed = (unsigned)Options.getInt("seed", 1);
+	string Csv = Options.getString("csv", "");
+
+	vector<RCLSPMSL_GeneratorParams> sizes;
+	string size;
+	istringstream insizes(Sizes);
+
+	while (getline(insizes, size, ',')) {
+		RCLSPMSL_GeneratorParams par;
+		par.seed = Seed;
+
+		if ((sscanf(size.c_str(), "%dx%dx%d", &par.T, &par.I, &par.L) != 3) || (par.T <= 0) || (par.I <= 0) || (par.L <= 0)) {
+			cerr << "Invalid size: " << size << endl;
+			return 1;
+		}
+		sizes.push_back(par);
+	}
+
+	ofstream csv;
+	if (!Csv.empty()) {
+		csv.open(Csv.c_str());
+		csv << "T,I,L,path,block,rows,nonzeros,time,ns_row,ns_nonzero,allocations,allocated_bytes,speedup" << endl;
+	}
+
+
+	out << "****** Construction of the Linear Relaxation of the Facility Location Reformulation ******" << endl;
+	out << "******  of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations ******" << endl;
+	out << endl;
+	out << "Repetitions = " << Repeats << "  Seed = " << Seed << endl;
+	for(int p = 0; p < NPaths; p++)
+		out << "Path " << setw(10) << left << Paths[p].name << right << "= " << Paths[p].description << endl;
+	out << "The path concert does not run the code of the programs (SH, RFH, RCLSP-MSL), which" << endl;
+	out << "build their own families in main: its times are an estimate of their construction" << endl;
+
+
+
+	try {
+
+		for(size_t s = 0; s < sizes.size(); s++){
+			RCLSPMSL_Instance inst;
+			GenerateInstance(sizes[s], inst);
+
+			BuildContext c;
+			c.inst = &inst;
+			c.col.build(inst, false);
+
+
+			//Rows and nonzeros of each block (from the sparse rows): columns for the
+			//variables, one row with the nonzero coefficients for the objective function
+			vector<long long> nrows(BLOCK_N, 0), nnz(BLOCK_N, 0);
+			nrows[BLOCK_VARIABLES] = c.col.size();
+			nrows[BLOCK_OBJECTIVE] = 1;
+			for(int a = 0; a < c.col.size(); a++)
+				if (c.col.obj[a] != 0) nnz[BLOCK_OBJECTIVE]++;
+
+			for(int f = 0; f < ROW_NFAMILIES; f++){
+				RCLSPMSL_Rows rows;
+				BuildRows(inst, c.col, f, rows);
+				nrows[BLOCK_ROWS + f] = rows.rows();
+				nnz[BLOCK_ROWS + f] = rows.nonzeros();
+			}
+
+
+			// ***** Measures: repetitions x paths x blocks *****
+
+			vector<vector<BlockMeasure> > m(NPaths, vector<BlockMeasure>(BLOCK_N));
+
+			for(int r = 0; r < Repeats; r++)
+				for(int p = 0; p < NPaths; p++){
+					if ((Selected != ",,") && (Selected.find("," + string(Paths[p].name) + ",") == string::npos)) continue;
+
+					Paths[p].begin(c);
+
+					for(int b = 0; b < BLOCK_N; b++){
+						long long calls = NewCalls, bytes = NewBytes;
+						std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+						if (!Paths[p].block(c, b)) continue;
+
+						double time = Elapsed(begin);
+						BlockMeasure &bm = m[p][b];
+
+						if (!bm.built || (time < bm.time)) bm.time = time;
+						bm.built = true;
+						bm.calls = NewCalls - calls;
+						bm.bytes = NewBytes - bytes;
+					}
+
+					Paths[p].end(c);
+				}
+
+
+
+			// ****************************************************************************************************
+			//Print in the output file
+			out << endl << endl;
+			out << "T = " << inst.T << "  I = " << inst.I << "  L = " << inst.L << endl;
+			out << endl;
+			out << setw(10) << left << "Path" << setw(18) << "Block" << right << setw(12) << "Rows" << setw(12) << "Nonzeros"
+				<< setw(12) << "Time (ms)" << setw(10) << "ns/Row" << setw(12) << "ns/Nonzero" << setw(12) << "Allocs"
+				<< setw(12) << "Alloc (MB)" << setw(10) << "Speedup" << endl;
+
+			for(int p = 0; p < NPaths; p++)
+				for(int b = 0; b < BLOCK_N; b++){
+					const BlockMeasure &bm = m[p][b];
+					if (!bm.built) continue;
+
+					double nsrow = 1e9*bm.time/max(1LL, nrows[b]), nsnz = (nnz[b] > 0) ? 1e9*bm.time/nnz[b] : 0;
+					double speedup = (m[0][b].built && (bm.time > 0)) ? m[0][b].time/bm.time : 0;
+					char line[200];
+
+					sprintf(line, "%-10s%-18s%12lld%12lld%12.3f%10.1f%12.1f%12lld%12.2f%10.2f", Paths[p].name, BlockName(b).c_str(),
+							nrows[b], nnz[b], 1000*bm.time, nsrow, nsnz, bm.calls, bm.bytes/1048576.0, speedup);
+					out << line << endl;
+
+					if (csv.is_open())
+						csv << inst.T << "," << inst.I << "," << inst.L << "," << Paths[p].name << "," << BlockName(b) << ","
+							<< nrows[b] << "," << nnz[b] << "," << bm.time << "," << nsrow << "," << nsnz << "," << bm.calls << ","
+							<< bm.bytes << "," << speedup << endl;
+				}
+			// ****************************************************************************************************
+		}
+
+	}
+	catch (IloException& ex) {
+		cerr << "Error Cplex: " << ex << endl;
+		return 1;
+	}
+
+
+	out << endl << endl;
+	out << "*************************************************************************************" << endl;
+
+	return 0;
+
+}
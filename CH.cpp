@@ -0,0 +1,140 @@
+// ************************************************************************************* //
+//    Program to solve the Facility Location Reformulation of the General Capacitated    //
+//             Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)            //
+//                             by a Constructive Heuristic                               //
+//	 																					 //
+//	  The Constructive Heuristic does not use an optimization package, and its		 //
+//	  solution is also used as the initial solution (MIP start) of the other		 //
+//	  programs. See RCLSP-MSL_Constructive.h										 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Results.h"
+
+
+using namespace std;
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 3) {
+		cerr << "Usage: CH <input data file> <output data file> [trace=file] [results=file] [solution=file] [archive=file]" << endl;
+		return 1;
+	}
+
+
+    //Input Data File
+    ifstream in(argv[1]);
+
+
+    //Output Data File
+    ofstream out(argv[2]);
+
+
+	//Options: trace - file of the trace events of the phases (RCLSP-MSL_Trace.h)
+	//results  - file of the records of the runs (the output data file with .json if it is not given)
+	//solution - CSV file of the nonzero variables of the solution (RCLSP-MSL_Results.h)
+	//archive  - binary archive of the solution (RCLSP-MSL_Archive.h)
+	RCLSPMSL_Options Options(argc, argv, 3);
+	Trace().open(Options.getString("trace", ""), "CH");
+	Results().open(Options.getString("results", string(argv[2]) + ".json"), Options.getString("solution", ""), "CH", argv[1]);
+	Results().setArchive(Options.getString("archive", ""));
+
+
+
+	//Read the instance
+	Trace().step("Run", "Read instance");
+	RCLSPMSL_Instance inst;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+
+
+	// ***** Solve the RCLSP-MSL by the Constructive Heuristic *****
+
+	RCLSPMSL_Solution sol;
+	string message;
+
+	Trace().step("Run", "Constructive Heuristic");
+	clock_t begin = clock();
+
+	bool found = ConstructiveHeuristic(inst, sol, message);
+
+	double Time_CH = (double)(clock() - begin)/CLOCKS_PER_SEC;
+
+
+
+	// ****************************************************************************************************
+	//Print in the output file
+	Trace().step("Run", "Report");
+	out << "***** The Facility Location Reformulation of the General Capacitated Lot-Sizing *****" << endl;
+	out << "*****            Problem with Multiple Storage Locations (RCLSP-MSL)            *****" << endl;
+	out << "*****                    solved by a Constructive Heuristic                     *****" << endl;
+	out << endl << endl << endl << endl << endl;
+	out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
+	out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
+	out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
+	out << "***************         solved by a Constructive Heuristic            ***************" << endl;
+	out << endl << endl;
+
+	if (found) {
+
+		RCLSPMSL_Costs costs = ComputeCosts(inst, sol);
+
+		out << "Objective Function Value = " << costs.OF << endl;
+		out << "Time = " << Time_CH << endl;
+		out << endl << endl;
+		out << "*************************************************************************************" << endl;
+		out << endl << endl << endl;
+		PrintCosts(out, costs);
+		out << endl << endl << endl << endl << endl;
+		PrintSolution(out, inst, sol);
+		out << endl << endl << endl << endl << endl;
+		PrintValidation(out, Validate(inst, sol));
+	}
+	  else {
+		out << "NO Solution to the RCLSP-MSL: " << message << endl;
+		out << "Time = " << Time_CH << endl;
+		out << endl << endl;
+		out << "*************************************************************************************" << endl;
+	}
+	// ****************************************************************************************************
+
+
+
+	//Record of the run (no bound of the Constructive Heuristic)
+	Trace().step("Run", "");
+	Results().size(inst.T, inst.I, inst.L);
+	if (found) Results().solution("Feasible", inst, sol, NAN, Time_CH);
+	Results().write();
+
+
+	return (found) ? 0 : 2;
+
+}
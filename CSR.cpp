@@ -0,0 +1,304 @@
+// ************************************************************************************* //
+//    Program to compare the construction of the Facility Location Reformulation of     //
+//    the General Capacitated Lot-Sizing Problem with Multiple Storage Locations        //
+//    (RCLSP-MSL) through Concert and through the Callable Library (sparse rows)        //
+//	 																					 //
+//	  The linear relaxation of the RCLSP-MSL is built twice on the same instance:		 //
+//	  by Concert, with an expression for each row as in the programs, and by the		 //
+//	  compressed sparse rows of RCLSP-MSL_Sparse.h loaded with one call for each		 //
+//	  family of constraints. See RCLSP-MSL_ConcertRows.h and RCLSP-MSL_Callable.h	 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <ilcplex/ilocplex.h>
+#include <ilconcert/iloexpression.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Callable.h"
+#include "RCLSP-MSL_ConcertRows.h"
+#include "RCLSP-MSL_Cache.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Memory.h"
+#include "RCLSP-MSL_Results.h"
+
+
+
+//macro necessary for portability
+ILOSTLBEGIN
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 3) {
+		cerr << "Usage: CSR <input data file> <output data file> [solve=0|1] [threads=n] [cache=file] [trace=file] [results=file]" << endl;
+		return 1;
+	}
+
+
+	//Input Data File
+	ifstream in(argv[1]);
+
+
+	//Output Data File
+	ofstream out(argv[2]);
+
+
+	//Options: solve=1 also solves the linear relaxation
+	//built by both ways, to compare the objective functions
+	//threads - number of threads that build the sparse rows
+	//cache   - file of the cache of the sparse rows (RCLSP-MSL_Cache.h)
+	//trace   - file of the trace events of the phases (RCLSP-MSL_Trace.h)
+	//results - file of the records of the runs (the output data file with .json if it is not given)
+	RCLSPMSL_Options Options(argc, argv, 3);
+	bool Solve = (Options.getInt("solve", 0) != 0);
+	int Threads = Options.getInt("threads", 1);
+	string Cache = Options.getString("cache", "");
+	Trace().open(Options.getString("trace", ""), "CSR");
+	Trace().account(true);
+	Results().open(Options.getString("results", string(argv[2]) + ".json"), "", "CSR", argv[1]);
+
+
+
+	//Read the instance
+	Trace().step("Run", "Read instance");
+	RCLSPMSL_Instance inst;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+
+	RCLSPMSL_Columns col;
+	col.build(inst, false);
+
+
+
+	//Problem enviroment: env
+	IloEnv env;
+
+	try {
+
+
+		// ***** Concert: an expression for each row *****
+
+		Trace().step("Run", "Concert build");
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+		IloModel Pmodel(env);
+		IloNumVarArray x(env, col.size());
+
+		BuildConcertModel(env, Pmodel, inst, x, col);
+
+		double Time_Concert_Build = Elapsed(begin);
+
+
+		Trace().step("Run", "Concert extraction");
+		begin = std::chrono::steady_clock::now();
+
+		IloCplex Pcplex(env);
+		Pcplex.setOut(env.getNullStream());
+		Pcplex.setWarning(env.getNullStream());
+		Pcplex.setParam(IloCplex::Threads, 1);
+		Pcplex.extract(Pmodel);
+
+		double Time_Concert_Extract = Elapsed(begin);
+
+
+		double OF_Concert = 0, Time_Concert_Solve = 0;
+
+		if (Solve) {
+			Trace().step("Run", "Concert LR");
+			Pcplex.solve();
+			OF_Concert = Pcplex.getObjValue();
+			Time_Concert_Solve = Pcplex.getTime();
+		}
+
+		Pcplex.end();
+		Pmodel.end();
+		x.end();
+
+
+
+		// ***** Callable Library: compressed sparse rows *****
+
+		std::vector<RCLSPMSL_Rows> rows(ROW_NFAMILIES);
+		std::vector<double> Time_Family(ROW_NFAMILIES, 0);
+
+		Trace().step("Run", "CSR build");
+		RCLSPMSL_Columns col_CSR = col;
+		bool Cache_Loaded = false;
+
+		begin = std::chrono::steady_clock::now();
+
+		//Cache: load the rows and change the demand, or build and save them
+		if (!Cache.empty())
+			Cache_Loaded = CachedModel(Cache, inst, col_CSR, rows, Threads);
+
+		//One thread: time of each family
+		  else if (Threads <= 1) {
+			for(int f = 0; f < ROW_NFAMILIES; f++){
+				std::chrono::steady_clock::time_point begin_f = std::chrono::steady_clock::now();
+				BuildRows(inst, col, f, rows[f]);
+				Time_Family[f] = Elapsed(begin_f);
+			}
+		}
+		  else BuildModel(inst, col, rows, Threads);
+
+		double Time_CSR_Build = Elapsed(begin);
+
+
+		int status = 0;
+		CPXENVptr cpxenv = CPXopenCPLEX(&status);
+		CPXLPptr lp = NULL;
+
+		if (cpxenv != NULL) {
+			CPXsetintparam(cpxenv, CPX_PARAM_THREADS, 1);
+			lp = CPXcreateprob(cpxenv, &status, "RCLSP-MSL");
+		}
+
+		if ((cpxenv == NULL) || (lp == NULL)) {
+			cerr << "Could not create the problem of the Callable Library, status " << status << endl;
+			throw(1);
+		}
+
+
+		Trace().step("Run", "CSR load");
+		begin = std::chrono::steady_clock::now();
+
+		status = LoadModel(cpxenv, lp, col_CSR, rows, false);
+
+		double Time_CSR_Load = Elapsed(begin);
+
+		if (status) {
+			cerr << "Could not load the sparse rows, status " << status << endl;
+			throw(1);
+		}
+
+
+		double OF_CSR = 0, Time_CSR_Solve = 0;
+
+		if (Solve) {
+			Trace().step("Run", "CSR LR");
+			begin = std::chrono::steady_clock::now();
+			status = CPXlpopt(cpxenv, lp);
+			if (status == 0) status = CPXgetobjval(cpxenv, lp, &OF_CSR);
+			Time_CSR_Solve = Elapsed(begin);
+		}
+
+		CPXfreeprob(cpxenv, &lp);
+		CPXcloseCPLEX(&cpxenv);
+
+
+
+		// ****************************************************************************************************
+		//Print in the output file
+		Trace().step("Run", "Report");
+		long Rows_Total = 0, Nonzeros_Total = 0;
+
+		out << "***** Construction of the Linear Relaxation of the Facility Location Reformulation *****" << endl;
+		out << "*****  of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations *****" << endl;
+		out << endl << endl;
+		out << "T = " << inst.T << "  I = " << inst.I << "  L = " << inst.L << endl;
+		out << "Columns = " << col.size() << endl;
+		out << endl << endl;
+		out << "****************************** Compressed Sparse Rows ******************************" << endl;
+		out << endl;
+
+		for(int f = 0; f < ROW_NFAMILIES; f++){
+			out << RowFamily(f) << ": Rows = " << rows[f].rows() << "  Nonzeros = " << rows[f].nonzeros();
+			if (Cache.empty() && (Threads <= 1)) out << "  Time = " << Time_Family[f];
+			out << endl;
+			Rows_Total += rows[f].rows();
+			Nonzeros_Total += rows[f].nonzeros();
+		}
+
+		out << endl;
+		out << "Rows = " << Rows_Total << endl;
+		out << "Nonzeros = " << Nonzeros_Total << endl;
+		out << endl << endl;
+		out << "************************************** Times ***************************************" << endl;
+		out << endl;
+		out << "Concert Build Time = " << Time_Concert_Build << endl;
+		out << "Concert Extract Time = " << Time_Concert_Extract << endl;
+		out << "Concert Total Time = " << Time_Concert_Build + Time_Concert_Extract << endl;
+		out << endl;
+		out << "CSR Threads = " << Threads << endl;
+		if (!Cache.empty())
+			out << "CSR Cache = " << Cache << ((Cache_Loaded) ? " (loaded, demand changed)" : " (built and saved)") << endl;
+		out << "CSR Build Time = " << Time_CSR_Build << endl;
+		out << "CSR Load Time = " << Time_CSR_Load << endl;
+		out << "CSR Total Time = " << Time_CSR_Build + Time_CSR_Load << endl;
+		out << endl;
+		out << "Speedup = " << (Time_Concert_Build + Time_Concert_Extract)/(Time_CSR_Build + Time_CSR_Load) << endl;
+
+		if (Solve) {
+			out << endl << endl;
+			out << "********************************* Linear Relaxation ********************************" << endl;
+			out << endl;
+			out << "Objective Function Value Concert = " << OF_Concert << endl;
+			out << "Time Concert = " << Time_Concert_Solve << endl;
+			out << "Objective Function Value CSR = " << OF_CSR << endl;
+			out << "Time CSR = " << Time_CSR_Solve << endl;
+		}
+
+		out << endl << endl;
+		out << "************************************** Memory ***************************************" << endl;
+		out << endl;
+		PrintPhases(out, Trace().memory());
+		out << "Estimated Peak Memory Concert (MB) = " << EstimateConcertMemory(inst.T, inst.I, inst.L)/1048576.0 << endl;
+		out << "Estimated Peak Memory CSR (MB) = " << EstimateSparseMemory(inst.T, inst.I, inst.L)/1048576.0 << endl;
+
+		out << endl << endl;
+		out << "*************************************************************************************" << endl;
+		// ****************************************************************************************************
+
+
+		//Record of the run: times of the phases, and the LR of the sparse rows as the bound
+		Trace().step("Run", "");
+		Results().size(inst.T, inst.I, inst.L);
+		Results().noSolution((Solve) ? "LR" : "Built", (Solve) ? OF_CSR : NAN);
+		Results().write();
+
+
+	}
+	catch (IloException& ex) {
+		cerr << "Error Cplex: " << ex << endl;
+	}
+	catch (...) {
+		cerr << "Error Cpp" << endl;
+	}
+
+
+	env.end();
+
+	return 0;
+
+}
@@ -0,0 +1,95 @@
+// ************************************************************************************* //
+//     Program to generate instances of the Facility Location Reformulation of the       //
+//    General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) //
+//	 																					 //
+//	  Writes a data file of the given size (T, I, L), tightness, densities of the	 //
+//	  compatibilities and structure of the relocation costs, in the format of		 //
+//	  dataRCLSPMSL.dat read by all the programs. See RCLSP-MSL_Generator.h			 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Generator.h"
+
+
+using namespace std;
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 5) {
+		cerr << "Usage: InstanceGenerator <output data file> <T> <I> <L> [seed=n] [capacity=tightness] [storage=tightness] "
+				"[alpha=density] [beta=density] [demand=probability] [dmin=n] [dmax=n] [relocation=uniform|distance|item]" << endl;
+		return 1;
+	}
+
+
+	//Options: size, seed, tightness of the production and storage capacities,
+	//densities of the compatibilities, demand and relocation costs
+	RCLSPMSL_Options Options(argc, argv, 5);
+	RCLSPMSL_GeneratorParams par;
+	par.T = atoi(argv[2]);
+	par.I = atoi(argv[3]);
+	par.L = atoi(argv[4]);
+	par.seed = (unsigned)Options.getInt("seed", par.seed);
+	par.capacity = Options.getNum("capacity", par.capacity);
+	par.storage = Options.getNum("storage", par.storage);
+	par.alpha = Options.getNum("alpha", par.alpha);
+	par.beta = Options.getNum("beta", par.beta);
+	par.demand = Options.getNum("demand", par.demand);
+	par.dmin = Options.getInt("dmin", par.dmin);
+	par.dmax = Options.getInt("dmax", par.dmax);
+	par.relocation = RelocationStructure(Options.getString("relocation", RelocationName(par.relocation)));
+
+	if ((par.T <= 0) || (par.I <= 0) || (par.L <= 0) || (par.capacity <= 0) || (par.capacity > 1) || (par.storage <= 0) ||
+		(par.dmin < 0) || (par.dmax < par.dmin) || (par.relocation < 0)) {
+		cerr << "Invalid parameters of the instance" << endl;
+		return 1;
+	}
+
+
+
+	//Generate and write the instance
+	RCLSPMSL_Instance inst;
+	GenerateInstance(par, inst);
+
+	ofstream out(argv[1]);
+	WriteInstance(out, inst);
+	out.close();
+
+	if (!out) {
+		cerr << "The file could not be written: " << argv[1] << endl;
+		return 1;
+	}
+
+
+
+	// ****************************************************************************************************
+	//Print in the standard output
+	cout << "T = " << par.T << "  I = " << par.I << "  L = " << par.L << "  seed = " << par.seed << endl;
+	cout << "Capacity Tightness = " << par.capacity << "  Storage Tightness = " << par.storage << endl;
+	cout << "Alpha Density = " << par.alpha << "  Beta Density = " << par.beta << endl;
+	cout << "Relocation Costs = " << RelocationName(par.relocation) << endl;
+	cout << "Production Capacity = " << inst.Cap[0] << endl;
+	// ****************************************************************************************************
+
+
+	return 0;
+
+}
@@ -0,0 +1,92 @@
+// ************************************************************************************* //
+//    Estimate of the memory of a run of the Facility Location Reformulation of the      //
+//   General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)  //
+//	 																					 //
+//	  From T, I and L only (given or read from the first line of the input data		 //
+//	  file), before the model is built: the number of variables, constraints and	 //
+//	  nonzeros of each family and the estimated peak memory of a run with the		 //
+//	  Concert model (RCLSP-MSL, RFH, SH) and with the compressed sparse rows			 //
+//	  (CSR, Scenarios, RollingHorizon, Service). See RCLSP-MSL_Memory.h				 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Memory.h"
+
+
+using namespace std;
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 2) {
+		cerr << "Usage: MemoryEstimate <input data file> | <T> <I> <L>  [base=bytes] [concert_var=bytes] "
+				"[concert_row=bytes] [concert_nz=bytes] [solver_col=bytes] [solver_row=bytes] [solver_nz=bytes]" << endl;
+		return 1;
+	}
+
+
+	//Indexes: given in the command line or read from the input data file
+	long long T = 0, I = 0, L = 0;
+	int first = 2;
+
+	if ((argc >= 4) && (atoll(argv[1]) > 0) && (atoll(argv[2]) > 0) && (atoll(argv[3]) > 0)) {
+		T = atoll(argv[1]);
+		I = atoll(argv[2]);
+		L = atoll(argv[3]);
+		first = 4;
+	}
+	  else {
+		ifstream in(argv[1]);
+
+		if (!in || !(in >> T >> I >> L) || (T <= 0) || (I <= 0) || (L <= 0)) {
+			cerr << "No such file: " << argv[1] << endl;
+			return 1;
+		}
+	}
+
+
+	//Options: bytes of each object (the default values of
+	//RCLSPMSL_MemoryModel), to calibrate the estimate with the
+	//peak memory reported by the runs
+	RCLSPMSL_Options Options(argc, argv, first);
+	RCLSPMSL_MemoryModel m;
+	m.base = Options.getNum("base", m.base);
+	m.concertVar = Options.getNum("concert_var", m.concertVar);
+	m.concertRow = Options.getNum("concert_row", m.concertRow);
+	m.concertNz = Options.getNum("concert_nz", m.concertNz);
+	m.solverCol = Options.getNum("solver_col", m.solverCol);
+	m.solverRow = Options.getNum("solver_row", m.solverRow);
+	m.solverNz = Options.getNum("solver_nz", m.solverNz);
+
+
+
+	// ****************************************************************************************************
+	//Print in the standard output
+	cout << "T = " << T << "  I = " << I << "  L = " << L << endl;
+	cout << endl;
+	PrintFamilies(cout, FamilySizes(T, I, L));
+	cout << endl;
+	cout << "Estimated Peak Memory Concert (MB) = " << EstimateConcertMemory(T, I, L, m)/1048576.0 << endl;
+	cout << "Estimated Peak Memory CSR (MB) = " << EstimateSparseMemory(T, I, L, m)/1048576.0 << endl;
+	// ****************************************************************************************************
+
+
+	return 0;
+
+}
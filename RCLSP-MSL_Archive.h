@@ -0,0 +1,268 @@
+// ************************************************************************************* //
+//     Binary archive of the solutions of the Facility Location Reformulation of the     //
+//   General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)  //
+//	 																					 //
+//	  Only the nonzero variables are kept, by family (Y, Z, S, Dp, Dm, W, V, FL) and	 //
+//	  by period: the positions of the nonzero variables of each period (index of the	 //
+//	  variable among the variables of the period) are written in increasing order	 //
+//	  as differences of variable length (delta encoding), followed by the values.	 //
+//	  The families with all the values equal to one (the binary variables) do not	 //
+//	  keep the values. A plan is written and read back much faster than the text		 //
+//	  of the output files (see SolutionArchive.cpp to convert between both)			 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_ARCHIVE_H
+#define RCLSPMSL_ARCHIVE_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+
+
+
+//Identification and version of the archive files
+const char ARCHIVE_MAGIC[8] = { 'R', 'C', 'L', 'S', 'P', 'S', 'O', 'L' };
+const int ARCHIVE_VERSION = 1;
+
+
+//Families of variables of the archive
+enum { ARC_Y, ARC_Z, ARC_S, ARC_DP, ARC_DM, ARC_W, ARC_V, ARC_FL, ARC_NFAMILIES };
+
+
+
+
+//Number of variables of the family in each period
+inline size_t ArchivePositions(int f, int T, int I, int L)
+{
+	  switch (f) {
+		 case ARC_Y: return (size_t)I;
+		 case ARC_Z: return (size_t)L;
+		 case ARC_V: return (size_t)I*L*L;
+		 case ARC_FL: return (size_t)I*T;
+		 default: return (size_t)I*L;
+	  }
+}
+
+
+//Index in the vector of the solution (key of V) of the variable of the
+//family in the position p of the period t. The positions of a period
+//are: i (Y), l (Z), i*L + l (S, Dp, Dm, W), (i*L + l)*L + k (V) and
+//i*T + tau (FL, produced in t)
+inline size_t ArchiveIndex(int f, int T, int L, int t, size_t p)
+{
+	  switch (f) {
+		 case ARC_V: return ((p/((size_t)L*L))*T + t)*L*L + p%((size_t)L*L);
+		 case ARC_FL: return ((p/T)*T + t)*T + p%T;
+		 default: return p*T + t;
+	  }
+}
+
+
+//Vector of the family in the solution (NULL for V)
+inline std::vector<double> *ArchiveVector(int f, RCLSPMSL_Solution &sol)
+{
+	  std::vector<double> *v[ARC_NFAMILIES] = { &sol.Y, &sol.Z, &sol.S, &sol.Dp, &sol.Dm, &sol.W, NULL, &sol.FL };
+	  return v[f];
+}
+
+
+
+
+//Write and read an unsigned integer of variable length (7 bits in each byte)
+inline void WriteVarint(std::vector<unsigned char> &buf, unsigned long long x)
+{
+	  while (x >= 128) {
+		 buf.push_back((unsigned char)(x | 128));
+		 x >>= 7;
+	  }
+	  buf.push_back((unsigned char)x);
+}
+
+inline bool ReadVarint(const std::vector<unsigned char> &buf, size_t &p, unsigned long long &x)
+{
+	  x = 0;
+
+	  for(int shift = 0; (p < buf.size()) && (shift < 64); shift += 7){
+		 unsigned char b = buf[p++];
+		 x |= (unsigned long long)(b & 127) << shift;
+		 if (b < 128) return true;
+	  }
+
+	  return false;
+}
+
+
+
+
+//Write the solution in the archive: for each family the number of
+//nonzero variables of each period, the differences of their positions
+//and their values
+inline bool WriteSolutionArchive(std::ostream &out, const RCLSPMSL_Solution &sol, double OF)
+{
+	  int T = sol.T, I = sol.I, L = sol.L;
+	  int dims[3] = { T, I, L };
+
+	  out.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+	  out.write((const char *)&ARCHIVE_VERSION, sizeof(ARCHIVE_VERSION));
+	  out.write((const char *)dims, sizeof(dims));
+	  out.write((const char *)&OF, sizeof(OF));
+
+	  RCLSPMSL_Solution &s = const_cast<RCLSPMSL_Solution &>(sol);
+	  std::vector<unsigned char> buf;
+	  std::vector<double> values;
+
+	  for(int f = 0; f < ARC_NFAMILIES; f++){
+		 buf.clear();
+		 values.clear();
+		 size_t P = ArchivePositions(f, T, I, L);
+
+		 //Nonzero relocations of each period (the keys of a period are
+		 //not consecutive in the map, they are sorted by position)
+		 std::vector<std::vector<std::pair<size_t, double> > > reloc;
+		 if (f == ARC_V) {
+			reloc.resize(T);
+			for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+			   if (it->second == 0) continue;
+			   size_t lk = it->first % ((size_t)L*L), it_ = it->first/((size_t)L*L);
+			   reloc[it_ % T].push_back(std::make_pair((it_/T)*L*L + lk, it->second));
+			}
+		 }
+
+		 for(int t = 0; t < T; t++){
+			size_t first = values.size(), last = 0;
+
+			if (f == ARC_V) {
+			   std::sort(reloc[t].begin(), reloc[t].end());
+			   WriteVarint(buf, reloc[t].size());
+			   for(size_t a = 0; a < reloc[t].size(); a++){
+				  WriteVarint(buf, reloc[t][a].first - ((a > 0) ? last : 0));
+				  last = reloc[t][a].first;
+				  values.push_back(reloc[t][a].second);
+			   }
+			   continue;
+			}
+
+			const std::vector<double> &v = *ArchiveVector(f, s);
+			size_t n = 0;
+
+			for(size_t p = 0; p < P; p++)
+			   if (v[ArchiveIndex(f, T, L, t, p)] != 0) n++;
+
+			WriteVarint(buf, n);
+			for(size_t p = 0; p < P; p++){
+			   double x = v[ArchiveIndex(f, T, L, t, p)];
+			   if (x == 0) continue;
+
+			   WriteVarint(buf, p - ((values.size() > first) ? last : 0));
+			   last = p;
+			   values.push_back(x);
+			}
+		 }
+
+		 //Values: none if all of them are one
+		 unsigned char ones = 1;
+		 for(size_t a = 0; (a < values.size()) && ones; a++)
+			if (values[a] != 1) ones = 0;
+
+		 unsigned long long nbuf = buf.size(), nvalues = values.size();
+		 out.write((const char *)&ones, sizeof(ones));
+		 out.write((const char *)&nvalues, sizeof(nvalues));
+		 out.write((const char *)&nbuf, sizeof(nbuf));
+		 if (nbuf > 0) out.write((const char *)&buf[0], nbuf);
+		 if ((nvalues > 0) && !ones) out.write((const char *)&values[0], nvalues*sizeof(double));
+	  }
+
+	  return (bool)out;
+}
+
+
+
+
+//Read the solution of the archive (the instance must have the same
+//indexes), and its objective function value
+//Return false if the archive is not valid
+inline bool ReadSolutionArchive(std::istream &in, const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, double &OF)
+{
+	  char magic[sizeof(ARCHIVE_MAGIC)];
+	  int version = 0, dims[3] = { 0, 0, 0 };
+
+	  in.read(magic, sizeof(magic));
+	  in.read((char *)&version, sizeof(version));
+	  in.read((char *)dims, sizeof(dims));
+	  in.read((char *)&OF, sizeof(OF));
+
+	  if (!in || memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) || (version != ARCHIVE_VERSION) ||
+		  (dims[0] != inst.T) || (dims[1] != inst.I) || (dims[2] != inst.L)) return false;
+
+	  int T = inst.T, I = inst.I, L = inst.L;
+	  std::vector<unsigned char> buf;
+	  std::vector<double> values;
+
+	  sol.resize(inst);
+
+	  for(int f = 0; f < ARC_NFAMILIES; f++){
+		 unsigned char ones = 0;
+		 unsigned long long nbuf = 0, nvalues = 0;
+
+		 in.read((char *)&ones, sizeof(ones));
+		 in.read((char *)&nvalues, sizeof(nvalues));
+		 in.read((char *)&nbuf, sizeof(nbuf));
+		 if (!in || (nbuf > (unsigned long long)10*(nvalues + T)) ||
+			 (nvalues > (unsigned long long)ArchivePositions(f, T, I, L)*T)) return false;
+
+		 buf.resize((size_t)nbuf);
+		 values.assign((size_t)nvalues, 1);
+		 if (nbuf > 0) in.read((char *)&buf[0], nbuf);
+		 if ((nvalues > 0) && !ones) in.read((char *)&values[0], nvalues*sizeof(double));
+		 if (!in) return false;
+
+		 size_t P = ArchivePositions(f, T, I, L), b = 0, a = 0;
+		 std::vector<double> *v = ArchiveVector(f, sol);
+
+		 for(int t = 0; t < T; t++){
+			unsigned long long n = 0, d = 0;
+			size_t p = 0;
+
+			if (!ReadVarint(buf, b, n) || (a + n > values.size())) return false;
+
+			for(unsigned long long m = 0; m < n; m++, a++){
+			   if (!ReadVarint(buf, b, d)) return false;
+			   p = (m > 0) ? p + (size_t)d : (size_t)d;
+			   if (p >= P) return false;
+
+			   if (f == ARC_V) sol.V[ArchiveIndex(f, T, L, t, p)] = values[a];
+				 else (*v)[ArchiveIndex(f, T, L, t, p)] = values[a];
+			}
+		 }
+
+		 if (a != values.size()) return false;
+	  }
+
+	  return true;
+}
+
+
+
+
+//Save and load the archive of a solution in a file
+//Return false if the file could not be written or read
+inline bool SaveSolutionArchive(const std::string &file, const RCLSPMSL_Solution &sol, double OF)
+{
+	  std::ofstream out(file.c_str(), std::ios::binary);
+	  return out && WriteSolutionArchive(out, sol, OF);
+}
+
+inline bool LoadSolutionArchive(const std::string &file, const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, double &OF)
+{
+	  std::ifstream in(file.c_str(), std::ios::binary);
+	  return in && ReadSolutionArchive(in, inst, sol, OF);
+}
+
+
+#endif
@@ -0,0 +1,257 @@
+// ************************************************************************************* //
+//      Cache of the sparse rows of the Facility Location Reformulation of the General   //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  The columns and rows built by RCLSP-MSL_Sparse.h are saved in a binary file,	 //
+//	  with a hash of all the data of the instance except the demand. An instance		 //
+//	  with the same hash (the same plant and locations, new demand) loads the file	 //
+//	  and changes only the values that depend on the demand: the right-hand sides	 //
+//	  of InflowOutFlow1 and InflowOutFlow2, the coefficients d[i][tau] of Setup		 //
+//	  and the Big M of InvAlloc														 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CACHE_H
+#define RCLSPMSL_CACHE_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Sparse.h"
+
+
+
+//Identification and version of the cache files
+//(version 2: the columns V with l == k are not created)
+const char CACHE_MAGIC[8] = { 'R', 'C', 'L', 'S', 'P', 'C', 'S', 'R' };
+const int CACHE_VERSION = 2;
+
+
+
+
+//Hash (FNV-1a, 64 bits) of the bytes of p, and of a vector
+inline void HashBytes(unsigned long long &h, const void *p, size_t n)
+{
+	  const unsigned char *b = (const unsigned char *)p;
+
+	  for(size_t a = 0; a < n; a++){
+		 h ^= b[a];
+		 h *= 1099511628211ULL;
+	  }
+}
+
+inline void HashVector(unsigned long long &h, const std::vector<double> &v)
+{
+	  size_t n = v.size();
+
+	  HashBytes(h, &n, sizeof(n));
+	  if (n > 0) HashBytes(h, &v[0], n*sizeof(double));
+}
+
+
+
+
+//Hash of the data of the instance that does not depend on
+//the demand: indexes, costs, capacities and compatibilities
+inline unsigned long long StructureHash(const RCLSPMSL_Instance &inst)
+{
+	  unsigned long long h = 14695981039346656037ULL;
+
+	  int idx[3] = { inst.T, inst.I, inst.L };
+	  HashBytes(h, idx, sizeof(idx));
+
+	  HashVector(h, inst.vc); HashVector(h, inst.sc); HashVector(h, inst.hc); HashVector(h, inst.vt);
+	  HashVector(h, inst.Cap);
+	  HashVector(h, inst.g); HashVector(h, inst.ha); HashVector(h, inst.cs); HashVector(h, inst.H);
+	  HashVector(h, inst.alpha); HashVector(h, inst.beta); HashVector(h, inst.r);
+
+	  return h;
+}
+
+
+
+
+//Write and read a vector in the binary file (the size read is checked
+//against the rest of the file, then a damaged file is not a huge resize)
+template<class T> inline void WriteVector(std::ostream &out, const std::vector<T> &v)
+{
+	  unsigned long long n = v.size();
+	  out.write((const char *)&n, sizeof(n));
+	  if (n > 0) out.write((const char *)&v[0], n*sizeof(T));
+}
+
+template<class T> inline bool ReadVector(std::istream &in, std::vector<T> &v)
+{
+	  unsigned long long n = 0;
+	  if (!in.read((char *)&n, sizeof(n))) return false;
+
+	  std::streampos here = in.tellg();
+	  in.seekg(0, std::ios::end);
+	  std::streampos end = in.tellg();
+	  in.seekg(here);
+	  if (!in || (here < 0) || (end < here) || (n > (unsigned long long)(end - here)/sizeof(T))) {
+		 in.setstate(std::ios::failbit);
+		 return false;
+	  }
+
+	  v.resize(n);
+	  if (n > 0) in.read((char *)&v[0], n*sizeof(T));
+	  return (bool)in;
+}
+
+
+
+
+//Replace the file by the file written apart (temp). The rename replaces
+//the file at once, then a reader sees the old file or the new one and a
+//run stopped in between keeps the old file; on Windows the rename does
+//not replace an existing file, and the file is removed before
+inline bool ReplaceFile(const std::string &temp, const std::string &file)
+{
+#ifdef _WIN32
+	  std::remove(file.c_str());
+#endif
+
+	  return (std::rename(temp.c_str(), file.c_str()) == 0);
+}
+
+
+
+
+//Save the columns and rows of the instance in the cache file (written
+//apart, then it replaces the file: a run stopped while it writes does not
+//leave a damaged file)
+//Return false if the file could not be written
+inline bool SaveModelCache(const std::string &file, const RCLSPMSL_Instance &inst,
+						   const RCLSPMSL_Columns &col, const std::vector<RCLSPMSL_Rows> &rows)
+{
+	  std::string temp = file + ".tmp";
+	  std::ofstream out(temp.c_str(), std::ios::binary);
+	  if (!out) return false;
+
+	  unsigned long long hash = StructureHash(inst);
+	  int nfamilies = (int)rows.size();
+
+	  out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	  out.write((const char *)&CACHE_VERSION, sizeof(CACHE_VERSION));
+	  out.write((const char *)&hash, sizeof(hash));
+	  out.write((const char *)col.first, sizeof(col.first));
+
+	  WriteVector(out, col.obj); WriteVector(out, col.lb); WriteVector(out, col.ub); WriteVector(out, col.ctype);
+
+	  out.write((const char *)&nfamilies, sizeof(nfamilies));
+	  for(int f = 0; f < nfamilies; f++){
+		 WriteVector(out, rows[f].beg); WriteVector(out, rows[f].ind); WriteVector(out, rows[f].val);
+		 WriteVector(out, rows[f].rhs); WriteVector(out, rows[f].sense);
+	  }
+
+	  out.close();
+	  if (!out) {
+		 std::remove(temp.c_str());
+		 return false;
+	  }
+
+	  return ReplaceFile(temp, file);
+}
+
+
+
+
+//Load the columns and rows from the cache file, if it was saved
+//for an instance with the same data (except the demand)
+//Return false if there is no such cache file
+inline bool LoadModelCache(const std::string &file, const RCLSPMSL_Instance &inst,
+						   RCLSPMSL_Columns &col, std::vector<RCLSPMSL_Rows> &rows)
+{
+	  std::ifstream in(file.c_str(), std::ios::binary);
+	  if (!in) return false;
+
+	  char magic[sizeof(CACHE_MAGIC)];
+	  int version = 0, nfamilies = 0;
+	  unsigned long long hash = 0;
+
+	  in.read(magic, sizeof(magic));
+	  in.read((char *)&version, sizeof(version));
+	  in.read((char *)&hash, sizeof(hash));
+
+	  if (!in || memcmp(magic, CACHE_MAGIC, sizeof(magic)) || (version != CACHE_VERSION) ||
+		  (hash != StructureHash(inst))) return false;
+
+	  col.T = inst.T; col.I = inst.I; col.L = inst.L;
+	  in.read((char *)col.first, sizeof(col.first));
+
+	  if (!ReadVector(in, col.obj) || !ReadVector(in, col.lb) || !ReadVector(in, col.ub) || !ReadVector(in, col.ctype))
+		 return false;
+
+	  in.read((char *)&nfamilies, sizeof(nfamilies));
+	  if (!in || (nfamilies != ROW_NFAMILIES)) return false;
+
+	  rows.resize(nfamilies);
+	  for(int f = 0; f < nfamilies; f++)
+		 if (!ReadVector(in, rows[f].beg) || !ReadVector(in, rows[f].ind) || !ReadVector(in, rows[f].val) ||
+			 !ReadVector(in, rows[f].rhs) || !ReadVector(in, rows[f].sense)) return false;
+
+	  return true;
+}
+
+
+
+
+//Change the values of the rows that depend on the demand
+//(the rows are in the order of BuildRows)
+inline void PatchDemand(const RCLSPMSL_Instance &inst, std::vector<RCLSPMSL_Rows> &rows)
+{
+	  int T = inst.T, I = inst.I, L = inst.L, i, l, t, tau, r;
+
+	  //Right-hand sides of InflowOutFlow1 and InflowOutFlow2 (row i*T + t)
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++){
+			rows[ROW_INFLOWOUTFLOW1].rhs[inst.it(i, t)] = inst.d[inst.it(i, t)];
+			rows[ROW_INFLOWOUTFLOW2].rhs[inst.it(i, t)] = inst.d[inst.it(i, t)];
+		 }
+
+	  //Coefficient of Y in Setup (second nonzero of the row)
+	  RCLSPMSL_Rows &setup = rows[ROW_SETUP];
+	  r = 0;
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++)
+			for(tau = t; tau<T; tau++, r++)
+			   setup.val[setup.beg[r] + 1] = -inst.d[inst.it(i, tau)];
+
+	  //Coefficient of W in InvAlloc (second nonzero of the row)
+	  RCLSPMSL_Rows &alloc = rows[ROW_INVALLOC];
+	  r = 0;
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			for(t=0; t<T; t++, r++)
+			   alloc.val[alloc.beg[r] + 1] = -inst.BigM(i, l, t);
+}
+
+
+
+
+//Columns and rows of the instance: loaded from the cache file and
+//changed for the demand, or built and saved in the cache file (the
+//columns keep the types of the variables of the RCLSP-MSL)
+//Return true if the cache file was used
+inline bool CachedModel(const std::string &file, const RCLSPMSL_Instance &inst, RCLSPMSL_Columns &col,
+						std::vector<RCLSPMSL_Rows> &rows, int threads = 1)
+{
+	  if (LoadModelCache(file, inst, col, rows)) {
+		 PatchDemand(inst, rows);
+		 return true;
+	  }
+
+	  col.build(inst, true);
+	  BuildModel(inst, col, rows, threads);
+	  SaveModelCache(file, inst, col, rows);
+
+	  return false;
+}
+
+
+#endif
@@ -0,0 +1,378 @@
+// ************************************************************************************* //
+//     Loading of the Facility Location Reformulation of the General Capacitated        //
+//      Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) through the      //
+//                      Callable Library of the Optimization Package                    //
+//	 																					 //
+//	  The columns and the compressed sparse rows (RCLSP-MSL_Sparse.h) are copied		 //
+//	  to the problem in bulk: one call for the columns and one call for each			 //
+//	  family of constraints, instead of one Concert expression for each row			 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CALLABLE_H
+#define RCLSPMSL_CALLABLE_H
+
+
+#include <ilcplex/cplex.h>
+#include <vector>
+#include <chrono>
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Trace.h"
+
+
+
+
+//Add the columns to the problem lp
+//Return the status of the Callable Library (0 - success)
+inline int LoadColumns(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Columns &col, bool integer)
+{
+	  return CPXnewcols(env, lp, col.size(), &col.obj[0], &col.lb[0], &col.ub[0],
+						(integer) ? &col.ctype[0] : NULL, NULL);
+}
+
+
+
+
+//Add the rows of a family of constraints to the problem lp
+//Return the status of the Callable Library (0 - success)
+inline int LoadRows(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Rows &rows)
+{
+	  if (rows.rows() == 0) return 0;
+
+	  return CPXaddrows(env, lp, 0, rows.rows(), rows.nonzeros(), &rows.rhs[0], &rows.sense[0],
+						&rows.beg[0], (rows.nonzeros() > 0) ? &rows.ind[0] : NULL,
+						(rows.nonzeros() > 0) ? &rows.val[0] : NULL, NULL, NULL);
+}
+
+
+
+
+//Load the RCLSP-MSL (columns and all the families of constraints) in the problem lp
+//Return the status of the Callable Library (0 - success)
+inline int LoadModel(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Columns &col,
+					 const std::vector<RCLSPMSL_Rows> &rows, bool integer)
+{
+	  int status = LoadColumns(env, lp, col, integer);
+
+	  for(size_t f = 0; (f < rows.size()) && (status == 0); f++)
+		 status = LoadRows(env, lp, rows[f]);
+
+	  return status;
+}
+
+
+
+
+//Change the values of the problem lp that depend on the demand, for the
+//demand of inst: right-hand sides of InflowOutFlow1 and InflowOutFlow2,
+//coefficients d[i][tau] of Setup and Big M of InvAlloc (as PatchDemand)
+//The rows of the families are in the order of LoadModel
+//Return the status of the Callable Library (0 - success)
+inline int ChangeDemand(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+						const std::vector<RCLSPMSL_Rows> &rows)
+{
+	  int T = inst.T, I = inst.I, L = inst.L, i, l, t, tau, f, r;
+
+	  std::vector<int> first(ROW_NFAMILIES + 1, 0);
+	  for(f=0; f<ROW_NFAMILIES; f++)
+		 first[f+1] = first[f] + rows[f].rows();
+
+
+	  //Right-hand sides of InflowOutFlow1 and InflowOutFlow2
+	  std::vector<int> rowind;
+	  std::vector<double> rhs;
+
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++){
+			rowind.push_back(first[ROW_INFLOWOUTFLOW1] + (int)inst.it(i, t));
+			rhs.push_back(inst.d[inst.it(i, t)]);
+			rowind.push_back(first[ROW_INFLOWOUTFLOW2] + (int)inst.it(i, t));
+			rhs.push_back(inst.d[inst.it(i, t)]);
+		 }
+
+	  int status = CPXchgrhs(env, lp, (int)rowind.size(), &rowind[0], &rhs[0]);
+	  if (status) return status;
+
+
+	  //Coefficients of Y in Setup and of W in InvAlloc
+	  std::vector<int> colind;
+	  std::vector<double> val;
+	  rowind.clear();
+
+	  r = first[ROW_SETUP];
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++)
+			for(tau = t; tau<T; tau++, r++){
+			   rowind.push_back(r);
+			   colind.push_back(col.y(i, t));
+			   val.push_back(-inst.d[inst.it(i, tau)]);
+			}
+
+	  r = first[ROW_INVALLOC];
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			for(t=0; t<T; t++, r++){
+			   rowind.push_back(r);
+			   colind.push_back(col.w(i, l, t));
+			   val.push_back(-inst.BigM(i, l, t));
+			}
+
+	  return CPXchgcoeflist(env, lp, (int)rowind.size(), &rowind[0], &colind[0], &val[0]);
+}
+
+
+
+
+//Replace the MIP starts of the problem lp by the binary
+//variables (Y, Z and W) of the solution
+//Return the status of the Callable Library (0 - success)
+inline int AddMIPStartColumns(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+							  const RCLSPMSL_Solution &sol)
+{
+	  int i, l, t;
+
+	  std::vector<int> ind;
+	  std::vector<double> val;
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			ind.push_back(col.y(i, t));
+			val.push_back(sol.Y[inst.it(i, t)]);
+		 }
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++){
+			ind.push_back(col.z(l, t));
+			val.push_back(sol.Z[inst.lt(l, t)]);
+		 }
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   ind.push_back(col.w(i, l, t));
+			   val.push_back(sol.W[inst.ilt(i, l, t)]);
+			}
+
+	  int n = CPXgetnummipstarts(env, lp);
+	  if (n > 0) CPXdelmipstarts(env, lp, 0, n - 1);
+
+	  int beg = 0, effort = CPX_MIPSTART_REPAIR;
+
+	  return CPXaddmipstarts(env, lp, 1, (int)ind.size(), &beg, &ind[0], &val[0], &effort, NULL);
+}
+
+
+
+
+
+//Bounds of a binary variable (column c): free (0 and 1) or
+//fixed at its value v (rounded), added to the lists of CPXchgbds
+inline void BinaryBounds(int c, double v, bool free, std::vector<int> &ind, std::vector<char> &lu, std::vector<double> &bd)
+{
+	  double fix = (v > 0.5) ? 1 : 0;
+
+	  ind.push_back(c); lu.push_back('L'); bd.push_back((free) ? 0 : fix);
+	  ind.push_back(c); lu.push_back('U'); bd.push_back((free) ? 1 : fix);
+}
+
+
+
+
+//Free the binary variables (Y, Z and W) of the periods from first to
+//last-1 and fix the ones of the other periods at their values in the
+//solution (bounds of the columns of the problem lp)
+//Return the status of the Callable Library (0 - success)
+inline int FixBinaries(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+					   const RCLSPMSL_Solution &sol, int first, int last)
+{
+	  int i, l, t;
+
+	  std::vector<int> ind;
+	  std::vector<char> lu;
+	  std::vector<double> bd;
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++)
+			BinaryBounds(col.y(i, t), sol.Y[inst.it(i, t)], (t >= first) && (t < last), ind, lu, bd);
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++)
+			BinaryBounds(col.z(l, t), sol.Z[inst.lt(l, t)], (t >= first) && (t < last), ind, lu, bd);
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++)
+			   BinaryBounds(col.w(i, l, t), sol.W[inst.ilt(i, l, t)], (t >= first) && (t < last), ind, lu, bd);
+
+	  return CPXchgbds(env, lp, (int)ind.size(), &ind[0], &lu[0], &bd[0]);
+}
+
+
+
+
+//Bounds of the continuous variable of the column c: fixed at v, or its bounds in the columns
+inline void ContinuousBounds(const RCLSPMSL_Columns &col, int c, double v, bool fix, std::vector<int> &ind,
+							 std::vector<char> &lu, std::vector<double> &bd)
+{
+	  double value = (v > 0) ? v : 0;
+
+	  ind.push_back(c); lu.push_back('L'); bd.push_back((fix) ? value : col.lb[c]);
+	  ind.push_back(c); lu.push_back('U'); bd.push_back((fix) ? value : col.ub[c]);
+}
+
+
+//Fix the continuous variables of the periods before executed at their
+//values in the solution: production (FL[i][t][tau], for all tau), inventory
+//(S), inflow (Dp), outflow (Dm) and relocation (V); or free them (fix false)
+//Return the status of the Callable Library (0 - success)
+inline int FixExecuted(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+					   const RCLSPMSL_Solution &sol, int executed, bool fix)
+{
+	  int i, l, k, t, tau;
+	  size_t n;
+
+	  std::vector<int> ind;
+	  std::vector<char> lu;
+	  std::vector<double> bd;
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<executed; t++){
+			for(tau = t; tau<inst.T; tau++)
+			   ContinuousBounds(col, col.fl(i, t, tau), sol.FL[inst.itt(i, t, tau)], fix, ind, lu, bd);
+
+			for(l=0; l<inst.L; l++){
+			   n = inst.ilt(i, l, t);
+			   ContinuousBounds(col, col.s(i, l, t), sol.S[n], fix, ind, lu, bd);
+			   ContinuousBounds(col, col.dp(i, l, t), sol.Dp[n], fix, ind, lu, bd);
+			   ContinuousBounds(col, col.dm(i, l, t), sol.Dm[n], fix, ind, lu, bd);
+
+			   for(k=0; k<inst.L; k++)
+				  if (k != l) ContinuousBounds(col, col.v(i, l, k, t), sol.getV(i, l, k, t), fix, ind, lu, bd);
+			}
+		 }
+
+	  if (ind.empty()) return 0;
+
+	  return CPXchgbds(env, lp, (int)ind.size(), &ind[0], &lu[0], &bd[0]);
+}
+
+
+
+
+//Type of the binary variables (Y, Z and W): integer ('B') in the periods
+//from first to last-1 and continuous ('C') in the other periods; the
+//families that are not integer (integerY or integerZW) are continuous
+//Return the status of the Callable Library (0 - success)
+inline int SetBinaryTypes(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+						  int first, int last, bool integerY = true, bool integerZW = true)
+{
+	  int i, l, t;
+
+	  std::vector<int> ind;
+	  std::vector<char> ctype;
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			ind.push_back(col.y(i, t));
+			ctype.push_back(((integerY) && (t >= first) && (t < last)) ? 'B' : 'C');
+		 }
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++){
+			ind.push_back(col.z(l, t));
+			ctype.push_back(((integerZW) && (t >= first) && (t < last)) ? 'B' : 'C');
+		 }
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   ind.push_back(col.w(i, l, t));
+			   ctype.push_back(((integerZW) && (t >= first) && (t < last)) ? 'B' : 'C');
+			}
+
+	  return CPXchgctype(env, lp, (int)ind.size(), &ind[0], &ctype[0]);
+}
+
+
+
+
+//Solve the problem lp, with the binary variables of the solution as
+//the MIP start (if start), and replace the solution by the one found
+//Return true if a solution was found
+inline bool SolveColumns(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+						 RCLSPMSL_Solution &sol, bool start, double timeLimit)
+{
+	  RCLSPMSL_TraceScope Trace_Solve("Solve MIP", "solve");
+	  std::vector<double> x(col.size());
+
+	  CPXsetdblparam(env, CPX_PARAM_TILIM, (timeLimit > 1) ? timeLimit : 1);
+
+	  if ((start) && AddMIPStartColumns(env, lp, inst, col, sol)) return false;
+	  if (CPXmipopt(env, lp) || CPXgetx(env, lp, &x[0], 0, col.size() - 1)) return false;
+
+	  SolutionFromColumns(inst, col, x, sol);
+	  return true;
+}
+
+
+
+
+//Fix-and-Optimize Heuristic with a time-oriented decomposition (as in SH_v4_FO.cpp)
+//from the period first: in each time-window (fix + overlap periods) the binary
+//variables are free and the other ones are fixed at the solution, which is the
+//MIP start; the window moves fix periods. The time left of a window is added
+//to the next one. If a window has no solution, all the periods from first are
+//solved at once in the time left (full)
+//Return true if a solution was found
+inline bool FixAndOptimizeColumns(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+								  RCLSPMSL_Solution &sol, int first, int fix, int overlap, double timeLimit,
+								  int &windows, bool &full)
+{
+	  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	  int T = inst.T, size = fix + overlap, nit = 0, b, e;
+	  bool solved = true;
+
+	  windows = 0;
+	  full = false;
+
+
+	  //Number of time-windows and time available for each one
+	  for(b = first; b < T; b += fix){
+		 nit++;
+		 if (b + size >= T) break;
+	  }
+
+	  double timeWindow = (nit > 0) ? timeLimit/nit : 0, timeWindow_left = 0;
+
+
+	  for(b = first; (b < T) && (solved); b += fix){
+		 std::chrono::steady_clock::time_point window = std::chrono::steady_clock::now();
+		 RCLSPMSL_TraceScope Trace_Window("FO window " + std::to_string(windows + 1), "window");
+		 RCLSPMSL_Solution last = sol;
+
+		 e = (b + size < T) ? b + size : T;
+		 solved = (FixBinaries(env, lp, inst, col, sol, b, e) == 0) &&
+				  SolveColumns(env, lp, inst, col, sol, true, timeWindow + timeWindow_left);
+		 windows++;
+
+		 timeWindow_left += timeWindow - std::chrono::duration<double>(std::chrono::steady_clock::now() - window).count();
+
+
+		 //No solution with the binary variables out of the window fixed
+		 if (!solved) {
+			sol = last;
+			full = true;
+			solved = (FixBinaries(env, lp, inst, col, sol, first, T) == 0) &&
+					 SolveColumns(env, lp, inst, col, sol, true,
+								  timeLimit - std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+			break;
+		 }
+
+		 if (e == T) break;
+	  }
+
+	  return solved;
+}
+
+
+#endif
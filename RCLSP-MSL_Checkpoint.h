@@ -0,0 +1,169 @@
+// ************************************************************************************* //
+//      Checkpoint of the windows of the heuristics for the Facility Location            //
+//      Reformulation of the General Capacitated Lot-Sizing Problem with Multiple        //
+//      Storage Locations (RCLSP-MSL)                                                    //
+//	 																					 //
+//	  After each window of the Relax-and-Fix and of the Fix-and-Optimize, the		 //
+//	  programs write the binary variables fixed so far, the next window, the time	 //
+//	  used and the last solution of the window. A run that was stopped is started	 //
+//	  again with resume=1: the model is built, the fixed variables are fixed again	 //
+//	  and the heuristic continues from the next window								 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CHECKPOINT_H
+#define RCLSPMSL_CHECKPOINT_H
+
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Cache.h"
+#include "RCLSP-MSL_RunCache.h"
+
+
+
+//Identification and version of the checkpoint files
+const char CHECKPOINT_MAGIC[8] = { 'R', 'C', 'L', 'S', 'P', 'C', 'K', 'P' };
+const int CHECKPOINT_VERSION = 2;
+
+
+
+
+//State of the heuristic after a window
+struct RCLSPMSL_Checkpoint {
+
+	  //Phase of the heuristic (SH_v4_FO: 0 - Sequential Heuristic, 1 - Fix-and-Optimize)
+	  //and number of windows solved
+	  int phase, windows;
+
+	  //Next window: first and last (+1) block or period, and if it is the last window
+	  int begin, end, last;
+
+	  //Time limit of the phase, time of the next window and time used by the run (seconds)
+	  double timeLimit, timeWindow, timeUsed;
+
+	  //Objective function value of the last window and lower bound of the heuristic
+	  double OF, LowerBound;
+
+	  //Binary variables fixed in the windows (Y_fix, Z_fix and W_fix)
+	  std::vector<double> Y, Z, W;
+
+	  //Last solution of the windows, if all the binary variables are integer in it
+	  bool hasIncumbent;
+	  RCLSPMSL_Solution incumbent;
+
+
+	  RCLSPMSL_Checkpoint() : phase(0), windows(0), begin(0), end(0), last(0), timeLimit(0), timeWindow(0),
+							  timeUsed(0), OF(0), LowerBound(0), hasIncumbent(false) {}
+
+};
+
+
+
+
+//Identification of the run: program, decomposition and parameters
+//(a checkpoint is resumed only by a run with the same identification)
+inline std::string CheckpointRun(const std::string &program, const double *params, int n)
+{
+	  std::ostringstream s;
+	  s.precision(17);
+
+	  s << program;
+	  for(int a = 0; a < n; a++) s << " " << params[a];
+
+	  return s.str();
+}
+
+
+
+
+//Save the checkpoint (the file is written apart and renamed, then a
+//run that is stopped while it writes keeps the checkpoint before)
+//Return false if there is no checkpoint (file is empty) or the file could not be written
+inline bool SaveCheckpoint(const std::string &file, const RCLSPMSL_Instance &inst, const std::string &run,
+						   const RCLSPMSL_Checkpoint &cp)
+{
+	  if (file.empty()) return false;
+
+	  std::string temp = file + ".tmp";
+	  std::ofstream out(temp.c_str(), std::ios::binary);
+	  if (!out) return false;
+
+	  unsigned long long hash = InstanceHash(inst);
+	  std::vector<char> name(run.begin(), run.end());
+	  int ints[5] = { cp.phase, cp.windows, cp.begin, cp.end, cp.last };
+	  double values[5] = { cp.timeLimit, cp.timeWindow, cp.timeUsed, cp.OF, cp.LowerBound };
+
+	  out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+	  out.write((const char *)&CHECKPOINT_VERSION, sizeof(CHECKPOINT_VERSION));
+	  out.write((const char *)&hash, sizeof(hash));
+	  WriteVector(out, name);
+
+	  out.write((const char *)ints, sizeof(ints));
+	  out.write((const char *)values, sizeof(values));
+	  WriteVector(out, cp.Y); WriteVector(out, cp.Z); WriteVector(out, cp.W);
+
+	  out.write((const char *)&cp.hasIncumbent, sizeof(cp.hasIncumbent));
+	  if (cp.hasIncumbent) WriteSolutionBinary(out, cp.incumbent);
+
+	  out.close();
+	  if (!out) return false;
+
+	  return ReplaceFile(temp, file);
+}
+
+
+
+
+//Load the checkpoint, if it was saved by the same run of the instance
+//Return false if there is no checkpoint (file is empty) or no such file
+inline bool LoadCheckpoint(const std::string &file, const RCLSPMSL_Instance &inst, const std::string &run,
+						   RCLSPMSL_Checkpoint &cp)
+{
+	  if (file.empty()) return false;
+
+	  std::ifstream in(file.c_str(), std::ios::binary);
+	  if (!in) return false;
+
+	  char magic[sizeof(CHECKPOINT_MAGIC)];
+	  int version = 0;
+	  unsigned long long hash = 0;
+	  std::vector<char> name;
+
+	  in.read(magic, sizeof(magic));
+	  in.read((char *)&version, sizeof(version));
+	  in.read((char *)&hash, sizeof(hash));
+
+	  if (!in || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) || (version != CHECKPOINT_VERSION) ||
+		  (hash != InstanceHash(inst)) || !ReadVector(in, name) || (std::string(name.begin(), name.end()) != run))
+		 return false;
+
+	  RCLSPMSL_Checkpoint c;
+	  int ints[5];
+	  double values[5];
+
+	  in.read((char *)ints, sizeof(ints));
+	  in.read((char *)values, sizeof(values));
+	  if (!in || !ReadVector(in, c.Y) || !ReadVector(in, c.Z) || !ReadVector(in, c.W)) return false;
+
+	  if (((int)c.Y.size() != inst.I*inst.T) || ((int)c.Z.size() != inst.L*inst.T) ||
+		  ((int)c.W.size() != inst.I*inst.L*inst.T)) return false;
+
+	  in.read((char *)&c.hasIncumbent, sizeof(c.hasIncumbent));
+	  if (!in || (c.hasIncumbent && !ReadSolutionBinary(in, inst, c.incumbent))) return false;
+
+	  c.phase = ints[0]; c.windows = ints[1]; c.begin = ints[2]; c.end = ints[3]; c.last = ints[4];
+	  c.timeLimit = values[0]; c.timeWindow = values[1]; c.timeUsed = values[2]; c.OF = values[3]; c.LowerBound = values[4];
+
+	  cp = c;
+	  return true;
+}
+
+
+#endif
@@ -0,0 +1,318 @@
+// ************************************************************************************* //
+//     Connection between the plain C++ solutions of the Facility Location Reformulation //
+//   of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations      //
+//               (RCLSP-MSL) and the models of the Optimization Package                  //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CONCERT_H
+#define RCLSPMSL_CONCERT_H
+
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Variables.h"
+#include "RCLSP-MSL_Checkpoint.h"
+#include "RCLSP-MSL_Timeline.h"
+
+
+
+
+//Add the setup of items (Y) of the solution
+//as a MIP start of the problem
+inline void AddMIPStartY(IloEnv env, IloCplex cplex, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol,
+						 IloArray<IloNumVarArray> Y)
+{
+	  IloNumVarArray startVar(env);
+	  IloNumArray startVal(env);
+
+	  for(int i=0; i<inst.I; i++)
+		 for(int t=0; t<inst.T; t++){
+			startVar.add(Y[i][t]);
+			startVal.add(sol.Y[inst.it(i, t)]);
+		 }
+
+	  cplex.addMIPStart(startVar, startVal, IloCplex::MIPStartAuto, "CH");
+
+	  startVar.end();
+	  startVal.end();
+}
+
+
+
+
+//Add the binary variables (Y, Z and W) of
+//the solution as a MIP start of the problem
+inline void AddMIPStartYZW(IloEnv env, IloCplex cplex, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol,
+						   IloArray<IloNumVarArray> Y, IloArray<IloNumVarArray> Z, IloArray<IloArray<IloNumVarArray> > W)
+{
+	  int i, l, t;
+
+	  IloNumVarArray startVar(env);
+	  IloNumArray startVal(env);
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			startVar.add(Y[i][t]);
+			startVal.add(sol.Y[inst.it(i, t)]);
+		 }
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++){
+			startVar.add(Z[l][t]);
+			startVal.add(sol.Z[inst.lt(l, t)]);
+		 }
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   startVar.add(W[i][l][t]);
+			   startVal.add(sol.W[inst.ilt(i, l, t)]);
+			}
+
+	  cplex.addMIPStart(startVar, startVal, IloCplex::MIPStartAuto, "CH");
+
+	  startVar.end();
+	  startVal.end();
+}
+
+
+
+
+//Recover the solution of the problem solved by the optimization package
+inline void SolutionFromCplex(IloCplex cplex, const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol,
+							  IloArray<IloNumVarArray> Y, IloArray<IloArray<IloNumVarArray> > S, IloArray<IloNumVarArray> Z,
+							  IloArray<IloArray<IloNumVarArray> > Dp, IloArray<IloArray<IloNumVarArray> > Dm,
+							  IloArray<IloArray<IloNumVarArray> > W, const RCLSPMSL_LazyVars &V,
+							  IloArray<IloArray<IloNumVarArray> > FL)
+{
+	  int i, l, k, t, tau;
+	  size_t n;
+
+	  sol.resize(inst);
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			sol.Y[inst.it(i, t)] = cplex.getValue(Y[i][t]);
+
+			for(tau = t; tau<inst.T; tau++)
+			   sol.FL[inst.itt(i, t, tau)] = cplex.getValue(FL[i][t][tau]);
+		 }
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++)
+			sol.Z[inst.lt(l, t)] = cplex.getValue(Z[l][t]);
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   n = inst.ilt(i, l, t);
+
+			   sol.S[n] = cplex.getValue(S[i][l][t]);
+			   sol.Dp[n] = cplex.getValue(Dp[i][l][t]);
+			   sol.Dm[n] = cplex.getValue(Dm[i][l][t]);
+			   sol.W[n] = cplex.getValue(W[i][l][t]);
+
+			   for(k=0; k<inst.L; k++){
+				  double v = V.value(cplex, i, l, k, t);
+				  if (v > 0.00001) sol.setV(i, l, k, t, v);
+			   }
+			}
+}
+
+
+
+
+
+//Add all the variables of a family (arrays of any
+//dimension, empty handles are skipped) to the array all
+inline void CollectVars(IloNumVarArray all, IloNumVarArray x)
+{
+	  for(IloInt n = 0; n < x.getSize(); n++)
+		 if (x[n].getImpl() != 0) all.add(x[n]);
+}
+
+template<class A> inline void CollectVars(IloNumVarArray all, IloArray<A> x)
+{
+	  for(IloInt n = 0; n < x.getSize(); n++)
+		 if (x[n].getImpl() != 0) CollectVars(all, x[n]);
+}
+
+inline void CollectVars(IloNumVarArray all, const RCLSPMSL_LazyVars &x)
+{
+	  x.collect(all);
+}
+
+
+
+
+//Add all the constraints of a family (arrays of any
+//dimension, empty handles are skipped) to the array all
+inline void CollectRanges(IloRangeArray all, IloRangeArray x)
+{
+	  for(IloInt n = 0; n < x.getSize(); n++)
+		 if (x[n].getImpl() != 0) all.add(x[n]);
+}
+
+template<class A> inline void CollectRanges(IloRangeArray all, IloArray<A> x)
+{
+	  for(IloInt n = 0; n < x.getSize(); n++)
+		 if (x[n].getImpl() != 0) CollectRanges(all, x[n]);
+}
+
+
+
+
+//Recover the basis statuses of the variables and constraints
+//after the solution of the linear relaxation
+//Return false if the problem has no basis
+inline bool GetBasis(IloEnv env, IloCplex cplex, IloNumVarArray vars, IloRangeArray ranges,
+					 std::vector<int> &colStatus, std::vector<int> &rowStatus)
+{
+	  IloCplex::BasisStatusArray cstat(env), rstat(env);
+	  bool ok = true;
+
+	  try {
+		  cplex.getBasisStatuses(cstat, vars, rstat, ranges);
+
+		  colStatus.resize(cstat.getSize());
+		  for(IloInt n = 0; n < cstat.getSize(); n++) colStatus[n] = (int)cstat[n];
+
+		  rowStatus.resize(rstat.getSize());
+		  for(IloInt n = 0; n < rstat.getSize(); n++) rowStatus[n] = (int)rstat[n];
+	  }
+	  catch (IloException &ex) {
+		  ex.end();
+		  ok = false;
+	  }
+
+	  cstat.end();
+	  rstat.end();
+
+	  return ok;
+}
+
+
+
+
+//Set the basis statuses of the variables and constraints, as the
+//starting basis of the next solution of the problem
+//Return false if the basis is not of these variables and constraints
+inline bool SetBasis(IloEnv env, IloCplex cplex, IloNumVarArray vars, IloRangeArray ranges,
+					 const std::vector<int> &colStatus, const std::vector<int> &rowStatus)
+{
+	  if ((colStatus.size() != (size_t)vars.getSize()) || (rowStatus.size() != (size_t)ranges.getSize()))
+		 return false;
+
+	  IloCplex::BasisStatusArray cstat(env), rstat(env);
+	  bool ok = true;
+
+	  for(size_t n = 0; n < colStatus.size(); n++) cstat.add((IloCplex::BasisStatus)colStatus[n]);
+	  for(size_t n = 0; n < rowStatus.size(); n++) rstat.add((IloCplex::BasisStatus)rowStatus[n]);
+
+	  try {
+		  cplex.setBasisStatuses(cstat, vars, rstat, ranges);
+	  }
+	  catch (IloException &ex) {
+		  ex.end();
+		  ok = false;
+	  }
+
+	  cstat.end();
+	  rstat.end();
+
+	  return ok;
+}
+
+
+
+
+//Copy the binary values fixed in the windows of
+//the heuristics (Y_fix, Z_fix and W_fix) to the checkpoint
+inline void FixedToCheckpoint(const RCLSPMSL_Instance &inst, IloArray<IloNumArray> Y_fix, IloArray<IloNumArray> Z_fix,
+							  IloArray<IloArray<IloNumArray> > W_fix, RCLSPMSL_Checkpoint &cp)
+{
+	  int i, l, t;
+
+	  cp.Y.assign((size_t)inst.I*inst.T, 0);
+	  cp.Z.assign((size_t)inst.L*inst.T, 0);
+	  cp.W.assign((size_t)inst.I*inst.L*inst.T, 0);
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++)
+			cp.Y[inst.it(i, t)] = Y_fix[i][t];
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++)
+			cp.Z[inst.lt(l, t)] = Z_fix[l][t];
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++)
+			   cp.W[inst.ilt(i, l, t)] = W_fix[i][l][t];
+}
+
+
+
+
+//Copy the binary values of the checkpoint to Y_fix, Z_fix and W_fix
+inline void FixedFromCheckpoint(const RCLSPMSL_Instance &inst, const RCLSPMSL_Checkpoint &cp, IloArray<IloNumArray> Y_fix,
+								IloArray<IloNumArray> Z_fix, IloArray<IloArray<IloNumArray> > W_fix)
+{
+	  int i, l, t;
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++)
+			Y_fix[i][t] = cp.Y[inst.it(i, t)];
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++)
+			Z_fix[l][t] = cp.Z[inst.lt(l, t)];
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++)
+			   W_fix[i][l][t] = cp.W[inst.ilt(i, l, t)];
+}
+
+
+
+
+//Informational callback of the MIP: the incumbent, the best bound and the
+//nodes of the solve are recorded in the timeline (see RCLSP-MSL_Timeline.h)
+class RCLSPMSL_TimelineCallbackI : public IloCplex::MIPInfoCallbackI {
+
+public:
+
+	  RCLSPMSL_TimelineCallbackI(IloEnv env) : IloCplex::MIPInfoCallbackI(env) {}
+
+	  IloCplex::CallbackI *duplicateCallback() const { return (new (getEnv()) RCLSPMSL_TimelineCallbackI(*this)); }
+
+	  void main()
+	  {
+		  bool incumbent = hasIncumbent();
+		  Timeline().record(incumbent, (incumbent) ? (double)getIncumbentObjValue() : 0, getBestObjValue(), getNnodes());
+	  }
+
+};
+
+inline IloCplex::Callback TimelineCallback(IloEnv env)
+{
+	  return IloCplex::Callback(new (env) RCLSPMSL_TimelineCallbackI(env));
+}
+
+
+//End the solve of the timeline with the final incumbent,
+//best bound and nodes of the problem
+inline void EndTimeline(IloCplex cplex)
+{
+	  bool incumbent = (cplex.getStatus() == IloAlgorithm::Optimal) || (cplex.getStatus() == IloAlgorithm::Feasible);
+
+	  Timeline().end(incumbent, (incumbent) ? (double)cplex.getObjValue() : 0, (incumbent) ? (double)cplex.getBestObjValue() : 0,
+					 cplex.getNnodes());
+}
+
+
+#endif
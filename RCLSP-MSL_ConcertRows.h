@@ -0,0 +1,245 @@
+// ************************************************************************************* //
+//     Construction by Concert of the linear relaxation of the Facility Location        //
+//   Reformulation of the General Capacitated Lot-Sizing Problem with Multiple Storage  //
+//                             Locations (RCLSP-MSL)                                    //
+//	 																					 //
+//	  The variables, the objective function and each family of constraints are built	 //
+//	  apart, with an expression for each row as in the programs, over the columns of	 //
+//	  RCLSP-MSL_Sparse.h (the same rows, in the same order). It is a copy of the		 //
+//	  construction of the programs, not their code: used by CSR to compare with the	 //
+//	  sparse rows, and by BuildBenchmark as a proxy to time each family				 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CONCERTROWS_H
+#define RCLSPMSL_CONCERTROWS_H
+
+
+#include <ilcplex/ilocplex.h>
+#include <cstdio>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Sparse.h"
+
+
+
+
+//Variables, with the names of the programs
+inline void BuildConcertVariables(IloEnv env, const RCLSPMSL_Instance &inst, IloNumVarArray x, const RCLSPMSL_Columns &col)
+{
+	  int T = inst.T, I = inst.I, L = inst.L, i, l, k, t, tau;
+	  char name[40];
+
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++){
+			sprintf(name, "Y_%d_%d", i, t);
+			x[col.y(i, t)] = IloNumVar(env, 0, 1, name);
+		 }
+
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			for(t=0; t<T; t++){
+			   sprintf(name, "S_%d_%d_%d", i, l, t);
+			   x[col.s(i, l, t)] = IloNumVar(env, 0, IloInfinity, name);
+			   sprintf(name, "Dp_%d_%d_%d", i, l, t);
+			   x[col.dp(i, l, t)] = IloNumVar(env, 0, IloInfinity, name);
+			   sprintf(name, "Dm_%d_%d_%d", i, l, t);
+			   x[col.dm(i, l, t)] = IloNumVar(env, 0, IloInfinity, name);
+			   sprintf(name, "W_%d_%d_%d", i, l, t);
+			   x[col.w(i, l, t)] = IloNumVar(env, 0, 1, name);
+
+			   for(k=0; k<L; k++)
+				  if (k != l) {
+					 sprintf(name, "V_%d_%d_%d_%d", i, l, k, t);
+					 x[col.v(i, l, k, t)] = IloNumVar(env, 0, IloInfinity, name);
+				  }
+			}
+
+	  for(l=0; l<L; l++)
+		 for(t=0; t<T; t++){
+			sprintf(name, "Z_%d_%d", l, t);
+			x[col.z(l, t)] = IloNumVar(env, 0, 1, name);
+		 }
+
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++)
+			for(tau = t; tau<T; tau++){
+			   sprintf(name, "FL_%d_%d_%d", i, t, tau);
+			   x[col.fl(i, t, tau)] = IloNumVar(env, 0, IloInfinity, name);
+			}
+}
+
+
+
+
+//Objective function
+inline void BuildConcertObjective(IloEnv env, IloModel model, IloNumVarArray x, const RCLSPMSL_Columns &col)
+{
+	  IloExpr objective(env);
+
+	  for(int c = 0; c < col.size(); c++)
+		 if (col.obj[c] != 0) objective += col.obj[c]*x[c];
+
+	  model.add(IloMinimize(env, objective));
+	  objective.end();
+}
+
+
+
+
+//Rows of the family of constraints f (ROW_* of RCLSP-MSL_Sparse.h)
+inline void BuildConcertRows(IloEnv env, const RCLSPMSL_Instance &inst, IloNumVarArray x, const RCLSPMSL_Columns &col,
+							 int f, IloRangeArray r)
+{
+	  int T = inst.T, I = inst.I, L = inst.L, i, j, l, k, t, tau;
+
+	  switch (f) {
+
+	  case ROW_INFLOWOUTFLOW1:
+		  for(i=0; i<I; i++)
+			 for(t=0; t<T; t++){
+				IloExpr flow(env);
+				for(tau=0; tau <= t; tau++)
+				   flow += x[col.fl(i, tau, t)];
+				r.add(flow == inst.d[inst.it(i, t)]);
+				flow.end();
+			 }
+		  break;
+
+
+	  case ROW_INFLOWOUTFLOW2:
+		  for(i=0; i<I; i++)
+			 for(t=0; t<T; t++){
+				IloExpr flow(env);
+				for(tau = t; tau<T; tau++)
+				   flow += x[col.fl(i, t, tau)];
+				flow -= inst.d[inst.it(i, t)];
+				for(l=0; l<L; l++)
+				   flow -= x[col.dp(i, l, t)] - x[col.dm(i, l, t)];
+				r.add(flow == 0);
+				flow.end();
+			 }
+		  break;
+
+
+	  case ROW_BALANCELOCATION:
+		  for(i=0; i<I; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   IloExpr balance(env);
+				   if (t > 0) balance += x[col.s(i, l, t-1)];
+				   balance += x[col.dp(i, l, t)] - x[col.s(i, l, t)] - x[col.dm(i, l, t)];
+				   for(k=0; k<L; k++)
+					  if (k != l) balance += x[col.v(i, k, l, t)] - x[col.v(i, l, k, t)];
+				   r.add(balance == 0);
+				   balance.end();
+				}
+		  break;
+
+
+	  case ROW_SETUP:
+		  for(i=0; i<I; i++)
+			 for(t=0; t<T; t++)
+				for(tau = t; tau<T; tau++){
+				   IloExpr set(env);
+				   set += x[col.fl(i, t, tau)] - inst.d[inst.it(i, tau)]*x[col.y(i, t)];
+				   r.add(set <= 0);
+				   set.end();
+				}
+		  break;
+
+
+	  case ROW_CAPACITY:
+		  for(t=0; t<T; t++){
+			 IloExpr cap(env);
+			 for(i=0; i<I; i++)
+				for(tau = t; tau<T; tau++)
+				   cap += inst.vt[i]*x[col.fl(i, t, tau)];
+			 r.add(cap <= inst.Cap[t]);
+			 cap.end();
+		  }
+		  break;
+
+
+	  case ROW_INVALLOC:
+		  for(i=0; i<I; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   IloExpr alloc(env);
+				   alloc += x[col.s(i, l, t)] - inst.BigM(i, l, t)*x[col.w(i, l, t)];
+				   r.add(alloc <= 0);
+				   alloc.end();
+				}
+		  break;
+
+
+	  case ROW_CAPACITYSTORAGE:
+		  for(l=0; l<L; l++)
+			 for(t=0; t<T; t++){
+				IloExpr cap(env);
+				for(i=0; i<I; i++)
+				   cap += inst.cs[i]*x[col.s(i, l, t)];
+				cap -= inst.H[l]*x[col.z(l, t)];
+				r.add(cap <= 0);
+				cap.end();
+			 }
+		  break;
+
+
+	  case ROW_ITEMLOCATCOMPAT:
+		  for(i=0; i<I; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   IloExpr comp(env);
+				   comp += x[col.w(i, l, t)];
+				   r.add(comp <= inst.alpha[inst.il(i, l)]);
+				   comp.end();
+				}
+		  break;
+
+
+	  case ROW_ITEMITEMCOMPAT:
+		  for(i=0; i<I; i++)
+			 for(j=i; j<I; j++)
+				for(l=0; l<L; l++)
+				   for(t=0; t<T; t++){
+					  IloExpr comp(env);
+					  comp += x[col.w(i, l, t)] + x[col.w(j, l, t)];
+					  r.add(comp <= inst.beta[inst.ij(i, j)] + 1);
+					  comp.end();
+				   }
+		  break;
+	  }
+}
+
+
+
+
+//Add the rows of the family of constraints f to the model,
+//named as the constraints of the programs
+inline void AddConcertRows(IloEnv env, IloModel model, const RCLSPMSL_Instance &inst, IloNumVarArray x,
+						   const RCLSPMSL_Columns &col, int f)
+{
+	  IloRangeArray r(env);
+
+	  BuildConcertRows(env, inst, x, col, f, r);
+	  r.setNames(RowFamily(f));
+	  model.add(r);
+}
+
+
+
+
+//Linear relaxation of the RCLSP-MSL: variables, objective
+//function and all the families of constraints
+inline void BuildConcertModel(IloEnv env, IloModel model, const RCLSPMSL_Instance &inst, IloNumVarArray x,
+							  const RCLSPMSL_Columns &col)
+{
+	  BuildConcertVariables(env, inst, x, col);
+	  BuildConcertObjective(env, model, x, col);
+
+	  for(int f = 0; f < ROW_NFAMILIES; f++)
+		 AddConcertRows(env, model, inst, x, col, f);
+}
+
+
+#endif
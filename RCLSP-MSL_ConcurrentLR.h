@@ -0,0 +1,188 @@
+// ************************************************************************************* //
+//     Linear relaxation solved apart of the Facility Location Reformulation of the     //
+//   General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)  //
+//	 																					 //
+//	  The bound of the linear relaxation is only needed for the gaps at the end of	 //
+//	  the heuristics. It is solved in a thread of its own, with its own copy of the	 //
+//	  instance and its own problem of the Callable Library (compressed sparse rows,	 //
+//	  RCLSP-MSL_Sparse.h), while the heuristic runs. The programs wait for it when	 //
+//	  the first gap is computed, and its bound is kept in the cache of the runs.	 //
+//	  The same problem can also be solved before the heuristic (solveBefore)		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CONCURRENTLR_H
+#define RCLSPMSL_CONCURRENTLR_H
+
+
+#include <ilcplex/cplex.h>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Callable.h"
+#include "RCLSP-MSL_RunCache.h"
+#include "RCLSP-MSL_Trace.h"
+
+
+
+
+//Linear relaxation of the instance solved in a thread apart
+class RCLSPMSL_ConcurrentLR {
+
+	  RCLSPMSL_Instance inst;
+	  std::string cache;											  //directory of the cache of the runs (RCLSP-MSL_RunCache.h)
+	  std::thread worker;
+	  std::atomic<bool> done;
+
+	  bool started, printed;
+	  bool apart;													  //solved in the thread, while the heuristic runs
+	  int threads;													  //threads of the optimization package
+	  int status;													  //status of the Callable Library (0 - success)
+	  int lpstat;													  //solution status of the LR (CPXgetstat)
+	  bool solved;													  //the LR was solved to optimality
+	  double OF, Time;
+
+
+	  //Build, load and solve the LR
+	  void solve()
+	  {
+		  RCLSPMSL_TraceScope Trace_LR("LR (apart)", "phase");
+		  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+		  RCLSPMSL_Columns col;
+		  std::vector<RCLSPMSL_Rows> rows(ROW_NFAMILIES);
+
+		  col.build(inst, false);
+		  BuildModel(inst, col, rows, 1);
+
+		  CPXENVptr env = CPXopenCPLEX(&status);
+		  CPXLPptr lp = NULL;
+
+		  if (env != NULL) {
+			 CPXsetintparam(env, CPX_PARAM_SCRIND, CPX_OFF);
+			 CPXsetintparam(env, CPX_PARAM_THREADS, threads);
+			 lp = CPXcreateprob(env, &status, "LR_RCLSP-MSL");
+		  }
+
+		  if (lp != NULL) status = LoadModel(env, lp, col, rows, false);
+		  if ((lp != NULL) && (status == 0)) status = CPXlpopt(env, lp);
+		  if ((lp != NULL) && (status == 0)) {
+			 lpstat = CPXgetstat(env, lp);
+			 solved = (lpstat == CPX_STAT_OPTIMAL);
+			 if (solved) status = CPXgetobjval(env, lp, &OF);
+			 solved = solved && (status == 0);
+		  }
+
+		  if (lp != NULL) CPXfreeprob(env, &lp);
+		  if (env != NULL) CPXcloseCPLEX(&env);
+
+		  Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		  done = true;
+	  }
+
+public:
+
+	  RCLSPMSL_ConcurrentLR() : done(false), started(false), printed(false), apart(true), threads(1),
+								status(0), lpstat(0), solved(false), OF(0), Time(0) {}
+
+	  //The bound of a LR that was never waited for is also kept in the cache
+	  ~RCLSPMSL_ConcurrentLR() {
+		  if (worker.joinable()) worker.join();
+		  if (started && solved && !printed) UpdateLR(cache, inst, OF);
+	  }
+
+
+	  //Read the instance and start the thread of the LR (one thread of the
+	  //optimization package); the bound is saved in the cache of the runs
+	  //dir (no cache if it is empty)
+	  //Return false if the instance could not be read
+	  bool start(const char *file, const std::string &dir = "")
+	  {
+		  std::ifstream in(file);
+		  if (!in || !ReadInstance(in, inst)) return false;
+
+		  cache = dir;
+
+		  worker = std::thread(&RCLSPMSL_ConcurrentLR::solve, this);
+		  started = true;
+		  return true;
+	  }
+
+
+	  //Read the instance and solve the LR at once, before the heuristic, with
+	  //nthreads threads of the optimization package (0 - automatic)
+	  //Return false if the instance could not be read
+	  bool solveBefore(const char *file, const std::string &dir, int nthreads)
+	  {
+		  std::ifstream in(file);
+		  if (!in || !ReadInstance(in, inst)) return false;
+
+		  cache = dir;
+		  apart = false;
+		  threads = nthreads;
+
+		  solve();
+		  started = true;
+		  return true;
+	  }
+
+
+	  //The thread was started, and it finished (without waiting)
+	  bool running() const { return started; }
+	  bool ready() const { return started && done; }
+
+
+	  //Wait for the LR and recover its objective function value and time
+	  //(the values are not changed if the LR was not started or not solved)
+	  //The solution of the LR is printed the first time
+	  //Return true if the LR was solved
+	  bool wait(std::ostream &out, double &OF_LR, double &Time_LR)
+	  {
+		  if (!started) return false;
+		  if (worker.joinable()) worker.join();
+
+		  if (solved) {
+			 OF_LR = OF;
+			 Time_LR = Time;
+		  }
+
+		  if (!printed) {
+			 printed = true;
+
+			 if (solved) UpdateLR(cache, inst, OF);
+
+			 // ****************************************************************************************************
+			 //Print in the output file
+			 out << "***** Solution to the Linear Relaxation of the Reformulated General Capacitated *****" << std::endl;
+			 out << "*****             Lot-Sizing Problem with Multiple Storage Locations            *****" << std::endl;
+			 if (apart) out << "*****                   (solved apart, while the heuristic ran)                 *****" << std::endl;
+			 out << std::endl << std::endl;
+			 if (solved) {
+				out << "Solution Status LR = Optimal" << std::endl;
+				out << "Objective Function Value LR = " << OF << std::endl;
+			 }
+			   else {
+				if (status) out << "Solution Status LR = Error " << status << std::endl;
+				  else out << "Solution Status LR = " << lpstat << std::endl;
+				out << "NO Solution to the Linear Relaxation Problem" << std::endl;
+			 }
+			 out << "Time LR = " << Time << std::endl;
+			 out << std::endl << std::endl;
+			 out << "*************************************************************************************" << std::endl;
+			 out << std::endl << std::endl << std::endl << std::endl << std::endl;
+			 // ****************************************************************************************************
+		  }
+
+		  return solved;
+	  }
+
+};
+
+
+#endif
@@ -0,0 +1,605 @@
+// ************************************************************************************* //
+//     Constructive Heuristic to find an initial feasible solution to the Facility      //
+//        Location Reformulation of the General Capacitated Lot-Sizing Problem          //
+//                 with Multiple Storage Locations (RCLSP-MSL)                           //
+//	 																					 //
+//	  Greedy construction without an optimization package:							 //
+//	  1. Production: lot-for-lot, with the demand that does not fit in the			 //
+//	     capacity of a period shifted to the previous periods; then lots are		 //
+//	     merged into the previous setup when the setup cost pays the inventory		 //
+//	  2. Storage: the inventory of each period is assigned to the locations			 //
+//	     respecting the capacity (H) and the compatibilities (alpha, beta)			 //
+//	  3. Relocation: locations with few items are emptied by moving their items	 //
+//	     to other used locations when the relocation is cheaper than the location	 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_CONSTRUCTIVE_H
+#define RCLSPMSL_CONSTRUCTIVE_H
+
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <ctime>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+
+
+
+//Tolerance of the Constructive Heuristic
+const double CH_EPS = 1e-9;
+
+
+
+
+//Flows of item i in a period: inflow and outflow of
+//each location, and relocations (origin, destination, units)
+struct RCLSPMSL_Flows {
+
+	  std::vector<double> Dp, Dm;
+	  std::vector<std::pair<std::pair<int, int>, double> > V;
+
+};
+
+
+
+
+//Calculate the flows of item i in period t (inflow Dp, outflow Dm and
+//relocation V) from the inventory of the item in the periods t-1 and t.
+//The units that leave a location are relocated to a location that
+//receives units when the relocation is cheaper than the handling
+inline void ComputeFlows(const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol, int i, int t, RCLSPMSL_Flows &f)
+{
+	  int l, k;
+	  size_t p;
+
+	  std::vector<double> dec(inst.L, 0), inc(inst.L, 0);
+	  std::vector<int> decLoc, incLoc;
+
+	  f.Dp.assign(inst.L, 0);
+	  f.Dm.assign(inst.L, 0);
+	  f.V.clear();
+
+	  for(l=0; l<inst.L; l++){
+		 double before = (t > 0) ? sol.S[inst.ilt(i, l, t-1)] : 0,
+				after = sol.S[inst.ilt(i, l, t)];
+
+		 if (before - after > CH_EPS) { dec[l] = before - after; decLoc.push_back(l); }
+		 if (after - before > CH_EPS) { inc[l] = after - before; incLoc.push_back(l); }
+	  }
+
+
+	  //Pairs (origin, destination) where the relocation
+	  //is cheaper than the handling in the destination
+	  std::vector<std::pair<double, std::pair<int, int> > > pairs;
+
+	  for(size_t a = 0; a < decLoc.size(); a++)
+		 for(size_t b = 0; b < incLoc.size(); b++){
+			l = decLoc[a]; k = incLoc[b];
+
+			double saving = inst.ha[inst.il(i, k)] - inst.r[inst.ilk(i, l, k)];
+			if (saving > CH_EPS)
+			   pairs.push_back(std::make_pair(-saving, std::make_pair(l, k)));
+		 }
+
+	  std::sort(pairs.begin(), pairs.end());
+
+	  for(p = 0; p < pairs.size(); p++){
+		 l = pairs[p].second.first; k = pairs[p].second.second;
+
+		 double x = std::min(dec[l], inc[k]);
+		 if (x > CH_EPS) {
+			f.V.push_back(std::make_pair(std::make_pair(l, k), x));
+			dec[l] -= x;
+			inc[k] -= x;
+		 }
+	  }
+
+
+	  //The remaining units are handled
+	  //as inflow and outflow of the location
+	  for(l=0; l<inst.L; l++){
+		 if (inc[l] > CH_EPS) f.Dp[l] = inc[l];
+		 if (dec[l] > CH_EPS) f.Dm[l] = dec[l];
+	  }
+}
+
+
+
+
+//Calculate the flows of item i in period t in the solution
+inline void DeriveFlows(const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, int i, int t)
+{
+	  RCLSPMSL_Flows f;
+	  ComputeFlows(inst, sol, i, t, f);
+
+	  sol.clearV(i, t);
+
+	  for(int l=0; l<inst.L; l++){
+		 sol.Dp[inst.ilt(i, l, t)] = f.Dp[l];
+		 sol.Dm[inst.ilt(i, l, t)] = f.Dm[l];
+	  }
+
+	  for(size_t p = 0; p < f.V.size(); p++)
+		 sol.setV(i, f.V[p].first.first, f.V[p].first.second, t, f.V[p].second);
+}
+
+
+
+
+//Check if item i can be stored at location l in period t together
+//with the items already assigned to the location (ItemLocatCompat
+//and ItemItemCompat constraints)
+inline bool StorageCompatible(const RCLSPMSL_Instance &inst, const std::vector<int> &items, int i, int l)
+{
+	  if ((inst.alpha[inst.il(i, l)] < 0.5) || (inst.beta[inst.ij(i, i)] < 0.5))
+		 return false;
+
+	  for(size_t a = 0; a < items.size(); a++)
+		 if ((items[a] != i) && (inst.compat(i, items[a]) < 0.5))
+			return false;
+
+	  return true;
+}
+
+
+
+
+//Assign the inventory of the items (defined by the production in FL)
+//to the storage locations, period by period, and calculate the
+//variables S, W, Z, Dp, Dm and V of the solution
+inline bool AssignStorage(const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, std::string &message)
+{
+	  int t, i, l, k, tau;
+	  size_t a;
+
+
+	  //Clear the storage variables
+	  std::fill(sol.S.begin(), sol.S.end(), 0.0);
+	  std::fill(sol.W.begin(), sol.W.end(), 0.0);
+	  std::fill(sol.Z.begin(), sol.Z.end(), 0.0);
+	  std::fill(sol.Dp.begin(), sol.Dp.end(), 0.0);
+	  std::fill(sol.Dm.begin(), sol.Dm.end(), 0.0);
+	  sol.V.clear();
+
+
+	  //Inventory of the items at the end of each period
+	  std::vector<double> inv((size_t)inst.I*inst.T, 0);
+
+	  for(i=0; i<inst.I; i++){
+		 double level = 0;
+
+		 for(t=0; t<inst.T; t++){
+			for(tau = t; tau<inst.T; tau++)
+			   level += sol.FL[inst.itt(i, t, tau)];
+
+			level -= inst.d[inst.it(i, t)];
+			if (level < CH_EPS) level = 0;
+
+			inv[inst.it(i, t)] = level;
+		 }
+	  }
+
+
+
+	  std::vector<double> used(inst.L);							  //used space of each location in the period
+	  std::vector<std::vector<int> > items(inst.L);				  //items assigned to each location in the period
+	  std::vector<double> toPlace(inst.I);						  //inventory of each item to be assigned in the period
+	  std::vector<int> order(inst.I);
+
+
+	  for(t=0; t<inst.T; t++){
+
+			for(l=0; l<inst.L; l++){
+			   used[l] = 0;
+			   items[l].clear();
+			}
+
+
+			// ***** 1. Keep the inventory from the previous period ********
+
+			for(i=0; i<inst.I; i++){
+			   double target = inv[inst.it(i, t)], kept = 0;
+
+			   if (t > 0) {
+
+				  //Keep the units in the locations with the largest
+				  //inventories and take out the units of the others
+				  std::vector<std::pair<double, int> > prev;
+				  for(l=0; l<inst.L; l++)
+					 if (sol.S[inst.ilt(i, l, t-1)] > CH_EPS)
+						prev.push_back(std::make_pair(-sol.S[inst.ilt(i, l, t-1)], l));
+
+				  std::sort(prev.begin(), prev.end());
+
+				  for(a = 0; a < prev.size(); a++){
+					 l = prev[a].second;
+
+					 double x = std::min(-prev[a].first, target - kept);
+					 x = std::min(x, inst.BigM(i, l, t));
+
+					 if (x > CH_EPS) {
+						sol.S[inst.ilt(i, l, t)] = x;
+						used[l] += inst.cs[i]*x;
+						items[l].push_back(i);
+						kept += x;
+					 }
+				  }
+			   }
+
+			   toPlace[i] = target - kept;
+			}
+
+
+
+			// ***** 2. Assign the new inventory to the locations **********
+
+			//Items that need more space first
+			std::vector<std::pair<double, int> > space(inst.I);
+			for(i=0; i<inst.I; i++)
+			   space[i] = std::make_pair(-inst.cs[i]*toPlace[i], i);
+
+			std::sort(space.begin(), space.end());
+
+			for(i=0; i<inst.I; i++)
+			   order[i] = space[i].second;
+
+			for(a = 0; a < (size_t)inst.I; a++){
+			   i = order[a];
+
+			   while (toPlace[i] > CH_EPS) {
+
+				  int best = -1;
+				  double bestScore = 0, bestRoom = 0;
+
+				  for(l=0; l<inst.L; l++){
+					 size_t n = inst.ilt(i, l, t);
+					 bool assigned = (sol.S[n] > CH_EPS);
+
+					 if (!assigned && !StorageCompatible(inst, items[l], i, l))
+						continue;
+
+					 double room = inst.BigM(i, l, t) - sol.S[n];
+					 if (inst.cs[i] > 0)
+						room = std::min(room, (inst.H[l] - used[l])/inst.cs[i]);
+
+					 if (room <= CH_EPS)
+						continue;
+
+					 //Unit cost: handling, plus the fixed cost of
+					 //the location when it is not used in the period
+					 double x = std::min(room, toPlace[i]),
+							score = inst.ha[inst.il(i, l)];
+
+					 if (items[l].empty())
+						score += inst.g[l]/x;
+
+					 if ((best < 0) || (score < bestScore)) {
+						best = l;
+						bestScore = score;
+						bestRoom = room;
+					 }
+				  }
+
+				  if (best < 0) {
+					 message = "NO storage location available for the inventory of the items";
+					 return false;
+				  }
+
+				  double x = std::min(bestRoom, toPlace[i]);
+				  size_t n = inst.ilt(i, best, t);
+
+				  if (sol.S[n] <= CH_EPS)
+					 items[best].push_back(i);
+
+				  sol.S[n] += x;
+				  used[best] += inst.cs[i]*x;
+				  toPlace[i] -= x;
+			   }
+			}
+
+
+
+			// ***** 3. Relocation of items to empty locations *************
+
+			//Locations with the smallest used space first
+			std::vector<std::pair<double, int> > locs;
+			for(l=0; l<inst.L; l++)
+			   if (!items[l].empty())
+				  locs.push_back(std::make_pair(used[l], l));
+
+			std::sort(locs.begin(), locs.end());
+
+			for(size_t b = 0; b < locs.size(); b++){
+			   l = locs[b].second;
+
+			   if (items[l].empty())
+				  continue;
+
+			   //Plan the move of all items of the location
+			   std::vector<double> extra(inst.L, 0);
+			   std::vector<std::pair<std::pair<int, int>, double> > plan;
+			   double cost = 0;
+			   bool possible = true;
+
+			   for(size_t c = 0; (c < items[l].size()) && possible; c++){
+				  i = items[l][c];
+
+				  double x = sol.S[inst.ilt(i, l, t)],
+						 carried = (t > 0) ? std::min(x, sol.S[inst.ilt(i, l, t-1)]) : 0;
+
+				  int bestK = -1;
+				  double bestCost = 0;
+
+				  for(k=0; k<inst.L; k++){
+					 if ((k == l) || items[k].empty() || !StorageCompatible(inst, items[k], i, k))
+						continue;
+
+					 double room = inst.BigM(i, k, t) - sol.S[inst.ilt(i, k, t)];
+					 if (inst.cs[i] > 0)
+						room = std::min(room, (inst.H[k] - used[k] - extra[k])/inst.cs[i]);
+
+					 if (room < x - CH_EPS)
+						continue;
+
+					 double move = carried*std::min(inst.r[inst.ilk(i, l, k)], inst.ha[inst.il(i, k)])
+								 + (x - carried)*(inst.ha[inst.il(i, k)] - inst.ha[inst.il(i, l)]);
+
+					 if ((bestK < 0) || (move < bestCost)) {
+						bestK = k;
+						bestCost = move;
+					 }
+				  }
+
+				  if (bestK < 0) possible = false;
+					else {
+						   plan.push_back(std::make_pair(std::make_pair(i, bestK), x));
+						   extra[bestK] += inst.cs[i]*x;
+						   cost += bestCost;
+					}
+			   }
+
+
+			   //Relocate if cheaper than using the location
+			   if (possible && (cost < inst.g[l] - CH_EPS)) {
+
+				  for(size_t c = 0; c < plan.size(); c++){
+					 i = plan[c].first.first;
+					 k = plan[c].first.second;
+
+					 if (sol.S[inst.ilt(i, k, t)] <= CH_EPS)
+						items[k].push_back(i);
+
+					 sol.S[inst.ilt(i, k, t)] += plan[c].second;
+					 sol.S[inst.ilt(i, l, t)] = 0;
+					 used[k] += inst.cs[i]*plan[c].second;
+				  }
+
+				  items[l].clear();
+				  used[l] = 0;
+			   }
+			}
+
+
+
+			// ***** Assignment, use of locations and flows ****************
+
+			for(l=0; l<inst.L; l++){
+			   for(a = 0; a < items[l].size(); a++)
+				  sol.W[inst.ilt(items[l][a], l, t)] = 1;
+
+			   sol.Z[inst.lt(l, t)] = items[l].empty() ? 0 : 1;
+			}
+
+			for(i=0; i<inst.I; i++)
+			   DeriveFlows(inst, sol, i, t);
+
+	  }//end for t
+
+
+	  return true;
+}
+
+
+
+
+//Constructive Heuristic: production plan, storage assignment and relocations
+//Return false (and the reason in message) if no feasible solution is found
+inline bool ConstructiveHeuristic(const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, std::string &message)
+{
+	  int t, i, tau;
+	  size_t a;
+
+
+	  sol.resize(inst);
+
+
+
+	  // ***** 1. Production *******************************************
+
+	  //Lots of demand (item, period of the demand, quantity) not produced yet
+	  struct Lot { int i, tau; double q; };
+
+	  std::vector<Lot> pending, left;
+	  std::vector<double> capLeft(inst.Cap);
+
+
+	  //Backward in time: the demand of each period is produced in the
+	  //period, and the demand that does not fit in the capacity is
+	  //shifted to the previous period. Items with larger inventory
+	  //cost per unit of capacity are the last ones to be shifted
+	  for(t = inst.T-1; t >= 0; t--){
+
+		 for(i=0; i<inst.I; i++)
+			if (inst.d[inst.it(i, t)] > CH_EPS) {
+			   Lot lot = { i, t, inst.d[inst.it(i, t)] };
+			   pending.push_back(lot);
+			}
+
+		 std::vector<std::pair<double, size_t> > priority(pending.size());
+		 for(a = 0; a < pending.size(); a++)
+			priority[a] = std::make_pair(-inst.hc[pending[a].i]/std::max(inst.vt[pending[a].i], CH_EPS), a);
+
+		 std::sort(priority.begin(), priority.end());
+
+		 left.clear();
+		 for(a = 0; a < priority.size(); a++)
+			left.push_back(pending[priority[a].second]);
+
+		 pending.swap(left);
+
+		 left.clear();
+
+		 for(a = 0; a < pending.size(); a++){
+			Lot lot = pending[a];
+			double x = lot.q;
+
+			if (inst.vt[lot.i] > 0)
+			   x = std::min(x, capLeft[t]/inst.vt[lot.i]);
+
+			if (x > CH_EPS) {
+			   sol.FL[inst.itt(lot.i, t, lot.tau)] += x;
+			   capLeft[t] -= inst.vt[lot.i]*x;
+			   lot.q -= x;
+			}
+
+			if (lot.q > CH_EPS)
+			   left.push_back(lot);
+		 }
+
+		 pending.swap(left);
+	  }
+
+	  if (!pending.empty()) {
+		 message = "NO production plan within the capacity (Cap) of the periods";
+		 return false;
+	  }
+
+
+
+	  //Merge the lot of a period into the previous setup of the
+	  //item when the setup cost is larger than the inventory cost
+	  std::vector<double> lotFL = sol.FL;
+
+	  for(i=0; i<inst.I; i++){
+		 int prev = -1;
+
+		 for(t=0; t<inst.T; t++){
+			double q = 0;
+			for(tau = t; tau<inst.T; tau++)
+			   q += sol.FL[inst.itt(i, t, tau)];
+
+			if (q <= CH_EPS)
+			   continue;
+
+			if ((prev >= 0) && (inst.vt[i]*q <= capLeft[prev] + CH_EPS) &&
+				(inst.sc[i] > inst.hc[i]*q*(t - prev))) {
+
+			   for(tau = t; tau<inst.T; tau++){
+				  sol.FL[inst.itt(i, prev, tau)] += sol.FL[inst.itt(i, t, tau)];
+				  sol.FL[inst.itt(i, t, tau)] = 0;
+			   }
+
+			   capLeft[prev] -= inst.vt[i]*q;
+			   capLeft[t] += inst.vt[i]*q;
+			}
+			  else prev = t;
+		 }
+	  }
+
+
+
+	  // ***** 2. and 3. Storage and relocations ************************
+
+	  //If there is no storage for the merged lots,
+	  //try again with the lots before the merge
+	  if (!AssignStorage(inst, sol, message)) {
+		 sol.FL = lotFL;
+
+		 if (!AssignStorage(inst, sol, message))
+			return false;
+	  }
+
+
+
+	  //Setup of the items
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			double q = 0;
+			for(tau = t; tau<inst.T; tau++)
+			   q += sol.FL[inst.itt(i, t, tau)];
+
+			sol.Y[inst.it(i, t)] = (q > CH_EPS) ? 1 : 0;
+		 }
+
+
+	  message = "";
+	  return true;
+}
+
+
+
+
+//Read the instance from the data file, run the Constructive Heuristic and
+//print the initial solution in the output file of the programs
+inline bool InitialSolutionCH(const char *file, std::ostream &out, RCLSPMSL_Instance &inst,
+							  RCLSPMSL_Solution &sol, double &Time_CH)
+{
+	  std::string message;
+	  bool found = false;
+
+	  clock_t begin = clock();
+
+	  std::ifstream in(file);
+	  if (!in || !ReadInstance(in, inst))
+		 message = "the data file could not be read";
+	    else found = ConstructiveHeuristic(inst, sol, message);
+
+	  Time_CH = (double)(clock() - begin)/CLOCKS_PER_SEC;
+
+
+	  out << "********* Initial Solution: Solve the RCLSP-MSL by a Constructive Heuristic *********" << std::endl;
+	  out << std::endl << std::endl;
+
+	  if (found)
+		 out << "Objective Function Value CH = " << ComputeCosts(inst, sol).OF << std::endl;
+	    else out << "NO Solution to the RCLSP-MSL: " << message << std::endl;
+
+	  out << "Time CH = " << Time_CH << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+	  out << std::endl << std::endl << std::endl << std::endl << std::endl;
+
+	  return found;
+}
+
+
+
+
+//Print the solution of the Constructive Heuristic as the
+//final solution when the program does not find a solution
+inline void PrintFallbackCH(std::ostream &out, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol,
+							bool found, double OF_LB, double Time_CH)
+{
+	  if (!found) return;
+
+	  RCLSPMSL_Costs costs = ComputeCosts(inst, sol);
+
+	  out << std::endl << std::endl << std::endl;
+	  out << "********** Fallback Solution: the Solution of the Constructive Heuristic ************" << std::endl;
+	  out << std::endl << std::endl;
+	  out << "Objective Function Value = " << costs.OF << std::endl;
+	  out << "Gap = " << 100*((costs.OF - OF_LB)/costs.OF) << std::endl;
+	  out << "Time CH = " << Time_CH << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+	  out << std::endl << std::endl << std::endl;
+	  PrintCosts(out, costs);
+	  out << std::endl << std::endl << std::endl << std::endl << std::endl;
+	  PrintSolution(out, inst, sol);
+}
+
+
+#endif
@@ -0,0 +1,326 @@
+// ************************************************************************************* //
+//       Evaluator of solutions of the Facility Location Reformulation of the General    //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  The objective function, the cost of each part (as in the Other Values of the	 //
+//	  output files) and the slacks of the Capacity and CapacityStorage constraints	 //
+//	  are calculated once, and then updated by each change of a variable only for	 //
+//	  the values affected by the change. The changes are recorded and can be		 //
+//	  undone, so a candidate solution is evaluated without copying the solution		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_EVALUATOR_H
+#define RCLSPMSL_EVALUATOR_H
+
+
+#include <vector>
+#include <map>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+
+
+
+//Tolerance of the slacks of the Evaluator
+const double EV_EPS = 1e-6;
+
+
+
+
+class RCLSPMSL_Evaluator {
+
+public:
+
+	  //Copy the solution and calculate the costs and slacks
+	  RCLSPMSL_Evaluator(const RCLSPMSL_Instance &instance, const RCLSPMSL_Solution &solution)
+		  : inst(instance), sol(solution) {
+
+		  int T = inst.T, I = inst.I, L = inst.L, i, l, k, t, tau;
+		  size_t n;
+
+		  for(n=0; n<NCOSTS; n++) c[n] = 0;
+
+		  capSlack.assign(inst.Cap.begin(), inst.Cap.end());
+		  storSlack.assign((size_t)L*T, 0);
+		  qprod.assign((size_t)I*T, 0);
+		  nItems.assign((size_t)L*T, 0);
+
+
+		  for(i=0; i<I; i++)
+			 for(t=0; t<T; t++){
+				for(tau = t; tau<T; tau++){
+				   double x = sol.FL[inst.itt(i, t, tau)];
+				   c[CPROD] += inst.vc[i]*x;
+				   capSlack[t] -= inst.vt[i]*x;
+				   qprod[inst.it(i, t)] += x;
+				}
+
+				c[CSETUP] += inst.sc[i]*sol.Y[inst.it(i, t)];
+				c[NSETUP] += sol.Y[inst.it(i, t)];
+			 }
+
+		  for(l=0; l<L; l++)
+			 for(t=0; t<T; t++){
+				n = inst.lt(l, t);
+				c[CLOCAL] += inst.g[l]*sol.Z[n];
+				c[NLOCAL] += sol.Z[n];
+				c[OPENSPACE] += inst.H[l]*sol.Z[n];
+				storSlack[n] += inst.H[l]*sol.Z[n];
+			 }
+
+		  for(i=0; i<I; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   n = inst.ilt(i, l, t);
+
+				   c[CINVENT] += inst.hc[i]*sol.S[n];
+				   c[NINVENT] += sol.S[n];
+				   c[USEDSPACE] += inst.cs[i]*sol.S[n];
+				   storSlack[inst.lt(l, t)] -= inst.cs[i]*sol.S[n];
+
+				   c[CHAND] += inst.ha[inst.il(i, l)]*sol.Dp[n];
+				   c[NHAND] += sol.Dp[n];
+
+				   nItems[inst.lt(l, t)] += sol.W[n];
+				}
+
+		  for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+			 sol.vindex(it->first, i, l, k, t);
+
+			 if (l != k) {
+				c[CRELOC] += inst.r[inst.ilk(i, l, k)]*it->second;
+				c[NRELOC] += it->second;
+			 }
+			   else c[CSAME] += inst.r[inst.ilk(i, l, k)]*it->second;
+		  }
+
+
+		  nCapViol = 0;
+		  for(t=0; t<T; t++)
+			 if (capSlack[t] < -EV_EPS) nCapViol++;
+
+		  nStorViol = 0;
+		  for(n=0; n<storSlack.size(); n++)
+			 if (storSlack[n] < -EV_EPS) nStorViol++;
+	  }
+
+
+
+	  // ***** Changes of the variables ***************************************
+
+	  //Setup of item i in period t
+	  void setY(int i, int t, double value) {
+		  double &x = sol.Y[inst.it(i, t)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  add(CSETUP, inst.sc[i]*delta);
+		  add(NSETUP, delta);
+	  }
+
+
+	  //Use of location l in period t
+	  void setZ(int l, int t, double value) {
+		  double &x = sol.Z[inst.lt(l, t)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  add(CLOCAL, inst.g[l]*delta);
+		  add(NLOCAL, delta);
+		  add(OPENSPACE, inst.H[l]*delta);
+		  storage(l, t, inst.H[l]*delta);
+	  }
+
+
+	  //Inventory of item i at location l in period t
+	  void setS(int i, int l, int t, double value) {
+		  double &x = sol.S[inst.ilt(i, l, t)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  add(CINVENT, inst.hc[i]*delta);
+		  add(NINVENT, delta);
+		  add(USEDSPACE, inst.cs[i]*delta);
+		  storage(l, t, -inst.cs[i]*delta);
+	  }
+
+
+	  //Assignment of item i to location l in period t
+	  void setW(int i, int l, int t, double value) {
+		  double &x = sol.W[inst.ilt(i, l, t)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  put(nItems[inst.lt(l, t)], nItems[inst.lt(l, t)] + delta);
+	  }
+
+
+	  //Inflow of item i at location l in period t
+	  void setDp(int i, int l, int t, double value) {
+		  double &x = sol.Dp[inst.ilt(i, l, t)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  add(CHAND, inst.ha[inst.il(i, l)]*delta);
+		  add(NHAND, delta);
+	  }
+
+
+	  //Outflow of item i at location l in period t
+	  void setDm(int i, int l, int t, double value) {
+		  double &x = sol.Dm[inst.ilt(i, l, t)];
+		  if (value != x) put(x, value);
+	  }
+
+
+	  //Relocation of item i from location l to location k in period t
+	  void setV(int i, int l, int k, int t, double value) {
+		  size_t key = sol.vkey(i, l, k, t);
+		  double old = sol.getV(i, l, k, t), delta = value - old;
+		  if (delta == 0) return;
+
+		  Change ch = { 0, key, old };
+		  record.push_back(ch);
+		  sol.setV(i, l, k, t, value);
+
+		  if (l != k) {
+			 add(CRELOC, inst.r[inst.ilk(i, l, k)]*delta);
+			 add(NRELOC, delta);
+		  }
+			else add(CSAME, inst.r[inst.ilk(i, l, k)]*delta);
+	  }
+
+
+	  //Units of item i produced in period t for the demand in period tau
+	  void setFL(int i, int t, int tau, double value) {
+		  double &x = sol.FL[inst.itt(i, t, tau)], delta = value - x;
+		  if (delta == 0) return;
+
+		  put(x, value);
+		  add(CPROD, inst.vc[i]*delta);
+		  put(qprod[inst.it(i, t)], qprod[inst.it(i, t)] + delta);
+
+		  bool before = (capSlack[t] < -EV_EPS);
+		  put(capSlack[t], capSlack[t] - inst.vt[i]*delta);
+		  bool after = (capSlack[t] < -EV_EPS);
+
+		  if (before != after) put(nCapViol, nCapViol + (after ? 1 : -1));
+	  }
+
+
+
+	  // ***** Values of the solution ******************************************
+
+	  const RCLSPMSL_Solution &solution() const { return sol; }
+
+	  //Objective function value
+	  double cost() const {
+		  return c[CPROD] + c[CSETUP] + c[CINVENT] + c[CHAND] + c[CLOCAL] + c[CRELOC] + c[CSAME];
+	  }
+
+	  //Costs and other values, as in ComputeCosts
+	  RCLSPMSL_Costs costs() const {
+		  RCLSPMSL_Costs v;
+
+		  v.CProdItem = c[CPROD]; v.CSetupItem = c[CSETUP]; v.CInventItem = c[CINVENT];
+		  v.CHandItem = c[CHAND]; v.CSetupLocal = c[CLOCAL]; v.CRelocItem = c[CRELOC];
+
+		  v.NSetupItem = c[NSETUP]; v.NInventItem = c[NINVENT]; v.NHandItem = c[NHAND];
+		  v.NLocalUsed = c[NLOCAL]; v.NRelocItem = c[NRELOC];
+
+		  v.TotalOpenSpace = c[OPENSPACE]; v.TotalUsedSpace = c[USEDSPACE];
+		  v.PercUsedSpace = 100*(v.TotalUsedSpace/v.TotalOpenSpace);
+
+		  v.OF = cost();
+		  return v;
+	  }
+
+	  //Slack of the Capacity constraint in period t
+	  double capacitySlack(int t) const { return capSlack[t]; }
+
+	  //Slack of the CapacityStorage constraint of location l in period t
+	  double storageSlack(int l, int t) const { return storSlack[inst.lt(l, t)]; }
+
+	  //Production of item i in period t
+	  double production(int i, int t) const { return qprod[inst.it(i, t)]; }
+
+	  //Number of items assigned to location l in period t
+	  double items(int l, int t) const { return nItems[inst.lt(l, t)]; }
+
+	  //Number of violated Capacity and CapacityStorage constraints
+	  int capacityViolations() const { return (int)(nCapViol + nStorViol); }
+
+
+
+	  // ***** Record of the changes *******************************************
+
+	  //Position in the record, to undo the changes made after it
+	  size_t mark() const { return record.size(); }
+
+	  //Undo the changes made after the position m
+	  void undo(size_t m = 0) {
+		  for(size_t a = record.size(); a-- > m; ){
+			 if (record[a].x) *record[a].x = record[a].old;
+			   else if (record[a].old != 0) sol.V[record[a].key] = record[a].old;
+			   else sol.V.erase(record[a].key);
+		  }
+		  record.resize(m);
+	  }
+
+	  //Keep the changes (clear the record)
+	  void commit() { record.clear(); }
+
+
+
+private:
+
+	  const RCLSPMSL_Instance &inst;
+	  RCLSPMSL_Solution sol;
+
+
+	  //Costs and other values of the solution
+	  //(CSAME: relocation cost with l == k, in the objective function)
+	  enum { CPROD, CSETUP, CINVENT, CHAND, CLOCAL, CRELOC, CSAME,
+			 NSETUP, NINVENT, NHAND, NLOCAL, NRELOC,
+			 OPENSPACE, USEDSPACE, NCOSTS };
+
+	  double c[NCOSTS];
+
+
+	  std::vector<double> capSlack,								  //slack of the Capacity constraints [T]
+						  storSlack,								  //slack of the CapacityStorage constraints [L*T]
+						  qprod,									  //production of item i in period t [I*T]
+						  nItems;									  //number of items at location l in period t [L*T]
+
+	  double nCapViol, nStorViol;								  //number of violated Capacity and CapacityStorage constraints
+
+
+
+	  //Record of the changed values (x == 0: relocation with the key)
+	  struct Change { double *x; size_t key; double old; };
+	  std::vector<Change> record;
+
+
+	  void put(double &x, double value) {
+		  Change ch = { &x, 0, x };
+		  record.push_back(ch);
+		  x = value;
+	  }
+
+	  void add(int n, double delta) { put(c[n], c[n] + delta); }
+
+
+	  void storage(int l, int t, double delta) {
+		  double &s = storSlack[inst.lt(l, t)];
+
+		  bool before = (s < -EV_EPS);
+		  put(s, s + delta);
+		  bool after = (s < -EV_EPS);
+
+		  if (before != after) put(nStorViol, nStorViol + (after ? 1 : -1));
+	  }
+
+};
+
+
+#endif
@@ -0,0 +1,217 @@
+// ************************************************************************************* //
+//       Generator of instances of the Facility Location Reformulation of the General    //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  Random instances of any size (T, I, L) with controlled tightness: the			 //
+//	  capacity tightness is the average use of the production capacity, the			 //
+//	  storage tightness is the volume of the demand of one period over the storage	 //
+//	  capacity of all the locations, alpha and beta are the densities of the			 //
+//	  compatibilities, and the relocation costs are uniform, by distance between		 //
+//	  the locations or by item. The same parameters and seed give the same instance	 //
+//	  on every platform (the random numbers do not depend on the C++ library)		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_GENERATOR_H
+#define RCLSPMSL_GENERATOR_H
+
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include "RCLSP-MSL_Instance.h"
+
+
+
+//Structures of the relocation costs r[i][l][k]
+enum {
+	  GEN_RELOC_UNIFORM,											  //uniform in [1, 3] for each item and pair of locations
+	  GEN_RELOC_DISTANCE,											  //distance between the locations times the storage consumption of the item
+	  GEN_RELOC_ITEM												  //the same cost in [1, 3] for all the pairs of locations of an item
+};
+
+
+
+
+//Parameters of the generator
+struct RCLSPMSL_GeneratorParams {
+
+	  int T, I, L;
+	  unsigned seed;
+	  double capacity;											  //capacity tightness: average use of the production capacity (0, 1]
+	  double storage;											  //storage tightness: volume of the demand of a period over the storage capacity
+	  double alpha;												  //density of the compatible pairs item-location
+	  double beta;												  //density of the compatible pairs of items
+	  double demand;											  //probability of a nonzero demand of an item in a period
+	  int dmin, dmax;											  //range of the nonzero demand
+	  int relocation;											  //structure of the relocation costs
+
+	  RCLSPMSL_GeneratorParams() : T(12), I(20), L(5), seed(1), capacity(0.8), storage(0.5), alpha(0.8), beta(0.85),
+								   demand(0.6), dmin(20), dmax(100), relocation(GEN_RELOC_UNIFORM) {}
+
+};
+
+
+
+
+//Random numbers of the generator: the Mersenne Twister is the same on
+//every platform, but the distributions of <random> are not
+class RCLSPMSL_GeneratorRandom {
+
+	  std::mt19937 rng;
+
+public:
+
+	  RCLSPMSL_GeneratorRandom(unsigned seed) : rng(seed) {}
+
+	  //Integer in [a, b]
+	  int integer(int a, int b) { return a + (int)(rng() % (unsigned)(b - a + 1)); }
+
+	  //Real number in [0, 1)
+	  double real() { return rng()/4294967296.0; }
+
+	  bool chance(double p) { return real() < p; }
+
+};
+
+
+
+
+//Name of the structure of the relocation costs and structure of a name
+//Return -1 if the name is not known
+inline const char *RelocationName(int relocation)
+{
+	  const char *names[] = { "uniform", "distance", "item" };
+	  return ((relocation >= 0) && (relocation <= GEN_RELOC_ITEM)) ? names[relocation] : "";
+}
+
+inline int RelocationStructure(const std::string &name)
+{
+	  for(int a = 0; a <= GEN_RELOC_ITEM; a++)
+		 if (name == RelocationName(a)) return a;
+
+	  return -1;
+}
+
+
+
+
+//Generate the instance of the parameters. The data are integers, as in the
+//data files: costs of the items and of the locations in the ranges of the
+//original instances, the production capacity (the same in all the periods)
+//from the capacity tightness, never below the cumulative demand of the first
+//periods (so that the instance is feasible), and the storage capacity of the
+//locations from the storage tightness. Every item is compatible with itself
+//and with at least one location
+inline void GenerateInstance(const RCLSPMSL_GeneratorParams &par, RCLSPMSL_Instance &inst)
+{
+	  int T = par.T, I = par.I, L = par.L;
+	  int t, i, j, l, k;
+	  RCLSPMSL_GeneratorRandom rnd(par.seed);
+
+	  inst.resize(T, I, L);
+
+
+	  //Items: costs, consumption of capacity and of storage, demand
+	  for(i=0; i<I; i++){
+		 inst.vc[i] = rnd.integer(1, 5);
+		 inst.sc[i] = rnd.integer(100, 1000);
+		 inst.hc[i] = rnd.integer(1, 5);
+		 inst.vt[i] = rnd.integer(1, 2);
+		 inst.cs[i] = rnd.integer(1, 3);
+	  }
+
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++)
+			inst.d[inst.it(i, t)] = (rnd.chance(par.demand)) ? rnd.integer(par.dmin, par.dmax) : 0;
+
+
+	  //Production capacity: average use of the capacity, and enough
+	  //capacity for the cumulative demand of each period
+	  double need = 0, volume = 0, cap = 0;
+
+	  for(t=0; t<T; t++){
+		 for(i=0; i<I; i++){
+			need += inst.vt[i]*inst.d[inst.it(i, t)];
+			volume += inst.cs[i]*inst.d[inst.it(i, t)];
+		 }
+		 cap = std::max(cap, need/(t + 1));
+	  }
+
+	  cap = std::max(cap, need/T/par.capacity);
+	  for(t=0; t<T; t++)
+		 inst.Cap[t] = std::max(1.0, ceil(cap));
+
+
+	  //Locations: storage capacity (shares of the total capacity from the
+	  //storage tightness, each share between 0.5 and 1.5 of the average)
+	  //and fixed cost
+	  std::vector<double> share(L);
+	  double total = 0;
+
+	  for(l=0; l<L; l++){
+		 share[l] = 0.5 + rnd.real();
+		 total += share[l];
+	  }
+
+	  for(l=0; l<L; l++){
+		 inst.H[l] = std::max(1.0, ceil(volume/T/par.storage*share[l]/total));
+		 inst.g[l] = rnd.integer(50, 300);
+	  }
+
+
+	  //Handling costs and compatibilities
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			inst.ha[inst.il(i, l)] = rnd.integer(1, 4);
+
+	  for(i=0; i<I; i++){
+		 bool any = false;
+
+		 for(l=0; l<L; l++){
+			inst.alpha[inst.il(i, l)] = (rnd.chance(par.alpha)) ? 1 : 0;
+			if (inst.alpha[inst.il(i, l)] > 0) any = true;
+		 }
+
+		 if (!any) inst.alpha[inst.il(i, rnd.integer(0, L - 1))] = 1;
+	  }
+
+	  for(i=0; i<I; i++){
+		 inst.beta[inst.ij(i, i)] = 1;
+
+		 for(j=i+1; j<I; j++)
+			inst.beta[inst.ij(i, j)] = inst.beta[inst.ij(j, i)] = (rnd.chance(par.beta)) ? 1 : 0;
+	  }
+
+
+	  //Relocation costs (zero from a location to itself)
+	  std::vector<double> x(L), y(L);
+
+	  for(l=0; l<L; l++){
+		 x[l] = 100*rnd.real();
+		 y[l] = 100*rnd.real();
+	  }
+
+	  for(i=0; i<I; i++){
+		 int cost = rnd.integer(1, 3);
+
+		 for(l=0; l<L; l++)
+			for(k=0; k<L; k++){
+			   double r = 0;
+
+			   if (l != k)
+				  switch (par.relocation) {
+					 case GEN_RELOC_DISTANCE: r = std::max(1.0, ceil(inst.cs[i]*hypot(x[l] - x[k], y[l] - y[k])/50)); break;
+					 case GEN_RELOC_ITEM: r = cost; break;
+					 default: r = rnd.integer(1, 3);
+				  }
+
+			   inst.r[inst.ilk(i, l, k)] = r;
+			}
+	  }
+}
+
+
+#endif
@@ -0,0 +1,264 @@
+// ************************************************************************************* //
+//        Instance of the Facility Location Reformulation of the General Capacitated     //
+//             Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)            //
+//	 																					 //
+//	  Plain C++ representation of the data file read by all the programs, with		 //
+//	  the parameters stored in flat arrays (no optimization package is needed)		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_INSTANCE_H
+#define RCLSPMSL_INSTANCE_H
+
+
+#include <iostream>
+#include <vector>
+
+
+
+struct RCLSPMSL_Instance {
+
+	  //Indexes: time periods, items, locations
+	  int T, I, L;
+
+
+	  //Production of items
+	  std::vector<double> vc;										  //production cost per unit of item [I]
+	  std::vector<double> sc;										  //setup cost of item [I]
+	  std::vector<double> hc;										  //inventory holding cost per unit of item [I]
+	  std::vector<double> vt;										  //production consumption of capacity per unit of item [I]
+	  std::vector<double> Cap;										  //production capacity in each period [T]
+	  std::vector<double> d;										  //demand of item i in period t [I*T]
+
+
+	  //Inventory of items
+	  std::vector<double> g;										  //fixed cost of using location l [L]
+	  std::vector<double> ha;										  //unit handling cost of item i at location l [I*L]
+	  std::vector<double> cs;										  //consumption of storage capacity per unit of item [I]
+	  std::vector<double> H;										  //storage capacity of each location [L]
+	  std::vector<double> alpha;									  //compatibility between item i and location l [I*L]
+	  std::vector<double> beta;										  //compatibility between item i and item j [I*I]
+	  std::vector<double> r;										  //unit moving cost of item i from location l to k [I*L*L]
+
+
+
+	  RCLSPMSL_Instance() : T(0), I(0), L(0) {}
+
+
+
+	  //Index of the flat arrays
+	  inline size_t it(int i, int t) const { return (size_t)i*T + t; }
+	  inline size_t il(int i, int l) const { return (size_t)i*L + l; }
+	  inline size_t ij(int i, int j) const { return (size_t)i*I + j; }
+	  inline size_t lt(int l, int t) const { return (size_t)l*T + t; }
+	  inline size_t ilk(int i, int l, int k) const { return ((size_t)i*L + l)*L + k; }
+	  inline size_t ilt(int i, int l, int t) const { return ((size_t)i*L + l)*T + t; }
+	  inline size_t itt(int i, int t, int tau) const { return ((size_t)i*T + t)*T + tau; }
+	  inline size_t illt(int i, int l, int k, int t) const { return (((size_t)i*L + l)*L + k)*T + t; }
+
+
+
+	  //Allocate the parameters for the indexes T, I and L
+	  void resize(int nT, int nI, int nL) {
+
+		  T = nT; I = nI; L = nL;
+
+		  vc.assign(I, 0); sc.assign(I, 0); hc.assign(I, 0); vt.assign(I, 0); cs.assign(I, 0);
+		  Cap.assign(T, 0);
+		  d.assign((size_t)I*T, 0);
+		  g.assign(L, 0); H.assign(L, 0);
+		  ha.assign((size_t)I*L, 0);
+		  alpha.assign((size_t)I*L, 0);
+		  beta.assign((size_t)I*I, 0);
+		  r.assign((size_t)I*L*L, 0);
+	  }
+
+
+
+	  //Compatibility between the items i and j, as in
+	  //the ItemItemCompat constraints (pairs with j >= i)
+	  inline double compat(int i, int j) const {
+		  return (i <= j) ? beta[ij(i, j)] : beta[ij(j, i)];
+	  }
+
+
+
+	  //Big M of the InvAlloc constraints, calculated as in
+	  //the programs: the smallest value between the sum of the
+	  //demand from t to T and the allocation of items, with
+	  //the sum of the demand and the Big M stored as integers
+	  inline double BigM(int i, int l, int t) const {
+
+		  int sumd = 0;
+		  for(int tau = t; tau < T; tau++)
+			 sumd += d[it(i, tau)];
+
+		  double allocitem = H[l]/cs[i];
+
+		  long BigM;
+		  if (sumd <= allocitem) BigM = sumd;
+		    else BigM = (long)allocitem;
+
+		  return (double)BigM;
+	  }
+
+};
+
+
+
+
+//Read the instance from the data file (same format of dataRCLSPMSL.dat)
+//Return false if the file is not complete
+inline bool ReadInstance(std::istream &in, RCLSPMSL_Instance &inst)
+{
+	  int t, i, l, j, k, nT, nI, nL;
+
+	  if (!(in >> nT >> nI >> nL)) return false;
+
+	  inst.resize(nT, nI, nL);
+
+	  for(t=0; t<nT; t++)
+		 in >> inst.Cap[t];
+
+	  for(i=0; i<nI; i++){
+		 in >> inst.vc[i];
+		 in >> inst.sc[i];
+		 in >> inst.hc[i];
+		 in >> inst.vt[i];
+		 in >> inst.cs[i];
+	  }
+
+	  for(i=0; i<nI; i++)
+		 for(t=0; t<nT; t++)
+			in >> inst.d[inst.it(i, t)];
+
+	  for(l=0; l<nL; l++){
+		 in >> inst.H[l];
+		 in >> inst.g[l];
+	  }
+
+	  for(i=0; i<nI; i++)
+		 for(l=0; l<nL; l++)
+			in >> inst.ha[inst.il(i, l)];
+
+	  for(i=0; i<nI; i++)
+		 for(l=0; l<nL; l++)
+			in >> inst.alpha[inst.il(i, l)];
+
+	  for(i=0; i<nI; i++)
+		 for(j=0; j<nI; j++)
+			in >> inst.beta[inst.ij(i, j)];
+
+	  for(i=0; i<nI; i++)
+		 for(l=0; l<nL; l++)
+			for(k=0; k<nL; k++)
+			   in >> inst.r[inst.ilk(i, l, k)];
+
+	  return !in.fail();
+}
+
+
+
+
+//Write the instance in the format of the data file
+inline void WriteInstance(std::ostream &out, const RCLSPMSL_Instance &inst)
+{
+	  int t, i, l, j, k;
+
+	  out << inst.T << std::endl << inst.I << std::endl << inst.L << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 out << inst.Cap[t] << " ";
+	  out << std::endl << std::endl;
+
+	  for(i=0; i<inst.I; i++)
+		 out << inst.vc[i] << " " << inst.sc[i] << " " << inst.hc[i] << " " << inst.vt[i] << " " << inst.cs[i] << std::endl;
+	  out << std::endl;
+
+	  for(i=0; i<inst.I; i++){
+		 for(t=0; t<inst.T; t++)
+			out << inst.d[inst.it(i, t)] << " ";
+		 out << std::endl;
+	  }
+	  out << std::endl;
+
+	  for(l=0; l<inst.L; l++)
+		 out << inst.H[l] << " " << inst.g[l] << std::endl;
+	  out << std::endl;
+
+	  for(i=0; i<inst.I; i++){
+		 for(l=0; l<inst.L; l++)
+			out << inst.ha[inst.il(i, l)] << " ";
+		 out << std::endl;
+	  }
+	  out << std::endl;
+
+	  for(i=0; i<inst.I; i++){
+		 for(l=0; l<inst.L; l++)
+			out << inst.alpha[inst.il(i, l)] << " ";
+		 out << std::endl;
+	  }
+	  out << std::endl;
+
+	  for(i=0; i<inst.I; i++){
+		 for(j=0; j<inst.I; j++)
+			out << inst.beta[inst.ij(i, j)] << " ";
+		 out << std::endl;
+	  }
+	  out << std::endl;
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++){
+			for(k=0; k<inst.L; k++)
+			   out << inst.r[inst.ilk(i, l, k)] << " ";
+			out << std::endl;
+		 }
+}
+
+
+
+
+
+//Read the demand scenarios of the instance: the number of scenarios and,
+//for each scenario, the demand d[i][t] in the layout of the data file
+//Return false if the file is not complete
+inline bool ReadScenarios(std::istream &in, const RCLSPMSL_Instance &inst, std::vector<std::vector<double> > &demand)
+{
+	  int n, s, i, t;
+
+	  if (!(in >> n) || (n < 0)) return false;
+
+	  demand.assign(n, std::vector<double>((size_t)inst.I*inst.T, 0));
+
+	  for(s=0; s<n; s++)
+		 for(i=0; i<inst.I; i++)
+			for(t=0; t<inst.T; t++)
+			   in >> demand[s][inst.it(i, t)];
+
+	  return !in.fail();
+}
+
+
+
+
+//Read a demand update of the instance: the number of periods already
+//executed and the demand d[i][t] in the layout of the data file (the
+//realised demand of the executed periods and the forecast of the others)
+//Return false if there is no complete update
+inline bool ReadDemandUpdate(std::istream &in, const RCLSPMSL_Instance &inst, int &executed, std::vector<double> &demand)
+{
+	  int i, t;
+
+	  if (!(in >> executed) || (executed < 0) || (executed > inst.T)) return false;
+
+	  demand.assign((size_t)inst.I*inst.T, 0);
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++)
+			in >> demand[inst.it(i, t)];
+
+	  return !in.fail();
+}
+
+
+#endif
@@ -0,0 +1,279 @@
+// ************************************************************************************* //
+//        JSON values of the programs of the Facility Location Reformulation of the      //
+//   General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)  //
+//	 																					 //
+//	  A small reader of JSON text (objects, arrays, numbers, strings, true, false	 //
+//	  and null) and the functions that write the values of the replies				 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_JSON_H
+#define RCLSPMSL_JSON_H
+
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+
+
+
+//Value of a JSON text (the members of an object are
+//the values in items, with their names in keys)
+struct RCLSPMSL_Json {
+
+	  enum Type { Null, Bool, Number, String, Array, Object };
+
+	  Type type;
+	  bool boolean;
+	  double number;
+	  std::string text;
+	  std::vector<std::string> keys;
+	  std::vector<RCLSPMSL_Json> items;
+
+
+	  RCLSPMSL_Json() : type(Null), boolean(false), number(0) {}
+
+
+	  //Member of an object (NULL if there is no such member)
+	  const RCLSPMSL_Json *get(const std::string &key) const
+	  {
+		  if (type != Object) return NULL;
+
+		  for(size_t a = 0; a < keys.size(); a++)
+			 if (keys[a] == key) return &items[a];
+
+		  return NULL;
+	  }
+
+	  //Values of the members, or the default value if there is no such member
+	  double getNum(const std::string &key, double def) const
+	  {
+		  const RCLSPMSL_Json *v = get(key);
+		  return ((v != NULL) && (v->type == Number)) ? v->number : def;
+	  }
+
+	  std::string getString(const std::string &key, const std::string &def) const
+	  {
+		  const RCLSPMSL_Json *v = get(key);
+		  return ((v != NULL) && (v->type == String)) ? v->text : def;
+	  }
+
+	  bool getBool(const std::string &key, bool def) const
+	  {
+		  const RCLSPMSL_Json *v = get(key);
+		  return ((v != NULL) && (v->type == Bool)) ? v->boolean : def;
+	  }
+
+};
+
+
+
+
+//Reader of a JSON text (recursive descent)
+class RCLSPMSL_JsonReader {
+
+	  const std::string &s;
+	  size_t p;
+
+	  void space() { while ((p < s.size()) && isspace((unsigned char)s[p])) p++; }
+
+	  bool literal(const char *word)
+	  {
+		  size_t n = strlen(word);
+		  if (s.compare(p, n, word) != 0) return false;
+		  p += n;
+		  return true;
+	  }
+
+	  bool quoted(std::string &out)
+	  {
+		  if ((p >= s.size()) || (s[p] != '"')) return false;
+		  p++;
+
+		  out.clear();
+		  while (p < s.size()) {
+			 char c = s[p++];
+
+			 if (c == '"') return true;
+			 if (c != '\\') { out += c; continue; }
+			 if (p >= s.size()) return false;
+
+			 c = s[p++];
+			 switch (c) {
+				case 'n': out += '\n'; break;
+				case 't': out += '\t'; break;
+				case 'r': out += '\r'; break;
+				case 'b': out += '\b'; break;
+				case 'f': out += '\f'; break;
+				case 'u': {
+				   //Only the characters of one byte are kept
+				   if (p + 4 > s.size()) return false;
+				   unsigned code = (unsigned)strtoul(s.substr(p, 4).c_str(), NULL, 16);
+				   out += (code < 128) ? (char)code : '?';
+				   p += 4;
+				   break;
+				}
+				default: out += c;
+			 }
+		  }
+
+		  return false;
+	  }
+
+	  bool value(RCLSPMSL_Json &v, int depth)
+	  {
+		  if (depth > 64) return false;
+
+		  space();
+		  if (p >= s.size()) return false;
+
+		  char c = s[p];
+
+		  if (c == '{') {
+			 v.type = RCLSPMSL_Json::Object;
+			 p++; space();
+			 if ((p < s.size()) && (s[p] == '}')) { p++; return true; }
+
+			 for(; ;){
+				std::string key;
+				space();
+				if (!quoted(key)) return false;
+				space();
+				if ((p >= s.size()) || (s[p] != ':')) return false;
+				p++;
+
+				v.keys.push_back(key);
+				v.items.push_back(RCLSPMSL_Json());
+				if (!value(v.items.back(), depth + 1)) return false;
+
+				space();
+				if (p >= s.size()) return false;
+				if (s[p] == ',') { p++; continue; }
+				if (s[p] == '}') { p++; return true; }
+				return false;
+			 }
+		  }
+
+		  if (c == '[') {
+			 v.type = RCLSPMSL_Json::Array;
+			 p++; space();
+			 if ((p < s.size()) && (s[p] == ']')) { p++; return true; }
+
+			 for(; ;){
+				v.items.push_back(RCLSPMSL_Json());
+				if (!value(v.items.back(), depth + 1)) return false;
+
+				space();
+				if (p >= s.size()) return false;
+				if (s[p] == ',') { p++; continue; }
+				if (s[p] == ']') { p++; return true; }
+				return false;
+			 }
+		  }
+
+		  if (c == '"') {
+			 v.type = RCLSPMSL_Json::String;
+			 return quoted(v.text);
+		  }
+
+		  if (literal("true")) { v.type = RCLSPMSL_Json::Bool; v.boolean = true; return true; }
+		  if (literal("false")) { v.type = RCLSPMSL_Json::Bool; v.boolean = false; return true; }
+		  if (literal("null")) { v.type = RCLSPMSL_Json::Null; return true; }
+
+		  const char *begin = s.c_str() + p;
+		  char *end = NULL;
+		  v.number = strtod(begin, &end);
+		  if (end == begin) return false;
+
+		  v.type = RCLSPMSL_Json::Number;
+		  p += end - begin;
+		  return true;
+	  }
+
+public:
+
+	  RCLSPMSL_JsonReader(const std::string &text) : s(text), p(0) {}
+
+	  //Read the value of the whole text
+	  //Return false if the text is not a JSON value
+	  bool read(RCLSPMSL_Json &v)
+	  {
+		  v = RCLSPMSL_Json();
+		  if (!value(v, 0)) return false;
+
+		  space();
+		  return (p == s.size());
+	  }
+
+};
+
+
+
+
+//Read the JSON value of the text
+//Return false if the text is not a JSON value
+inline bool ReadJson(const std::string &text, RCLSPMSL_Json &v)
+{
+	  RCLSPMSL_JsonReader reader(text);
+	  return reader.read(v);
+}
+
+
+
+
+//Write a string and a number as JSON values (the numbers
+//that are not finite are written as null)
+inline void WriteJsonString(std::ostream &out, const std::string &s)
+{
+	  out << '"';
+
+	  for(size_t a = 0; a < s.size(); a++){
+		 char c = s[a];
+
+		 if ((c == '"') || (c == '\\')) out << '\\' << c;
+		   else if (c == '\n') out << "\\n";
+		   else if (c == '\t') out << "\\t";
+		   else if (c == '\r') out << "\\r";
+		   else if ((unsigned char)c < 32) {
+			  char code[8];
+			  sprintf(code, "\\u%04x", (unsigned)c);
+			  out << code;
+		   }
+		   else out << c;
+	  }
+
+	  out << '"';
+}
+
+inline void WriteJsonNumber(std::ostream &out, double v)
+{
+	  if (!std::isfinite(v)) { out << "null"; return; }
+
+	  char text[32];
+	  sprintf(text, "%.10g", v);
+	  out << text;
+}
+
+
+
+
+//Write a vector as a JSON array of numbers
+inline void WriteJsonArray(std::ostream &out, const std::vector<double> &v)
+{
+	  out << '[';
+
+	  for(size_t a = 0; a < v.size(); a++){
+		 if (a > 0) out << ',';
+		 WriteJsonNumber(out, v[a]);
+	  }
+
+	  out << ']';
+}
+
+
+#endif
@@ -0,0 +1,613 @@
+// ************************************************************************************* //
+//      Local Search to improve a solution of the Facility Location Reformulation of     //
+//     the General Capacitated Lot-Sizing Problem with Multiple Storage Locations        //
+//                                   (RCLSP-MSL)                                         //
+//	 																					 //
+//	  Improvement without an optimization package, over the plain C++ solution:		 //
+//	  1. Merge: the production of a setup is moved to the previous setup of the item	 //
+//	  2. Split: the production for a period is moved to a later period (setup)		 //
+//	  3. Reassign: the inventory of an item in consecutive periods is moved from		 //
+//	     one location to another location											 //
+//	  4. Close: the items of a location in a period are moved to other locations		 //
+//	  5. Swap: the items of a used location are moved to a closed location			 //
+//	  Each move is applied in the Evaluator (RCLSP-MSL_Evaluator.h), which updates	 //
+//	  the objective function only for the changed values, and the move is undone	 //
+//	  when it does not improve the solution. Several move streams (different		 //
+//	  order of the moves) run in parallel threads and the best solution is kept		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_LOCALSEARCH_H
+#define RCLSPMSL_LOCALSEARCH_H
+
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Evaluator.h"
+#include "RCLSP-MSL_Trace.h"
+
+
+
+//Tolerance of the Local Search
+const double LS_EPS = 1e-6;
+
+
+
+
+//Parameters of the Local Search
+struct RCLSPMSL_LSParams {
+
+	  int threads;												  //number of threads (one move stream per thread)
+	  double timeLimit;											  //maximum time (seconds)
+	  unsigned seed;											  //seed of the order of the moves
+
+	  RCLSPMSL_LSParams() : threads(1), timeLimit(10), seed(1) {}
+
+};
+
+
+
+
+//Result of the Local Search
+struct RCLSPMSL_LSResult {
+
+	  double OF_begin, OF_end, Time;
+	  long Moves;												  //number of improving moves of the best stream
+	  int Stream;												  //move stream of the best solution
+
+	  RCLSPMSL_LSResult() : OF_begin(0), OF_end(0), Time(0), Moves(0), Stream(0) {}
+
+};
+
+
+
+
+class RCLSPMSL_LocalSearch {
+
+public:
+
+	  //Copy the solution (with the assignment only where there is inventory
+	  //and the setup only where there is production) into the Evaluator
+	  RCLSPMSL_LocalSearch(const RCLSPMSL_Instance &instance, const RCLSPMSL_Solution &solution, unsigned seed)
+		  : inst(instance), ev(instance, Normalize(instance, solution)), sol(ev.solution()),
+			rng(seed), shuffle(seed != 0), nMoves(0) {
+
+		  int i, l, t;
+
+		  bigM.assign((size_t)inst.I*inst.L*inst.T, 0);
+		  dirty.assign((size_t)inst.I*inst.T, 0);
+
+		  for(i=0; i<inst.I; i++)
+			 for(l=0; l<inst.L; l++)
+				for(t=0; t<inst.T; t++)
+				   bigM[inst.ilt(i, l, t)] = inst.BigM(i, l, t);
+	  }
+
+
+
+	  //Apply the moves until no move improves the solution or the time limit
+	  void run(double timeLimit) {
+
+		  begin = std::chrono::steady_clock::now();
+		  limit = timeLimit;
+
+		  int T = inst.T, I = inst.I, L = inst.L, i, l, k, t, tau, a, b;
+		  bool improved = true;
+
+		  std::vector<int> items(I), locs(L), periods(T);
+		  for(i=0; i<I; i++) items[i] = i;
+		  for(l=0; l<L; l++) locs[l] = l;
+		  for(t=0; t<T; t++) periods[t] = t;
+
+
+		  while (improved && !timeout()) {
+			 improved = false;
+
+			 if (shuffle) {
+				std::shuffle(items.begin(), items.end(), rng);
+				std::shuffle(locs.begin(), locs.end(), rng);
+				std::shuffle(periods.begin(), periods.end(), rng);
+			 }
+
+
+			 //1. Merge the production of a setup into the previous setup
+			 for(a=0; a<I && !timeout(); a++)
+				for(b=0; b<T; b++){
+				   i = items[a]; t = periods[b];
+				   if ((sol.Y[inst.it(i, t)] > 0.5) && (MoveMerge(i, t))) improved = true;
+				}
+
+
+			 //2. Split the production for the period tau
+			 //from the setup in t to a later period
+			 for(a=0; a<I && !timeout(); a++)
+				for(b=0; b<T; b++){
+				   i = items[a]; t = periods[b];
+				   if (sol.Y[inst.it(i, t)] < 0.5) continue;
+
+				   for(tau = t+1; tau<T; tau++)
+					  if ((sol.FL[inst.itt(i, t, tau)] > LS_EPS) && (MoveSplit(i, t, tau)))
+						 improved = true;
+				}
+
+
+			 //3. Reassign the inventory of an item in
+			 //consecutive periods to another location
+			 for(a=0; a<I && !timeout(); a++)
+				for(b=0; b<L; b++){
+				   i = items[a]; l = locs[b];
+
+				   for(t=0; t<T; t++)
+					  if ((sol.S[inst.ilt(i, l, t)] > 0) && ((t == 0) || (sol.S[inst.ilt(i, l, t-1)] == 0)))
+						 for(k=0; k<L; k++)
+							if ((k != l) && (MoveReassign(i, l, k, t))) {
+							   improved = true;
+							   break;
+							}
+				}
+
+
+			 //4. Close a location in a period
+			 for(b=0; b<L && !timeout(); b++)
+				for(t=0; t<T; t++){
+				   l = locs[b];
+				   if ((sol.Z[inst.lt(l, t)] > 0.5) && (MoveClose(l, t))) improved = true;
+				}
+
+
+			 //5. Move the items of a used location to a closed location
+			 for(b=0; b<L && !timeout(); b++)
+				for(t=0; t<T; t++){
+				   l = locs[b];
+				   if (sol.Z[inst.lt(l, t)] > 0.5) continue;
+
+				   for(k=0; k<L; k++)
+					  if ((k != l) && (sol.Z[inst.lt(k, t)] > 0.5) && (MoveSwap(k, l, t))) {
+						 improved = true;
+						 break;
+					  }
+				}
+		  }
+	  }
+
+
+
+	  const RCLSPMSL_Solution &solution() const { return sol; }
+
+	  double cost() const { return ev.cost(); }
+
+	  long moves() const { return nMoves; }
+
+
+
+private:
+
+	  const RCLSPMSL_Instance &inst;
+
+	  RCLSPMSL_Evaluator ev;										  //solution, costs and slacks (see RCLSP-MSL_Evaluator.h)
+	  const RCLSPMSL_Solution &sol;
+
+	  std::vector<double> bigM;									  //Big M of the InvAlloc constraints [I*L*T]
+
+	  std::vector<char> dirty;									  //flows of item i in period t to be calculated [I*T]
+	  std::vector<size_t> dirtyList;
+
+	  std::mt19937 rng;
+	  bool shuffle;
+	  long nMoves;
+
+	  std::chrono::steady_clock::time_point begin;
+	  double limit;
+
+
+
+	  static RCLSPMSL_Solution Normalize(const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &solution) {
+
+		  RCLSPMSL_Solution s = solution;
+		  int i, l, t, tau;
+
+		  for(size_t n = 0; n < s.S.size(); n++){
+			 if (s.S[n] < LS_EPS) s.S[n] = 0;
+			 s.W[n] = (s.S[n] > 0) ? 1 : 0;
+		  }
+
+		  for(i=0; i<inst.I; i++)
+			 for(t=0; t<inst.T; t++){
+				double q = 0;
+				for(tau = t; tau<inst.T; tau++)
+				   q += s.FL[inst.itt(i, t, tau)];
+
+				s.Y[inst.it(i, t)] = (q > LS_EPS) ? 1 : 0;
+			 }
+
+		  for(l=0; l<inst.L; l++)
+			 for(t=0; t<inst.T; t++){
+				bool used = false;
+				for(i=0; (i<inst.I) && (!used); i++)
+				   used = (s.W[inst.ilt(i, l, t)] > 0.5);
+
+				s.Z[inst.lt(l, t)] = used ? 1 : 0;
+			 }
+
+		  return s;
+	  }
+
+
+
+	  //Undo the changes of the move
+	  void undo() {
+		  ev.undo();
+
+		  for(size_t a = 0; a < dirtyList.size(); a++)
+			 dirty[dirtyList[a]] = 0;
+		  dirtyList.clear();
+	  }
+
+
+	  //Keep the move if it improves the objective function
+	  bool finish(double OF_before) {
+		  Flows();
+
+		  if (ev.cost() < OF_before - LS_EPS) {
+			 ev.commit();
+			 nMoves++;
+			 return true;
+		  }
+
+		  undo();
+		  return false;
+	  }
+
+
+	  bool timeout() const {
+		  return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() > limit;
+	  }
+
+
+
+	  //Change the inventory of item i at location l in period t,
+	  //with the assignment (W) and the use of the location (Z)
+	  void setS(int i, int l, int t, double value) {
+
+		  size_t n = inst.ilt(i, l, t);
+		  if (value < LS_EPS) value = 0;
+
+		  ev.setS(i, l, t, value);
+
+		  if ((value > 0) && (sol.W[n] < 0.5)) {
+			 ev.setW(i, l, t, 1);
+			 ev.setZ(l, t, 1);
+		  }
+			else if ((value == 0) && (sol.W[n] > 0.5)) {
+			   ev.setW(i, l, t, 0);
+			   if (ev.items(l, t) < 0.5) ev.setZ(l, t, 0);
+			}
+
+		  Mark(i, t);
+		  if (t+1 < inst.T) Mark(i, t+1);
+	  }
+
+
+	  //Change the units of item i produced in t for the demand in tau, with the setup (Y)
+	  void setFL(int i, int t, int tau, double value) {
+
+		  if (value < LS_EPS) value = 0;
+
+		  ev.setFL(i, t, tau, value);
+		  ev.setY(i, t, (ev.production(i, t) > LS_EPS) ? 1 : 0);
+	  }
+
+
+	  void Mark(int i, int t) {
+		  if (!dirty[inst.it(i, t)]) {
+			 dirty[inst.it(i, t)] = 1;
+			 dirtyList.push_back(inst.it(i, t));
+		  }
+	  }
+
+
+	  //Calculate again the flows of the marked items and periods
+	  void Flows() {
+
+		  RCLSPMSL_Flows f;
+		  std::vector<size_t> keys;
+
+		  for(size_t a = 0; a < dirtyList.size(); a++){
+			 int i = (int)(dirtyList[a] / inst.T), t = (int)(dirtyList[a] % inst.T), l, k, j, s;
+			 size_t p;
+			 dirty[dirtyList[a]] = 0;
+
+			 ComputeFlows(inst, sol, i, t, f);
+
+			 for(l=0; l<inst.L; l++){
+				ev.setDp(i, l, t, f.Dp[l]);
+				ev.setDm(i, l, t, f.Dm[l]);
+			 }
+
+			 keys.clear();
+			 for(std::map<size_t, double>::const_iterator it = sol.V.lower_bound(sol.vkey(i, 0, 0, t));
+				 (it != sol.V.end()) && (it->first < sol.vkey(i, 0, 0, t) + (size_t)inst.L*inst.L); ++it)
+				keys.push_back(it->first);
+
+			 for(p = 0; p < keys.size(); p++){
+				sol.vindex(keys[p], j, l, k, s);
+				ev.setV(i, l, k, t, 0);
+			 }
+
+			 for(p = 0; p < f.V.size(); p++)
+				ev.setV(i, f.V[p].first.first, f.V[p].first.second, t, f.V[p].second);
+		  }
+
+		  dirtyList.clear();
+	  }
+
+
+
+	  //Units of item i that can be added to location l in period t
+	  //(capacity, Big M and compatibilities with the items in l)
+	  double Space(int i, int l, int t) {
+
+		  size_t n = inst.ilt(i, l, t);
+
+		  if (sol.W[n] < 0.5) {
+			 if ((inst.alpha[inst.il(i, l)] < 0.5) || (inst.beta[inst.ij(i, i)] < 0.5))
+				return 0;
+
+			 for(int j=0; j<inst.I; j++)
+				if ((sol.W[inst.ilt(j, l, t)] > 0.5) && (inst.compat(i, j) < 0.5))
+				   return 0;
+		  }
+
+		  double free = ev.storageSlack(l, t) + ((sol.Z[inst.lt(l, t)] < 0.5) ? inst.H[l] : 0);
+
+		  double space = std::min(free/inst.cs[i], bigM[n] - sol.S[n]);
+		  return (space > LS_EPS) ? space : 0;
+	  }
+
+
+	  //Add q units of item i to the inventory in period t, first in the locations
+	  //of the item, then in the used locations and then in the closed locations
+	  bool AddInventory(int i, int t, double q, int avoid) {
+
+		  std::vector<std::pair<std::pair<int, double>, int> > order;
+
+		  for(int l=0; l<inst.L; l++){
+			 if (l == avoid) continue;
+
+			 int level;
+			 if (sol.W[inst.ilt(i, l, t)] > 0.5) level = 0;
+			   else if (((t > 0) && (sol.S[inst.ilt(i, l, t-1)] > 0)) ||
+						((t+1 < inst.T) && (sol.S[inst.ilt(i, l, t+1)] > 0))) level = 1;
+			   else if (sol.Z[inst.lt(l, t)] > 0.5) level = 2;
+			   else level = 3;
+
+			 order.push_back(std::make_pair(std::make_pair(level, inst.ha[inst.il(i, l)]), l));
+		  }
+
+		  std::sort(order.begin(), order.end());
+
+		  for(size_t a = 0; (a < order.size()) && (q > LS_EPS); a++){
+			 int l = order[a].second;
+			 double x = std::min(q, Space(i, l, t));
+
+			 if (x > 0) {
+				setS(i, l, t, sol.S[inst.ilt(i, l, t)] + x);
+				q -= x;
+			 }
+		  }
+
+		  return (q <= LS_EPS);
+	  }
+
+
+	  //Remove q units of item i from the inventory in period t,
+	  //first from the locations with less units of the item
+	  void RemoveInventory(int i, int t, double q) {
+
+		  std::vector<std::pair<double, int> > order;
+
+		  for(int l=0; l<inst.L; l++)
+			 if (sol.S[inst.ilt(i, l, t)] > 0)
+				order.push_back(std::make_pair(sol.S[inst.ilt(i, l, t)], l));
+
+		  std::sort(order.begin(), order.end());
+
+		  for(size_t a = 0; (a < order.size()) && (q > LS_EPS); a++){
+			 double x = std::min(q, order[a].first);
+			 setS(i, order[a].second, t, order[a].first - x);
+			 q -= x;
+		  }
+	  }
+
+
+
+	  //1. Move all the production of item i in period t to the previous setup
+	  bool MoveMerge(int i, int t) {
+
+		  int p, tau;
+		  for(p = t-1; (p >= 0) && (sol.Y[inst.it(i, p)] < 0.5); p--) ;
+		  if (p < 0) return false;
+
+		  double q = ev.production(i, t);
+		  if (inst.vt[i]*q > ev.capacitySlack(p) + LS_EPS) return false;
+
+		  double OF_before = ev.cost();
+
+		  for(tau = t; tau<inst.T; tau++){
+			 double x = sol.FL[inst.itt(i, t, tau)];
+			 if (x > 0) {
+				setFL(i, p, tau, sol.FL[inst.itt(i, p, tau)] + x);
+				setFL(i, t, tau, 0);
+			 }
+		  }
+
+		  for(int s = p; s < t; s++)
+			 if (!AddInventory(i, s, q, -1)) { undo(); return false; }
+
+		  return finish(OF_before);
+	  }
+
+
+	  //2. Move the production of item i in t for the demand in tau to the next
+	  //setup of the item before tau, or to tau when there is no such setup
+	  bool MoveSplit(int i, int t, int tau) {
+
+		  int p;
+		  for(p = t+1; (p < tau) && (sol.Y[inst.it(i, p)] < 0.5); p++) ;
+
+		  double q = sol.FL[inst.itt(i, t, tau)];
+		  if (inst.vt[i]*q > ev.capacitySlack(p) + LS_EPS) return false;
+
+		  double OF_before = ev.cost();
+
+		  setFL(i, p, tau, sol.FL[inst.itt(i, p, tau)] + q);
+		  setFL(i, t, tau, 0);
+
+		  for(int s = t; s < p; s++)
+			 RemoveInventory(i, s, q);
+
+		  return finish(OF_before);
+	  }
+
+
+	  //3. Move the inventory of item i from location l to location k
+	  //in the consecutive periods (from t) with inventory of i in l
+	  bool MoveReassign(int i, int l, int k, int t) {
+
+		  double OF_before = ev.cost();
+
+		  for(int s = t; (s < inst.T) && (sol.S[inst.ilt(i, l, s)] > 0); s++){
+			 double q = sol.S[inst.ilt(i, l, s)];
+
+			 if (Space(i, k, s) < q - LS_EPS) { undo(); return false; }
+
+			 setS(i, l, s, 0);
+			 setS(i, k, s, sol.S[inst.ilt(i, k, s)] + q);
+		  }
+
+		  return finish(OF_before);
+	  }
+
+
+	  //4. Move the items of location l in period t to other locations
+	  bool MoveClose(int l, int t) {
+
+		  double OF_before = ev.cost();
+
+		  for(int i=0; i<inst.I; i++){
+			 double q = sol.S[inst.ilt(i, l, t)];
+			 if (q > 0) {
+				setS(i, l, t, 0);
+				if (!AddInventory(i, t, q, l)) { undo(); return false; }
+			 }
+		  }
+
+		  return finish(OF_before);
+	  }
+
+
+	  //5. Move the items of the used location l to the closed location k in period t
+	  bool MoveSwap(int l, int k, int t) {
+
+		  double OF_before = ev.cost();
+
+		  for(int i=0; i<inst.I; i++){
+			 double q = sol.S[inst.ilt(i, l, t)];
+			 if (q > 0) {
+				if (Space(i, k, t) < q - LS_EPS) { undo(); return false; }
+
+				setS(i, l, t, 0);
+				setS(i, k, t, sol.S[inst.ilt(i, k, t)] + q);
+			 }
+		  }
+
+		  return finish(OF_before);
+	  }
+
+};
+
+
+
+
+//Local Search with one move stream in each thread; the solution
+//is replaced by the best solution found in the move streams
+inline RCLSPMSL_LSResult LocalSearch(const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, const RCLSPMSL_LSParams &par)
+{
+	  RCLSPMSL_TraceScope Trace_LS("Local search", "phase");
+	  RCLSPMSL_LSResult res;
+	  int s, nStreams = std::max(1, par.threads);
+
+	  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+
+	  //The first stream follows the order of the items, locations
+	  //and periods; the other streams follow a random order
+	  std::vector<std::unique_ptr<RCLSPMSL_LocalSearch> > streams;
+	  for(s=0; s<nStreams; s++)
+		 streams.push_back(std::unique_ptr<RCLSPMSL_LocalSearch>(
+			new RCLSPMSL_LocalSearch(inst, sol, (s == 0) ? 0 : par.seed + s)));
+
+	  //The streams start from the normalized solution (without the unused
+	  //setups and locations), and only their moves count as improvement
+	  res.OF_begin = streams[0]->cost();
+
+
+	  std::vector<std::thread> threads;
+	  for(s=1; s<nStreams; s++)
+		 threads.push_back(std::thread(&RCLSPMSL_LocalSearch::run, streams[s].get(), par.timeLimit));
+
+	  streams[0]->run(par.timeLimit);
+
+	  for(size_t a = 0; a < threads.size(); a++)
+		 threads[a].join();
+
+
+	  //Best solution of the move streams
+	  for(s=1; s<nStreams; s++)
+		 if (streams[s]->cost() < streams[res.Stream]->cost() - LS_EPS)
+			res.Stream = s;
+
+	  if (streams[res.Stream]->cost() < res.OF_begin - LS_EPS) {
+		 sol = streams[res.Stream]->solution();
+		 res.OF_end = ComputeCosts(inst, sol).OF;
+	  }
+		else res.OF_begin = res.OF_end = ComputeCosts(inst, sol).OF;
+	  res.Moves = streams[res.Stream]->moves();
+	  res.Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	  return res;
+}
+
+
+
+
+//Print the solution improved by the Local Search in the output file
+inline void PrintLocalSearch(std::ostream &out, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol,
+							 const RCLSPMSL_LSResult &res, double OF_LB)
+{
+	  out << std::endl << std::endl << std::endl << std::endl << std::endl;
+	  out << "************* Improved Solution: the Solution after the Local Search ***************" << std::endl;
+	  out << std::endl << std::endl;
+	  out << "Objective Function Value before LS = " << res.OF_begin << std::endl;
+	  out << "Objective Function Value = " << res.OF_end << std::endl;
+	  out << "Gap = " << 100*((res.OF_end - OF_LB)/res.OF_end) << std::endl;
+	  out << "Time LS = " << res.Time << std::endl;
+	  out << "Moves LS = " << res.Moves << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+	  out << std::endl << std::endl << std::endl;
+	  PrintCosts(out, ComputeCosts(inst, sol));
+	  out << std::endl << std::endl << std::endl << std::endl << std::endl;
+	  PrintSolution(out, inst, sol);
+}
+
+
+#endif
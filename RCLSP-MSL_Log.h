@@ -0,0 +1,255 @@
+// ************************************************************************************* //
+//        Log of the programs of the Facility Location Reformulation of the General      //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  The output and the warnings of the optimization package go to a log file of	 //
+//	  their own (option log=<file>, by default the output data file with .log),		 //
+//	  apart from the results in the output data file. The lines of the log are kept	 //
+//	  in a ring buffer and written by a thread in the background, so the solves of	 //
+//	  the windows do not wait for the disk. The option verbosity=<level> selects the	 //
+//	  lines of the log (0 - no log, 1 - warnings, 2 - also the solves, 3 - also the	 //
+//	  output of the optimization package)												 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_LOG_H
+#define RCLSPMSL_LOG_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+
+//Levels of the lines of the log
+enum {
+	  LOG_WARNING = 1,												  //warnings of the optimization package
+	  LOG_INFO = 2,													  //beginning of the solves of the programs
+	  LOG_SOLVER = 3												  //output of the optimization package
+};
+
+
+
+
+//Log of the run (one for each program, see Log())
+class RCLSPMSL_Log {
+
+	  //Stream buffer of a level: the characters are kept until the end
+	  //of the line, and the line goes to the ring buffer of the log
+	  class Buffer : public std::streambuf {
+
+		  RCLSPMSL_Log *log;
+		  std::string line;
+
+	  protected:
+
+		  int overflow(int c)
+		  {
+			  if (c == traits_type::eof()) return traits_type::not_eof(c);
+
+			  line += (char)c;
+			  if (c == '\n') log->push(line);
+			  return c;
+		  }
+
+		  std::streamsize xsputn(const char *s, std::streamsize n)
+		  {
+			  for(std::streamsize a = 0; a < n; a++){
+				 line += s[a];
+				 if (s[a] == '\n') log->push(line);
+			  }
+			  return n;
+		  }
+
+		  int sync()
+		  {
+			  if (!line.empty()) log->push(line);
+			  return 0;
+		  }
+
+	  public:
+
+		  Buffer() : log(0) {}
+		  void attach(RCLSPMSL_Log *l) { log = l; }
+
+	  };
+
+
+	  std::ofstream file;
+	  int verbosity;
+	  bool running, stop;
+
+	  Buffer buffers[LOG_SOLVER + 1];
+	  std::ostream *channels[LOG_SOLVER + 1];
+	  std::ostream none;											  //stream without buffer: the lines are discarded
+
+	  //Ring buffer of the lines not written yet
+	  std::vector<std::string> ring;
+	  size_t head, count;
+	  unsigned long long waits;										  //lines that waited for room in the ring buffer
+
+	  std::mutex lock;
+	  std::condition_variable filled, emptied;
+	  std::thread writer;
+
+
+	  //Add a line to the ring buffer (the line is left empty); if the ring
+	  //buffer is full the line waits until the writer makes room for it
+	  void push(std::string &line)
+	  {
+		  std::unique_lock<std::mutex> guard(lock);
+
+		  if (running && (count == ring.size())) {
+			 waits++;
+			 emptied.wait(guard, [this] { return (count < ring.size()) || !running; });
+		  }
+
+		  if (running) {
+			 ring[(head + count) % ring.size()].swap(line);
+			 count++;
+			 filled.notify_one();
+		  }
+
+		  line.clear();
+	  }
+
+
+	  //Thread of the writer: the lines of the ring buffer are written in
+	  //blocks, out of the lock; the file is flushed when the ring is empty
+	  void write()
+	  {
+		  std::vector<std::string> block;
+
+		  for(; ;){
+			 {
+				std::unique_lock<std::mutex> guard(lock);
+				filled.wait(guard, [this] { return (count > 0) || stop; });
+
+				if ((count == 0) && stop) break;
+
+				block.resize(count);
+				for(size_t a = 0; a < block.size(); a++){
+				   block[a].swap(ring[head]);
+				   head = (head + 1) % ring.size();
+				}
+				count = 0;
+				emptied.notify_all();
+			 }
+
+			 for(size_t a = 0; a < block.size(); a++)
+				file << block[a];
+
+			 std::lock_guard<std::mutex> guard(lock);
+			 if (count == 0) file.flush();
+		  }
+
+		  file.flush();
+	  }
+
+public:
+
+	  RCLSPMSL_Log() : verbosity(0), running(false), stop(false), none(0), head(0), count(0), waits(0)
+	  {
+		  for(int a = 0; a <= LOG_SOLVER; a++){
+			 buffers[a].attach(this);
+			 channels[a] = new std::ostream(&buffers[a]);
+		  }
+	  }
+
+	  //The lines not written yet are written when the program ends
+	  ~RCLSPMSL_Log()
+	  {
+		  close();
+		  for(int a = 0; a <= LOG_SOLVER; a++) delete channels[a];
+	  }
+
+
+	  //Open the log file with the verbosity and the size of the ring buffer (lines)
+	  //Return false if there is no log (verbosity 0) or the file could not be opened
+	  bool open(const std::string &name, int level, size_t lines = 4096)
+	  {
+		  close();
+
+		  verbosity = level;
+		  if ((verbosity <= 0) || name.empty()) return false;
+
+		  file.open(name.c_str());
+		  if (!file) return false;
+
+		  ring.assign((lines > 0) ? lines : 1, std::string());
+		  head = count = 0;
+		  stop = false;
+		  running = true;
+		  writer = std::thread(&RCLSPMSL_Log::write, this);
+		  return true;
+	  }
+
+
+	  //Write the lines left in the log file and stop the writer
+	  void close()
+	  {
+		  if (!running) return;
+
+		  for(int a = 0; a <= LOG_SOLVER; a++) channels[a]->flush();
+
+		  {
+			 std::lock_guard<std::mutex> guard(lock);
+			 stop = true;
+			 filled.notify_one();
+		  }
+
+		  writer.join();
+
+		  std::lock_guard<std::mutex> guard(lock);
+		  running = false;
+		  emptied.notify_all();
+		  file.close();
+	  }
+
+
+	  //Stream of the lines of a level (e.g. for setOut and setWarning
+	  //of the optimization package); the lines above the verbosity
+	  //are discarded
+	  std::ostream &channel(int level)
+	  {
+		  if (!running || (level < 1) || (level > verbosity) || (level > LOG_SOLVER)) return none;
+		  return *channels[level];
+	  }
+
+
+	  //Add a line of a level to the log
+	  void print(int level, const std::string &text)
+	  {
+		  if (!running || (level > verbosity)) return;
+
+		  std::string line = text + "\n";
+		  push(line);
+	  }
+
+
+	  unsigned long long getWaits()
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  return waits;
+	  }
+
+};
+
+
+
+
+//Log of the program
+inline RCLSPMSL_Log &Log()
+{
+	  static RCLSPMSL_Log log;
+	  return log;
+}
+
+
+#endif
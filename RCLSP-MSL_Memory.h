@@ -0,0 +1,234 @@
+// ************************************************************************************* //
+//      Memory of the programs of the Facility Location Reformulation of the General     //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  Resident memory of the process (current and peak) after each phase, number		 //
+//	  of objects and nonzeros of each family of variables and constraints, and an	 //
+//	  estimate of the peak memory of a run from T, I and L only (before the model		 //
+//	  is built), to place the runs in machines with enough memory					 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_MEMORY_H
+#define RCLSPMSL_MEMORY_H
+
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+
+//Resident memory of the process: current and peak (bytes, 0 if unknown)
+inline size_t CurrentRSS()
+{
+#ifdef _WIN32
+	  PROCESS_MEMORY_COUNTERS pmc;
+	  return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)) ? (size_t)pmc.WorkingSetSize : 0;
+#else
+	  std::ifstream in("/proc/self/status");
+	  std::string key;
+	  size_t kb;
+
+	  while (in >> key)
+		 if (key == "VmRSS:") return (in >> kb) ? kb*1024 : 0;
+
+	  return 0;
+#endif
+}
+
+inline size_t PeakRSS()
+{
+#ifdef _WIN32
+	  PROCESS_MEMORY_COUNTERS pmc;
+	  return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)) ? (size_t)pmc.PeakWorkingSetSize : 0;
+#else
+	  struct rusage usage;
+	  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+	  return (size_t)usage.ru_maxrss;								  //bytes
+#else
+	  return (size_t)usage.ru_maxrss*1024;							  //kilobytes
+#endif
+#endif
+}
+
+
+
+
+//Memory of the process at the end of a phase
+struct RCLSPMSL_PhaseMemory {
+
+	  std::string phase;
+	  size_t rss, peak;
+
+};
+
+
+
+
+//Number of objects (variables or constraints) and nonzeros of a family
+struct RCLSPMSL_FamilySize {
+
+	  std::string name;
+	  bool variables;
+	  long long objects, nonzeros;
+
+};
+
+
+//Families of the Facility Location Reformulation (the same columns,
+//rows and nonzeros as RCLSP-MSL_Sparse.h)
+inline std::vector<RCLSPMSL_FamilySize> FamilySizes(long long T, long long I, long long L)
+{
+	  long long TT = T*(T+1)/2;
+
+	  RCLSPMSL_FamilySize f[] = {
+		  { "Y", true, I*T, 0 },
+		  { "S", true, I*L*T, 0 },
+		  { "Z", true, L*T, 0 },
+		  { "Dp", true, I*L*T, 0 },
+		  { "Dm", true, I*L*T, 0 },
+		  { "W", true, I*L*T, 0 },
+		  { "V", true, I*L*(L-1)*T, 0 },
+		  { "FL", true, I*TT, 0 },
+		  { "InflowOutFlow1", false, I*T, I*TT },
+		  { "InflowOutFlow2", false, I*T, I*TT + 2*I*L*T },
+		  { "BalanceLocation", false, I*L*T, I*L*(T-1) + 3*I*L*T + 2*I*L*(L-1)*T },
+		  { "Setup", false, I*TT, 2*I*TT },
+		  { "Capacity", false, T, I*TT },
+		  { "InvAlloc", false, I*L*T, 2*I*L*T },
+		  { "CapacityStorage", false, L*T, (I+1)*L*T },
+		  { "ItemLocatCompat", false, I*L*T, I*L*T },
+		  { "ItemItemCompat", false, I*(I+1)/2*L*T, I*I*L*T } };
+
+	  return std::vector<RCLSPMSL_FamilySize>(f, f + sizeof(f)/sizeof(f[0]));
+}
+
+
+
+
+//Bytes of each object of the models, to estimate the peak memory
+//(approximate values: Concert objects with their names, the copy of
+//the optimization package, and the compressed sparse rows)
+struct RCLSPMSL_MemoryModel {
+
+	  double base;													  //process, libraries and instance
+	  double concertVar, concertRow, concertNz;					  //Concert objects and expressions
+	  double solverCol, solverRow, solverNz;						  //copy of the model in the optimization package
+	  double csrCol, csrRow, csrNz;									  //columns and compressed sparse rows
+
+	  RCLSPMSL_MemoryModel() : base(64e6), concertVar(220), concertRow(260), concertNz(48),
+							   solverCol(120), solverRow(120), solverNz(24), csrCol(25), csrRow(13), csrNz(12) {}
+
+};
+
+
+//Estimated peak memory (bytes) of a run with the Concert model (the
+//main programs) and with the compressed sparse rows (Callable Library)
+inline double EstimateConcertMemory(long long T, long long I, long long L,
+									const RCLSPMSL_MemoryModel &m = RCLSPMSL_MemoryModel())
+{
+	  std::vector<RCLSPMSL_FamilySize> f = FamilySizes(T, I, L);
+	  double bytes = m.base;
+
+	  for(size_t a = 0; a < f.size(); a++)
+		 if (f[a].variables) bytes += f[a].objects*(m.concertVar + m.solverCol);
+		   else bytes += f[a].objects*(m.concertRow + m.solverRow) + f[a].nonzeros*(m.concertNz + m.solverNz);
+
+	  return bytes;
+}
+
+inline double EstimateSparseMemory(long long T, long long I, long long L,
+								   const RCLSPMSL_MemoryModel &m = RCLSPMSL_MemoryModel())
+{
+	  std::vector<RCLSPMSL_FamilySize> f = FamilySizes(T, I, L);
+	  double bytes = m.base;
+
+	  for(size_t a = 0; a < f.size(); a++)
+		 if (f[a].variables) bytes += f[a].objects*(m.csrCol + m.solverCol);
+		   else bytes += f[a].objects*(m.csrRow + m.solverRow) + f[a].nonzeros*(m.csrNz + m.solverNz);
+
+	  return bytes;
+}
+
+
+
+
+//Print the number of objects and nonzeros of the families
+//(created: variables V created by the model, -1 if not known)
+inline void PrintFamilies(std::ostream &out, const std::vector<RCLSPMSL_FamilySize> &f, long long created = -1)
+{
+	  long long objects[2] = { 0, 0 }, nonzeros = 0;
+
+	  out << std::setw(26) << std::left << "Family" << std::right << std::setw(16) << "Objects" << std::setw(16) << "Nonzeros" << std::endl;
+
+	  for(size_t a = 0; a < f.size(); a++){
+		 long long n = ((f[a].name == "V") && (created >= 0)) ? created : f[a].objects;
+
+		 out << std::setw(26) << std::left << (std::string((f[a].variables) ? "Variables " : "Constraints ") + f[a].name)
+			 << std::right << std::setw(16) << n;
+		 if (f[a].variables) out << std::endl;
+		   else out << std::setw(16) << f[a].nonzeros << std::endl;
+
+		 objects[(f[a].variables) ? 0 : 1] += n;
+		 if (!f[a].variables) nonzeros += f[a].nonzeros;
+	  }
+
+	  out << std::endl;
+	  out << "Variables = " << objects[0] << std::endl;
+	  out << "Constraints = " << objects[1] << std::endl;
+	  out << "Nonzeros = " << nonzeros << std::endl;
+}
+
+
+
+
+//Print the resident memory at the end of the phases
+inline void PrintPhases(std::ostream &out, const std::vector<RCLSPMSL_PhaseMemory> &phases)
+{
+	  char line[160];
+
+	  out << std::setw(40) << std::left << "Phase" << std::right << std::setw(14) << "RSS (MB)" << std::setw(16) << "Peak RSS (MB)" << std::endl;
+	  for(size_t a = 0; a < phases.size(); a++){
+		 sprintf(line, "%-40.40s%14.1f%16.1f", phases[a].phase.c_str(), phases[a].rss/1048576.0, phases[a].peak/1048576.0);
+		 out << line << std::endl;
+	  }
+
+	  out << std::endl;
+	  out << "Peak RSS (MB) = " << PeakRSS()/1048576.0 << std::endl;
+}
+
+
+
+
+//Print the memory of the phases of the run, the families of the model
+//and the estimated peak memory of the run (see EstimateConcertMemory)
+inline void PrintMemory(std::ostream &out, const std::vector<RCLSPMSL_PhaseMemory> &phases, int T, int I, int L,
+						long long created = -1)
+{
+	  out << "************************************** Memory ***************************************" << std::endl;
+	  out << std::endl << std::endl;
+	  PrintPhases(out, phases);
+	  out << std::endl << std::endl;
+	  PrintFamilies(out, FamilySizes(T, I, L), created);
+
+	  out << std::endl;
+	  out << "Estimated Peak Memory (MB) = " << EstimateConcertMemory(T, I, L)/1048576.0 << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+}
+
+
+#endif
@@ -0,0 +1,76 @@
+// ************************************************************************************* //
+//      Options of the programs to solve the Facility Location Reformulation of the      //
+//             General Capacitated Lot-Sizing Problem with Multiple Storage              //
+//                             Locations (RCLSP-MSL)                                     //
+//	 																					 //
+//	  Options are given in the command line after the input and output files,		 //
+//	  in the form name=value, e.g.:  RFH data.dat results.dat decomposition=item	 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_OPTIONS_H
+#define RCLSPMSL_OPTIONS_H
+
+
+#include <map>
+#include <string>
+#include <cstdlib>
+
+
+
+class RCLSPMSL_Options {
+
+public:
+
+	  //Read the options name=value from argv[first] to argv[argc-1]
+	  //Arguments without the symbol '=' are ignored
+	  RCLSPMSL_Options(int argc, char **argv, int first) {
+
+		  for(int a = first; a < argc; a++){
+			 std::string arg(argv[a]);
+			 std::string::size_type eq = arg.find('=');
+
+			 if (eq != std::string::npos)
+				values[arg.substr(0, eq)] = arg.substr(eq + 1);
+		  }
+	  }
+
+
+	  //Check if the option was given
+	  bool has(const std::string &name) const {
+		  return (values.find(name) != values.end());
+	  }
+
+
+	  //Recover the value of the option, or the default
+	  //value (def) if the option was not given
+	  std::string getString(const std::string &name, const std::string &def) const {
+		  std::map<std::string, std::string>::const_iterator it = values.find(name);
+		  return (it != values.end()) ? it->second : def;
+	  }
+
+	  int getInt(const std::string &name, int def) const {
+		  std::map<std::string, std::string>::const_iterator it = values.find(name);
+		  return (it != values.end()) ? atoi(it->second.c_str()) : def;
+	  }
+
+	  double getNum(const std::string &name, double def) const {
+		  std::map<std::string, std::string>::const_iterator it = values.find(name);
+		  return (it != values.end()) ? atof(it->second.c_str()) : def;
+	  }
+
+
+	  //Set (or overwrite) the value of an option
+	  void set(const std::string &name, const std::string &value) {
+		  values[name] = value;
+	  }
+
+
+private:
+
+	  std::map<std::string, std::string> values;
+
+};
+
+
+#endif
@@ -0,0 +1,299 @@
+// ************************************************************************************* //
+//       Results of the runs of the programs of the Facility Location Reformulation      //
+//    of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations      //
+//                                     (RCLSP-MSL)                                       //
+//	 																					 //
+//	  Each run adds one record (a line of JSON) to the results file (option			 //
+//	  results=<file>, by default the output data file with .json): status, objective	 //
+//	  function value, bound, gap, time, time of the first incumbent and of the		 //
+//	  target gap, costs of the solution, validation, time of the phases and peak		 //
+//	  memory. With the option solution=<file> the nonzero variables of the final		 //
+//	  solution are written in columns (CSV), one line for each variable: family,		 //
+//	  indexes (from 1, empty if not used) and value, and with the option				 //
+//	  archive=<file> in a binary archive (RCLSP-MSL_Archive.h)						 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_RESULTS_H
+#define RCLSPMSL_RESULTS_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Json.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Memory.h"
+#include "RCLSP-MSL_Archive.h"
+#include "RCLSP-MSL_Timeline.h"
+
+
+
+//Write the nonzero variables of the solution in columns (CSV):
+//family,i,l,k,t,tau,value (indexes from 1, empty if not used)
+inline void WriteSolutionColumns(std::ostream &out, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol)
+{
+	  int t, i, l, k, tau;
+	  char line[160];
+
+	  out << "family,i,l,k,t,tau,value" << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(i=0; i<inst.I; i++)
+			if (sol.Y[inst.it(i, t)] > 0.00001) {
+			   sprintf(line, "Y,%d,,,%d,,%.10g", i+1, t+1, sol.Y[inst.it(i, t)]);
+			   out << line << std::endl;
+			}
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			if (sol.Z[inst.lt(l, t)] > 0.00001) {
+			   sprintf(line, "Z,,%d,,%d,,%.10g", l+1, t+1, sol.Z[inst.lt(l, t)]);
+			   out << line << std::endl;
+			}
+
+	  const char *names[] = { "S", "W", "Dp", "Dm" };
+	  const std::vector<double> *values[] = { &sol.S, &sol.W, &sol.Dp, &sol.Dm };
+
+	  for(int f = 0; f < 4; f++)
+		 for(t=0; t<inst.T; t++)
+			for(l=0; l<inst.L; l++)
+			   for(i=0; i<inst.I; i++)
+				  if ((*values[f])[inst.ilt(i, l, t)] > 0.00001) {
+					 sprintf(line, "%s,%d,%d,,%d,,%.10g", names[f], i+1, l+1, t+1, (*values[f])[inst.ilt(i, l, t)]);
+					 out << line << std::endl;
+				  }
+
+	  //Only the nonzero relocations are stored in the solution
+	  for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+		 sol.vindex(it->first, i, l, k, t);
+
+		 if ((l != k) && (it->second > 0.00001)) {
+			sprintf(line, "V,%d,%d,%d,%d,,%.10g", i+1, l+1, k+1, t+1, it->second);
+			out << line << std::endl;
+		 }
+	  }
+
+	  for(t=0; t<inst.T; t++)
+		 for(tau = t; tau<inst.T; tau++)
+			for(i=0; i<inst.I; i++)
+			   if (sol.FL[inst.itt(i, t, tau)] > 0.00001) {
+				  sprintf(line, "FL,%d,,,%d,%d,%.10g", i+1, t+1, tau+1, sol.FL[inst.itt(i, t, tau)]);
+				  out << line << std::endl;
+			   }
+}
+
+
+
+
+//Record of the run (one for each program, see Results())
+class RCLSPMSL_Results {
+
+	  std::string file, solutionFile, archiveFile, program, instance;
+	  bool written;
+	  int scenario;													  //scenario of the record (-1: none)
+
+	  int T, I, L;
+	  std::string status;											  //status of the final solution
+	  bool solved, feasible;
+	  double OF, bound, gap, time;
+	  RCLSPMSL_Costs costs;
+
+	  RCLSPMSL_Instance inst;										  //instance and final solution for the solution and archive files
+	  RCLSPMSL_Solution sol;
+
+
+	  //Write a member of the record
+	  static void member(std::ostream &out, const char *name, double value)
+	  {
+		  out << ",\"" << name << "\":";
+		  WriteJsonNumber(out, value);
+	  }
+
+public:
+
+	  RCLSPMSL_Results() : written(false), scenario(-1), T(0), I(0), L(0), status("NoSolution"), solved(false), feasible(false),
+						   OF(0), bound(0), gap(0), time(0) {}
+
+	  //The record is written when the program ends, if it was not written before
+	  ~RCLSPMSL_Results() { write(); }
+
+
+	  //Open the record of the run of the program on the input data file (no
+	  //record if file is empty, no solution file if solution is empty)
+	  void open(const std::string &name, const std::string &solution, const std::string &prog, const std::string &input)
+	  {
+		  file = name;
+		  solutionFile = solution;
+		  program = prog;
+		  instance = input;
+		  written = false;
+		  scenario = -1;
+		  status = "NoSolution";
+		  solved = false;
+	  }
+
+
+	  //Binary archive of the final solution (no archive if file is empty)
+	  void setArchive(const std::string &name) { archiveFile = name; }
+
+
+	  //Scenario of the record (the programs with a record for each scenario)
+	  void setScenario(int s) { scenario = s; }
+
+
+	  //Size of the instance (the runs without solution)
+	  void size(int t, int i, int l) { T = t; I = i; L = l; }
+
+
+	  //Values of the final solution: status, costs, validation, bound (best
+	  //lower bound or LR, NAN if there is none) and time of the method; the
+	  //gap is 100*(OF - bound)/OF, as in the output files
+	  void values(const std::string &stat, const RCLSPMSL_Costs &c, bool valid, double LB, double Time)
+	  {
+		  status = stat;
+		  solved = true;
+		  costs = c;
+		  feasible = valid;
+		  OF = costs.OF;
+		  bound = LB;
+		  gap = (OF != 0) ? 100*((OF - bound)/OF) : 0;
+		  time = Time;
+	  }
+
+
+	  //Final solution of the run (the costs are calculated and the
+	  //solution validated with the tolerance), kept for the solution and archive files
+	  void solution(const std::string &stat, const RCLSPMSL_Instance &in, const RCLSPMSL_Solution &s, double LB, double Time,
+					double tol = 1e-5)
+	  {
+		  size(in.T, in.I, in.L);
+		  values(stat, ComputeCosts(in, s), Validate(in, s, tol).feasible(), LB, Time);
+
+		  if (!solutionFile.empty() || !archiveFile.empty()) {
+			 inst = in;
+			 sol = s;
+		  }
+	  }
+
+
+	  //Runs without a final solution: status and bound
+	  void noSolution(const std::string &stat, double LB)
+	  {
+		  status = stat;
+		  solved = false;
+		  bound = LB;
+	  }
+
+
+	  //Write the record (a line added to the results file), the solution file and the archive
+	  //Return false if there is no record or the file could not be written
+	  bool write()
+	  {
+		  if (file.empty() || written) return false;
+		  written = true;
+
+		  if (solved && !solutionFile.empty()) {
+			 std::ofstream outsol(solutionFile.c_str());
+			 WriteSolutionColumns(outsol, inst, sol);
+		  }
+
+		  if (solved && !archiveFile.empty()) SaveSolutionArchive(archiveFile, sol, OF);
+
+		  //The record is written at once, in a line of its own
+		  std::ostringstream out;
+
+		  out << "{\"program\":";
+		  WriteJsonString(out, program);
+		  out << ",\"instance\":";
+		  WriteJsonString(out, instance);
+		  member(out, "T", T);
+		  member(out, "I", I);
+		  member(out, "L", L);
+		  if (scenario >= 0) member(out, "scenario", scenario);
+		  out << ",\"status\":";
+		  WriteJsonString(out, status);
+		  out << ",\"solved\":" << ((solved) ? "true" : "false");
+
+		  if (solved) {
+			 out << ",\"feasible\":" << ((feasible) ? "true" : "false");
+			 member(out, "OF", OF);
+			 member(out, "bound", bound);
+			 member(out, "gap", gap);
+			 member(out, "time", time);
+
+			 //First incumbent of the solves of the MIPs and first solve at the
+			 //target gap (see RCLSP-MSL_Timeline.h)
+			 std::vector<RCLSPMSL_TimelineSolve> solves = Timeline().getSolves();
+			 double incumbent = TimeToFirstIncumbent(solves), target = TimeToTarget(solves, Timeline().getTarget());
+			 if (incumbent >= 0) member(out, "first_incumbent", incumbent);
+			 if (target >= 0) member(out, "time_to_target", target);
+
+
+			 out << ",\"costs\":{\"production\":";
+			 WriteJsonNumber(out, costs.CProdItem);
+			 member(out, "setup", costs.CSetupItem);
+			 member(out, "inventory", costs.CInventItem);
+			 member(out, "handling", costs.CHandItem);
+			 member(out, "location", costs.CSetupLocal);
+			 member(out, "relocation", costs.CRelocItem);
+			 out << "},\"counts\":{\"setups\":";
+			 WriteJsonNumber(out, costs.NSetupItem);
+			 member(out, "inventoried", costs.NInventItem);
+			 member(out, "handled", costs.NHandItem);
+			 member(out, "locations", costs.NLocalUsed);
+			 member(out, "relocated", costs.NRelocItem);
+			 out << "},\"space\":{\"open\":";
+			 WriteJsonNumber(out, costs.TotalOpenSpace);
+			 member(out, "used", costs.TotalUsedSpace);
+			 member(out, "percentage", costs.PercUsedSpace);
+			 out << "}";
+		  }
+			else member(out, "bound", bound);
+
+		  //Time of the steps of the run (see RCLSP-MSL_Trace.h)
+		  std::vector<RCLSPMSL_PhaseTime> times = Trace().phaseTimes();
+		  bool first = true;
+
+		  out << ",\"phases\":{";
+		  for(size_t a = 0; a < times.size(); a++)
+			 if (times[a].track == "Run") {
+				if (!first) out << ",";
+				WriteJsonString(out, times[a].phase);
+				out << ":";
+				WriteJsonNumber(out, times[a].time);
+				first = false;
+			 }
+		  out << "}";
+
+		  member(out, "peak_rss_mb", PeakRSS()/1048576.0);
+		  out << "}" << std::endl;
+
+		  std::ofstream outrec(file.c_str(), std::ios::app);
+		  outrec << out.str();
+		  outrec.flush();
+
+		  return (bool)outrec;
+	  }
+
+};
+
+
+
+
+//Record of the run of the program
+inline RCLSPMSL_Results &Results()
+{
+	  static RCLSPMSL_Results results;
+	  return results;
+}
+
+
+#endif
@@ -0,0 +1,258 @@
+// ************************************************************************************* //
+//      Cache of the runs of the Facility Location Reformulation of the General          //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  For each instance (hash of all its data, in the file <hash>.run of the cache	 //
+//	  directory) the programs keep the bound and the basis of the linear relaxation	 //
+//	  and the best solution found by any of them. A new run of the instance does	 //
+//	  not solve the linear relaxation again, and the best known solution is used	 //
+//	  as its MIP start																 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_RUNCACHE_H
+#define RCLSPMSL_RUNCACHE_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Cache.h"
+#include "RCLSP-MSL_Archive.h"
+
+
+
+//Identification and version of the files of the runs
+const char RUNCACHE_MAGIC[8] = { 'R', 'C', 'L', 'S', 'P', 'R', 'U', 'N' };
+const int RUNCACHE_VERSION = 2;
+
+
+
+
+//Data of the runs of an instance
+struct RCLSPMSL_RunCache {
+
+	  //Linear relaxation: bound (hasLR) and basis statuses of the variables
+	  //and of the constraints (empty if the LR was solved apart, without a basis)
+	  bool hasLR;
+	  double OF_LR;
+	  std::vector<int> colStatus, rowStatus;
+
+	  //Best known solution and the program that found it
+	  bool hasIncumbent;
+	  double OF_Incumbent;
+	  std::string source;
+	  RCLSPMSL_Solution incumbent;
+
+
+	  RCLSPMSL_RunCache() : hasLR(false), OF_LR(0), hasIncumbent(false), OF_Incumbent(0) {}
+
+	  bool hasBasis() const { return hasLR && !colStatus.empty(); }
+
+};
+
+
+
+
+//Hash of all the data of the instance (the structure and the demand)
+inline unsigned long long InstanceHash(const RCLSPMSL_Instance &inst)
+{
+	  unsigned long long h = StructureHash(inst);
+
+	  HashVector(h, inst.d);
+
+	  return h;
+}
+
+
+
+
+//Write and read all the variables of a solution in a binary file (only
+//the nonzero variables, see RCLSP-MSL_Archive.h)
+inline void WriteSolutionBinary(std::ostream &out, const RCLSPMSL_Solution &sol)
+{
+	  WriteSolutionArchive(out, sol, 0);
+}
+
+inline bool ReadSolutionBinary(std::istream &in, const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol)
+{
+	  double OF = 0;
+
+	  return ReadSolutionArchive(in, inst, sol, OF);
+}
+
+
+
+
+//File of the runs of the instance in the cache directory
+inline std::string RunCacheFile(const std::string &dir, const RCLSPMSL_Instance &inst)
+{
+	  char name[40];
+	  sprintf(name, "%016llx.run", InstanceHash(inst));
+
+	  return dir + "/" + name;
+}
+
+
+
+
+//Load the runs of the instance from the cache directory
+//Return false if there is no cache (dir is empty) or no file of the instance
+inline bool LoadRunCache(const std::string &dir, const RCLSPMSL_Instance &inst, RCLSPMSL_RunCache &cache)
+{
+	  cache = RCLSPMSL_RunCache();
+	  if (dir.empty()) return false;
+
+	  std::ifstream in(RunCacheFile(dir, inst).c_str(), std::ios::binary);
+	  if (!in) return false;
+
+	  char magic[sizeof(RUNCACHE_MAGIC)];
+	  int version = 0;
+	  unsigned long long hash = 0;
+
+	  in.read(magic, sizeof(magic));
+	  in.read((char *)&version, sizeof(version));
+	  in.read((char *)&hash, sizeof(hash));
+
+	  if (!in || memcmp(magic, RUNCACHE_MAGIC, sizeof(magic)) || (version != RUNCACHE_VERSION) ||
+		  (hash != InstanceHash(inst))) return false;
+
+	  RCLSPMSL_RunCache c;
+	  std::vector<char> source;
+
+	  in.read((char *)&c.hasLR, sizeof(c.hasLR));
+	  in.read((char *)&c.OF_LR, sizeof(c.OF_LR));
+	  in.read((char *)&c.hasIncumbent, sizeof(c.hasIncumbent));
+	  in.read((char *)&c.OF_Incumbent, sizeof(c.OF_Incumbent));
+
+	  if (!ReadVector(in, c.colStatus) || !ReadVector(in, c.rowStatus) || !ReadVector(in, source) ||
+		  !ReadSolutionBinary(in, inst, c.incumbent)) return false;
+
+	  c.source.assign(source.begin(), source.end());
+
+	  cache = c;
+	  return true;
+}
+
+
+
+
+//Save the runs of the instance in the cache directory (the file is
+//written apart and renamed, then a run that reads the cache at the
+//same time sees the old file or the new one)
+//Return false if there is no cache (dir is empty) or the file could not be written
+inline bool SaveRunCache(const std::string &dir, const RCLSPMSL_Instance &inst, const RCLSPMSL_RunCache &cache)
+{
+	  if (dir.empty()) return false;
+
+	  std::string file = RunCacheFile(dir, inst), temp = file + ".tmp";
+	  std::ofstream out(temp.c_str(), std::ios::binary);
+	  if (!out) return false;
+
+	  unsigned long long hash = InstanceHash(inst);
+	  std::vector<char> source(cache.source.begin(), cache.source.end());
+
+	  out.write(RUNCACHE_MAGIC, sizeof(RUNCACHE_MAGIC));
+	  out.write((const char *)&RUNCACHE_VERSION, sizeof(RUNCACHE_VERSION));
+	  out.write((const char *)&hash, sizeof(hash));
+	  out.write((const char *)&cache.hasLR, sizeof(cache.hasLR));
+	  out.write((const char *)&cache.OF_LR, sizeof(cache.OF_LR));
+	  out.write((const char *)&cache.hasIncumbent, sizeof(cache.hasIncumbent));
+	  out.write((const char *)&cache.OF_Incumbent, sizeof(cache.OF_Incumbent));
+
+	  WriteVector(out, cache.colStatus); WriteVector(out, cache.rowStatus); WriteVector(out, source);
+	  WriteSolutionBinary(out, cache.incumbent);
+
+	  out.close();
+	  if (!out) return false;
+
+	  return ReplaceFile(temp, file);
+}
+
+
+
+
+//Keep the bound of the LR of the instance in the cache directory, with the
+//basis statuses if they are given (a bound without a basis keeps the basis
+//already in the cache, if it is of the same bound)
+//Return true if the bound was saved
+inline bool UpdateLR(const std::string &dir, const RCLSPMSL_Instance &inst, double OF_LR,
+					 const std::vector<int> &colStatus = std::vector<int>(),
+					 const std::vector<int> &rowStatus = std::vector<int>())
+{
+	  if (dir.empty()) return false;
+
+	  RCLSPMSL_RunCache cache;
+	  LoadRunCache(dir, inst, cache);
+
+	  if (!colStatus.empty() || !cache.hasLR || (fabs(cache.OF_LR - OF_LR) > 1e-6*std::max(1.0, fabs(OF_LR)))) {
+		 cache.colStatus = colStatus;
+		 cache.rowStatus = rowStatus;
+	  }
+
+	  cache.hasLR = true;
+	  cache.OF_LR = OF_LR;
+
+	  return SaveRunCache(dir, inst, cache);
+}
+
+
+
+
+//Keep the solution as the best known solution of the instance, if it
+//is feasible (validator) and better than the one in the cache directory
+//Return true if the solution was saved
+inline bool UpdateIncumbent(const std::string &dir, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol,
+							const std::string &source)
+{
+	  if (dir.empty() || !Validate(inst, sol).feasible()) return false;
+
+	  RCLSPMSL_RunCache cache;
+	  LoadRunCache(dir, inst, cache);
+
+	  double OF = ComputeCosts(inst, sol).OF;
+	  if (cache.hasIncumbent && (cache.OF_Incumbent <= OF)) return false;
+
+	  cache.hasIncumbent = true;
+	  cache.OF_Incumbent = OF;
+	  cache.source = source;
+	  cache.incumbent = sol;
+
+	  return SaveRunCache(dir, inst, cache);
+}
+
+
+
+
+//Replace the initial solution of the program (Constructive Heuristic)
+//by the best known solution of the cache, if it is better, and print it
+//Return true if the initial solution was replaced
+inline bool UseIncumbent(std::ostream &out, const RCLSPMSL_Instance &inst, const RCLSPMSL_RunCache &cache,
+						 RCLSPMSL_Solution &sol, bool &found)
+{
+	  if (!cache.hasIncumbent) return false;
+	  if (found && (ComputeCosts(inst, sol).OF <= cache.OF_Incumbent)) return false;
+
+	  sol = cache.incumbent;
+	  found = true;
+
+	  out << "********** Initial Solution: Best Known Solution in the Cache of the Runs ***********" << std::endl;
+	  out << std::endl << std::endl;
+	  out << "Objective Function Value = " << cache.OF_Incumbent << std::endl;
+	  out << "Found by = " << cache.source << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+	  out << std::endl << std::endl << std::endl << std::endl << std::endl;
+
+	  return true;
+}
+
+
+#endif
@@ -0,0 +1,310 @@
+// ************************************************************************************* //
+//        Solution of the Facility Location Reformulation of the General Capacitated     //
+//             Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)            //
+//	 																					 //
+//	  Plain C++ representation of the decision variables, with the costs and the	 //
+//	  printing in the same layout of the output files of the programs				 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_SOLUTION_H
+#define RCLSPMSL_SOLUTION_H
+
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "RCLSP-MSL_Instance.h"
+
+
+
+struct RCLSPMSL_Solution {
+
+	  int T, I, L;
+
+	  std::vector<double> Y;										  //setup of item i in period t [I*T]
+	  std::vector<double> Z;										  //use of location l in period t [L*T]
+	  std::vector<double> S;										  //inventory of item i at location l in period t [I*L*T]
+	  std::vector<double> Dp;										  //inflow of item i at location l in period t [I*L*T]
+	  std::vector<double> Dm;										  //outflow of item i at location l in period t [I*L*T]
+	  std::vector<double> W;										  //assignment of item i to location l in period t [I*L*T]
+	  std::vector<double> FL;										  //units of item i produced in t for the demand in tau [I*T*T]
+
+	  //Relocation of item i from location l to location k in period t
+	  //Only the nonzero values are stored, with the key vkey(i,l,k,t)
+	  //ordered by item, period, origin and destination
+	  std::map<size_t, double> V;
+
+
+
+	  RCLSPMSL_Solution() : T(0), I(0), L(0) {}
+
+
+
+	  //Allocate the variables for the instance, all equal to zero
+	  void resize(const RCLSPMSL_Instance &inst) {
+
+		  T = inst.T; I = inst.I; L = inst.L;
+
+		  Y.assign((size_t)I*T, 0);
+		  Z.assign((size_t)L*T, 0);
+		  S.assign((size_t)I*L*T, 0);
+		  Dp.assign((size_t)I*L*T, 0);
+		  Dm.assign((size_t)I*L*T, 0);
+		  W.assign((size_t)I*L*T, 0);
+		  FL.assign((size_t)I*T*T, 0);
+		  V.clear();
+	  }
+
+
+
+	  //Key of the relocation variables
+	  inline size_t vkey(int i, int l, int k, int t) const { return (((size_t)i*T + t)*L + l)*L + k; }
+
+	  inline void vindex(size_t key, int &i, int &l, int &k, int &t) const {
+		  k = (int)(key % L); key /= L;
+		  l = (int)(key % L); key /= L;
+		  t = (int)(key % T); key /= T;
+		  i = (int)key;
+	  }
+
+	  inline double getV(int i, int l, int k, int t) const {
+		  std::map<size_t, double>::const_iterator it = V.find(vkey(i, l, k, t));
+		  return (it != V.end()) ? it->second : 0;
+	  }
+
+	  inline void setV(int i, int l, int k, int t, double value) {
+		  if (value != 0) V[vkey(i, l, k, t)] = value;
+		    else V.erase(vkey(i, l, k, t));
+	  }
+
+	  //Relocations of item i in period t: keys from vkey(i,0,0,t) to vkey(i,L-1,L-1,t)
+	  inline std::map<size_t, double>::iterator vbegin(int i, int t) { return V.lower_bound(vkey(i, 0, 0, t)); }
+	  inline std::map<size_t, double>::iterator vend(int i, int t) { return V.lower_bound(vkey(i, 0, 0, t) + (size_t)L*L); }
+
+	  inline void clearV(int i, int t) { V.erase(vbegin(i, t), vend(i, t)); }
+
+};
+
+
+
+
+//Cost and other values of a solution, as
+//calculated at the end of the programs
+struct RCLSPMSL_Costs {
+
+	  double CProdItem, CSetupItem, CInventItem, CHandItem, CSetupLocal, CRelocItem,
+
+			 NSetupItem, NInventItem, NHandItem, NLocalUsed, NRelocItem,
+
+			 TotalOpenSpace, TotalUsedSpace, PercUsedSpace,
+
+			 OF;
+
+	  RCLSPMSL_Costs() : CProdItem(0), CSetupItem(0), CInventItem(0), CHandItem(0), CSetupLocal(0), CRelocItem(0),
+						 NSetupItem(0), NInventItem(0), NHandItem(0), NLocalUsed(0), NRelocItem(0),
+						 TotalOpenSpace(0), TotalUsedSpace(0), PercUsedSpace(0), OF(0) {}
+
+};
+
+
+
+
+//Calculate the costs of the solution (objective function and other values)
+inline RCLSPMSL_Costs ComputeCosts(const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol)
+{
+	  RCLSPMSL_Costs c;
+	  int t, i, l, k, tau;
+	  size_t n;
+
+
+	  //Costs of production
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++)
+			for(tau = t; tau<inst.T; tau++)
+			   c.CProdItem += inst.vc[i]*sol.FL[inst.itt(i, t, tau)];
+
+
+	  //Cost and number of setups
+	  //in the production of items
+	  for(n=0; n<sol.Y.size(); n++)
+		 if (sol.Y[n] > 0.00001) {
+			c.CSetupItem += inst.sc[n/inst.T]*sol.Y[n];
+			c.NSetupItem += sol.Y[n];
+		 }
+
+
+	  //Inventory, handling and used space of items
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   n = inst.ilt(i, l, t);
+
+			   if (sol.S[n] > 0.00001) {
+				  c.CInventItem += inst.hc[i]*sol.S[n];
+				  c.NInventItem += sol.S[n];
+			   }
+
+			   if (sol.Dp[n] > 0.00001) {
+				  c.CHandItem += inst.ha[inst.il(i, l)]*sol.Dp[n];
+				  c.NHandItem += sol.Dp[n];
+			   }
+
+			   c.TotalUsedSpace += inst.cs[i]*sol.S[n];
+			}
+
+
+	  //Number and setup cost of used locations
+	  //and total available space of used locations
+	  for(n=0; n<sol.Z.size(); n++){
+		 if (sol.Z[n] > 0.00001) {
+			c.CSetupLocal += inst.g[n/inst.T]*sol.Z[n];
+			c.NLocalUsed += sol.Z[n];
+		 }
+
+		 c.TotalOpenSpace += inst.H[n/inst.T]*sol.Z[n];
+	  }
+
+
+	  //Number and cost of relocated items
+	  //(the objective function also considers l == k)
+	  double CRelocSame = 0;
+	  for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+		 sol.vindex(it->first, i, l, k, t);
+
+		 if ((l != k) && (it->second > 0.00001)) {
+			c.CRelocItem += inst.r[inst.ilk(i, l, k)]*it->second;
+			c.NRelocItem += it->second;
+		 }
+		   else if (l == k)
+			  CRelocSame += inst.r[inst.ilk(i, l, k)]*it->second;
+	  }
+
+
+	  //Percentage of used space
+	  //over all the opened space
+	  c.PercUsedSpace = 100*(c.TotalUsedSpace/c.TotalOpenSpace);
+
+
+	  //Objective function value
+	  c.OF = c.CProdItem + c.CSetupItem + c.CInventItem + c.CHandItem + c.CSetupLocal + c.CRelocItem + CRelocSame;
+
+	  return c;
+}
+
+
+
+
+//Print the other values of the solution in the output file
+inline void PrintCosts(std::ostream &out, const RCLSPMSL_Costs &c)
+{
+	  out << "************************************ Other Values ***********************************" << std::endl;
+	  out << std::endl;
+	  out << "Setup Cost Item = " << c.CSetupItem << std::endl;
+	  out << "Inventory Cost Item = " << c.CInventItem << std::endl;
+	  out << "Handling Cost Item = " << c.CHandItem << std::endl;
+	  out << "Setup Cost Location = " << c.CSetupLocal << std::endl;
+	  out << "Relocation Cost Item = " << c.CRelocItem << std::endl;
+	  out << std::endl;
+	  out << "Number Setup Item = " << c.NSetupItem << std::endl;
+	  out << "Number Inventoried Item = " << c.NInventItem << std::endl;
+	  out << "Number Handled Item = " << c.NHandItem << std::endl;
+	  out << "Number Used Location = " << c.NLocalUsed << std::endl;
+	  out << "Number Relocated Item = " << c.NRelocItem << std::endl;
+	  out << std::endl;
+	  out << "Total Opened Space = " << c.TotalOpenSpace << std::endl;
+	  out << "Total Used Space = " << c.TotalUsedSpace << std::endl;
+	  out << "Percentage Used Space = " << c.PercUsedSpace << std::endl;
+	  out << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+}
+
+
+
+
+//Print the nonzero decision variables in the output file
+inline void PrintSolution(std::ostream &out, const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol)
+{
+	  int t, i, l, k, tau;
+	  size_t n;
+
+	  for(t=0; t<inst.T; t++)
+		 for(i=0; i<inst.I; i++)
+			if (sol.Y[inst.it(i, t)] > 0.00001)
+			   out << "Y_" << i+1 << "_" << t+1 << " = " << sol.Y[inst.it(i, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			for(i=0; i<inst.I; i++)
+			   if (sol.S[inst.ilt(i, l, t)] > 0.00001)
+				  out << "S_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << sol.S[inst.ilt(i, l, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			if (sol.Z[inst.lt(l, t)] > 0.00001)
+			   out << "Z_" << l+1 << "_" << t+1 << " = " << sol.Z[inst.lt(l, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			for(i=0; i<inst.I; i++)
+			   if (sol.W[inst.ilt(i, l, t)] > 0.00001)
+				  out << "W_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << sol.W[inst.ilt(i, l, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			for(i=0; i<inst.I; i++)
+			   if (sol.Dp[inst.ilt(i, l, t)] > 0.00001)
+				  out << "Dp_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << sol.Dp[inst.ilt(i, l, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(l=0; l<inst.L; l++)
+			for(i=0; i<inst.I; i++)
+			   if (sol.Dm[inst.ilt(i, l, t)] > 0.00001)
+				  out << "Dm_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << sol.Dm[inst.ilt(i, l, t)] << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  //Relocations ordered by period, origin, destination and item
+	  std::vector<std::pair<std::vector<int>, double> > reloc;
+
+	  for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+		 sol.vindex(it->first, i, l, k, t);
+
+		 if ((l != k) && (it->second > 0.00001)) {
+			std::vector<int> key(4);
+			key[0] = t; key[1] = l; key[2] = k; key[3] = i;
+			reloc.push_back(std::make_pair(key, it->second));
+		 }
+	  }
+
+	  std::sort(reloc.begin(), reloc.end());
+
+	  for(n=0; n<reloc.size(); n++)
+		 out << "V_" << reloc[n].first[3]+1 << "_" << reloc[n].first[1]+1 << "_" << reloc[n].first[2]+1 << "_"
+			 << reloc[n].first[0]+1 << " = " << reloc[n].second << std::endl;
+
+	  out << std::endl << std::endl;
+
+	  for(t=0; t<inst.T; t++)
+		 for(tau = t; tau<inst.T; tau++)
+			for(i=0; i<inst.I; i++){
+			   n = inst.itt(i, t, tau);
+
+			   if (sol.FL[n] > 0.00001)
+				  out << "FL_" << i+1 << "_" << t+1 << "_" << tau+1 << " = " << sol.FL[n] << std::endl;
+			}
+}
+
+
+#endif
@@ -0,0 +1,479 @@
+// ************************************************************************************* //
+//     Compressed sparse rows of the Facility Location Reformulation of the General     //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)     //
+//	 																					 //
+//	  The columns (variables) of the RCLSP-MSL are numbered by family, and each		 //
+//	  family of constraints is built in arrays of compressed sparse rows, without	 //
+//	  the objects of the optimization package. The rows are the same as the ones	 //
+//	  of the programs (RCLSP-MSL.cpp), in the same order								 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_SPARSE_H
+#define RCLSPMSL_SPARSE_H
+
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <string>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Trace.h"
+
+
+
+//Families of variables (columns)
+enum { COL_Y, COL_S, COL_Z, COL_DP, COL_DM, COL_W, COL_V, COL_FL, COL_NFAMILIES };
+
+
+//Families of constraints (rows)
+enum { ROW_INFLOWOUTFLOW1, ROW_INFLOWOUTFLOW2, ROW_BALANCELOCATION, ROW_SETUP, ROW_CAPACITY,
+	   ROW_INVALLOC, ROW_CAPACITYSTORAGE, ROW_ITEMLOCATCOMPAT, ROW_ITEMITEMCOMPAT, ROW_NFAMILIES };
+
+
+inline const char *RowFamily(int f)
+{
+	  static const char *names[ROW_NFAMILIES] = {
+		  "InflowOutFlow1", "InflowOutFlow2", "BalanceLocation", "Setup", "Capacity",
+		  "InvAlloc", "CapacityStorage", "ItemLocatCompat", "ItemItemCompat" };
+
+	  return names[f];
+}
+
+
+
+
+//Columns of the RCLSP-MSL: objective function coefficients,
+//bounds and types of the variables of each family
+struct RCLSPMSL_Columns {
+
+	  int T, I, L;
+	  int first[COL_NFAMILIES + 1];									  //first column of each family
+
+	  std::vector<double> obj, lb, ub;
+	  std::vector<char> ctype;										  //'B' binary, 'C' continuous
+
+
+	  //Columns of the variables (FL only for tau >= t, V only for k != l)
+	  inline int y(int i, int t) const { return first[COL_Y] + i*T + t; }
+	  inline int s(int i, int l, int t) const { return first[COL_S] + (i*L + l)*T + t; }
+	  inline int z(int l, int t) const { return first[COL_Z] + l*T + t; }
+	  inline int dp(int i, int l, int t) const { return first[COL_DP] + (i*L + l)*T + t; }
+	  inline int dm(int i, int l, int t) const { return first[COL_DM] + (i*L + l)*T + t; }
+	  inline int w(int i, int l, int t) const { return first[COL_W] + (i*L + l)*T + t; }
+	  inline int v(int i, int l, int k, int t) const { return first[COL_V] + ((i*L + l)*(L-1) + k - (k > l))*T + t; }
+	  inline int fl(int i, int t, int tau) const { return first[COL_FL] + i*(T*(T+1)/2) + t*T - t*(t-1)/2 + (tau - t); }
+
+	  int size() const { return first[COL_NFAMILIES]; }
+
+
+	  //Number the columns of the instance; the binary
+	  //variables are linear (relaxed) if integer is false
+	  void build(const RCLSPMSL_Instance &inst, bool integer) {
+		  int i, l, k, t, tau;
+
+		  T = inst.T; I = inst.I; L = inst.L;
+
+		  int n[COL_NFAMILIES] = { I*T, I*L*T, L*T, I*L*T, I*L*T, I*L*T, I*L*(L-1)*T, I*(T*(T+1)/2) };
+
+		  first[0] = 0;
+		  for(int f = 0; f < COL_NFAMILIES; f++)
+			 first[f+1] = first[f] + n[f];
+
+		  obj.assign(size(), 0);
+		  lb.assign(size(), 0);
+		  ub.assign(size(), 1e20);
+		  ctype.assign(size(), 'C');
+
+		  for(i=0; i<I; i++)
+			 for(t=0; t<T; t++){
+				obj[y(i, t)] = inst.sc[i];
+				ub[y(i, t)] = 1;
+
+				for(tau = t; tau<T; tau++)
+				   obj[fl(i, t, tau)] = inst.vc[i];
+			 }
+
+		  for(l=0; l<L; l++)
+			 for(t=0; t<T; t++){
+				obj[z(l, t)] = inst.g[l];
+				ub[z(l, t)] = 1;
+			 }
+
+		  for(i=0; i<I; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   obj[s(i, l, t)] = inst.hc[i];
+				   obj[dp(i, l, t)] = inst.ha[inst.il(i, l)];
+				   ub[w(i, l, t)] = 1;
+
+				   for(k=0; k<L; k++)
+					  if (k != l) obj[v(i, l, k, t)] = inst.r[inst.ilk(i, l, k)];
+				}
+
+		  if (integer) {
+			 int binary[3] = { COL_Y, COL_Z, COL_W };
+
+			 for(int b = 0; b < 3; b++)
+				for(int c = first[binary[b]]; c < first[binary[b]+1]; c++) ctype[c] = 'B';
+		  }
+	  }
+
+};
+
+
+
+
+//Compressed sparse rows of a family of constraints
+struct RCLSPMSL_Rows {
+
+	  std::vector<int> beg;											  //first nonzero of each row
+	  std::vector<int> ind;											  //columns of the nonzeros
+	  std::vector<double> val;										  //coefficients of the nonzeros
+	  std::vector<double> rhs;										  //right-hand side of each row
+	  std::vector<char> sense;										  //'E' ==, 'L' <=, 'G' >=
+
+
+	  void clear() { beg.clear(); ind.clear(); val.clear(); rhs.clear(); sense.clear(); }
+
+	  int rows() const { return (int)beg.size(); }
+	  int nonzeros() const { return (int)ind.size(); }
+
+
+	  //Begin a new row
+	  void row(char sns, double b) {
+		  beg.push_back((int)ind.size());
+		  sense.push_back(sns);
+		  rhs.push_back(b);
+	  }
+
+	  //Add a nonzero to the current row
+	  void add(int col, double coef) {
+		  ind.push_back(col);
+		  val.push_back(coef);
+	  }
+
+};
+
+
+
+
+//Number of values of the outer index of the family of constraints f
+//(the rows are built in the order of the outer index)
+inline int OuterSize(const RCLSPMSL_Instance &inst, int f)
+{
+	  if (f == ROW_CAPACITY) return inst.T;
+	  if (f == ROW_CAPACITYSTORAGE) return inst.L;
+	  return inst.I;
+}
+
+
+
+
+//Build the rows of the family of constraints f, for the values of the
+//outer index (item; period for Capacity, location for CapacityStorage)
+//from first to last-1 (last = -1: all the values)
+inline void BuildRows(const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col, int f, RCLSPMSL_Rows &rows,
+					  int first = 0, int last = -1)
+{
+	  int T = inst.T, I = inst.I, L = inst.L, i, j, l, k, t, tau;
+	  RCLSPMSL_TraceScope Trace_Rows(std::string("Rows ") + RowFamily(f), "build");
+
+	  if (last < 0) last = OuterSize(inst, f);
+
+	  rows.clear();
+
+	  switch (f) {
+
+	  case ROW_INFLOWOUTFLOW1:
+		  for(i=first; i<last; i++)
+			 for(t=0; t<T; t++){
+				rows.row('E', inst.d[inst.it(i, t)]);
+
+				for(tau = 0; tau <= t; tau++)
+				   rows.add(col.fl(i, tau, t), 1);
+			 }
+		  break;
+
+
+	  case ROW_INFLOWOUTFLOW2:
+		  for(i=first; i<last; i++)
+			 for(t=0; t<T; t++){
+				rows.row('E', inst.d[inst.it(i, t)]);
+
+				for(tau = t; tau<T; tau++)
+				   rows.add(col.fl(i, t, tau), 1);
+
+				for(l=0; l<L; l++){
+				   rows.add(col.dp(i, l, t), -1);
+				   rows.add(col.dm(i, l, t), 1);
+				}
+			 }
+		  break;
+
+
+	  //The relocation from l to l is in both sums, so its coefficient is zero
+	  case ROW_BALANCELOCATION:
+		  for(i=first; i<last; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   rows.row('E', 0);
+
+				   if (t > 0) rows.add(col.s(i, l, t-1), 1);
+				   rows.add(col.dp(i, l, t), 1);
+				   rows.add(col.s(i, l, t), -1);
+				   rows.add(col.dm(i, l, t), -1);
+
+				   for(k=0; k<L; k++)
+					  if (k != l) {
+						 rows.add(col.v(i, k, l, t), 1);
+						 rows.add(col.v(i, l, k, t), -1);
+					  }
+				}
+		  break;
+
+
+	  case ROW_SETUP:
+		  for(i=first; i<last; i++)
+			 for(t=0; t<T; t++)
+				for(tau = t; tau<T; tau++){
+				   rows.row('L', 0);
+				   rows.add(col.fl(i, t, tau), 1);
+				   rows.add(col.y(i, t), -inst.d[inst.it(i, tau)]);
+				}
+		  break;
+
+
+	  case ROW_CAPACITY:
+		  for(t=first; t<last; t++){
+			 rows.row('L', inst.Cap[t]);
+
+			 for(i=0; i<I; i++)
+				for(tau = t; tau<T; tau++)
+				   rows.add(col.fl(i, t, tau), inst.vt[i]);
+		  }
+		  break;
+
+
+	  case ROW_INVALLOC:
+		  for(i=first; i<last; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   rows.row('L', 0);
+				   rows.add(col.s(i, l, t), 1);
+				   rows.add(col.w(i, l, t), -inst.BigM(i, l, t));
+				}
+		  break;
+
+
+	  case ROW_CAPACITYSTORAGE:
+		  for(l=first; l<last; l++)
+			 for(t=0; t<T; t++){
+				rows.row('L', 0);
+
+				for(i=0; i<I; i++)
+				   rows.add(col.s(i, l, t), inst.cs[i]);
+
+				rows.add(col.z(l, t), -inst.H[l]);
+			 }
+		  break;
+
+
+	  case ROW_ITEMLOCATCOMPAT:
+		  for(i=first; i<last; i++)
+			 for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   rows.row('L', inst.alpha[inst.il(i, l)]);
+				   rows.add(col.w(i, l, t), 1);
+				}
+		  break;
+
+
+	  //With j == i the two terms are the same column
+	  case ROW_ITEMITEMCOMPAT:
+		  for(i=first; i<last; i++)
+			 for(j=i; j<I; j++)
+				for(l=0; l<L; l++)
+				   for(t=0; t<T; t++){
+					  rows.row('L', inst.beta[inst.ij(i, j)] + 1);
+
+					  if (j == i) rows.add(col.w(i, l, t), 2);
+						else {
+						  rows.add(col.w(i, l, t), 1);
+						  rows.add(col.w(j, l, t), 1);
+						}
+				   }
+		  break;
+	  }
+}
+
+
+
+
+//Part of a family of constraints built by a thread, and
+//its first row and nonzero in the rows of the family
+struct RCLSPMSL_RowPart {
+	  int f, first, last;
+	  RCLSPMSL_Rows rows;
+	  size_t row0, nz0;
+};
+
+
+//Build the parts, taken in order by the threads
+inline void BuildParts(const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+					   std::vector<RCLSPMSL_RowPart> &parts, std::atomic<size_t> &next)
+{
+	  for(size_t p = next++; p < parts.size(); p = next++)
+		 BuildRows(inst, col, parts[p].f, parts[p].rows, parts[p].first, parts[p].last);
+}
+
+
+//Copy the parts, taken in order by the threads, to their
+//place in the rows of the family (and free the buffers)
+inline void MergeParts(std::vector<RCLSPMSL_Rows> &rows, std::vector<RCLSPMSL_RowPart> &parts, std::atomic<size_t> &next)
+{
+	  for(size_t p = next++; p < parts.size(); p = next++){
+		 RCLSPMSL_Rows &from = parts[p].rows, &to = rows[parts[p].f];
+		 size_t r0 = parts[p].row0, nz0 = parts[p].nz0;
+
+		 for(int r = 0; r < from.rows(); r++)
+			to.beg[r0 + r] = from.beg[r] + (int)nz0;
+
+		 std::copy(from.rhs.begin(), from.rhs.end(), to.rhs.begin() + r0);
+		 std::copy(from.sense.begin(), from.sense.end(), to.sense.begin() + r0);
+		 std::copy(from.ind.begin(), from.ind.end(), to.ind.begin() + nz0);
+		 std::copy(from.val.begin(), from.val.end(), to.val.begin() + nz0);
+
+		 from = RCLSPMSL_Rows();
+	  }
+}
+
+
+
+
+//Build all the families of constraints of the RCLSP-MSL
+//(rows[f] is the family f)
+//With more than one thread, each family is divided in parts of the
+//outer index, the parts are built concurrently in separate buffers
+//and the buffers of each family are merged in order
+inline void BuildModel(const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col, std::vector<RCLSPMSL_Rows> &rows,
+					   int threads = 1)
+{
+	  int f, a;
+
+	  rows.resize(ROW_NFAMILIES);
+
+	  if (threads <= 1) {
+		 for(f=0; f<ROW_NFAMILIES; f++)
+			BuildRows(inst, col, f, rows[f]);
+		 return;
+	  }
+
+
+	  //Parts of about 1/(4*threads) of each family; the largest families
+	  //(ItemItemCompat and BalanceLocation) are the first ones taken
+	  int order[ROW_NFAMILIES] = { ROW_ITEMITEMCOMPAT, ROW_BALANCELOCATION, ROW_INFLOWOUTFLOW2, ROW_SETUP, ROW_INVALLOC,
+								   ROW_ITEMLOCATCOMPAT, ROW_CAPACITYSTORAGE, ROW_CAPACITY, ROW_INFLOWOUTFLOW1 };
+
+	  std::vector<RCLSPMSL_RowPart> parts;
+
+	  for(a=0; a<ROW_NFAMILIES; a++){
+		 f = order[a];
+		 int n = OuterSize(inst, f), size = std::max(1, n/(4*threads));
+
+		 for(int first = 0; first < n; first += size){
+			RCLSPMSL_RowPart part;
+			part.f = f;
+			part.first = first;
+			part.last = std::min(n, first + size);
+			part.row0 = part.nz0 = 0;
+			parts.push_back(part);
+		 }
+	  }
+
+
+	  std::atomic<size_t> next(0);
+	  std::vector<std::thread> pool;
+
+	  for(a=1; a<threads; a++)
+		 pool.push_back(std::thread(BuildParts, std::cref(inst), std::cref(col), std::ref(parts), std::ref(next)));
+
+	  BuildParts(inst, col, parts, next);
+
+	  for(size_t p = 0; p < pool.size(); p++)
+		 pool[p].join();
+
+
+	  //Place of each part in the rows of its family (in the order of the
+	  //outer index), and merge of the parts by the threads
+	  std::vector<size_t> nrows(ROW_NFAMILIES, 0), nnz(ROW_NFAMILIES, 0);
+
+	  for(f=0; f<ROW_NFAMILIES; f++)
+		 for(size_t p = 0; p < parts.size(); p++)
+			if (parts[p].f == f) {
+			   parts[p].row0 = nrows[f];
+			   parts[p].nz0 = nnz[f];
+			   nrows[f] += parts[p].rows.rows();
+			   nnz[f] += parts[p].rows.nonzeros();
+			}
+
+	  for(f=0; f<ROW_NFAMILIES; f++){
+		 rows[f].beg.resize(nrows[f]); rows[f].rhs.resize(nrows[f]); rows[f].sense.resize(nrows[f]);
+		 rows[f].ind.resize(nnz[f]); rows[f].val.resize(nnz[f]);
+	  }
+
+	  next = 0;
+	  pool.clear();
+
+	  for(a=1; a<threads; a++)
+		 pool.push_back(std::thread(MergeParts, std::ref(rows), std::ref(parts), std::ref(next)));
+
+	  MergeParts(rows, parts, next);
+
+	  for(size_t p = 0; p < pool.size(); p++)
+		 pool[p].join();
+}
+
+
+
+
+//Recover the solution from the values x of the columns
+inline void SolutionFromColumns(const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col, const std::vector<double> &x,
+								RCLSPMSL_Solution &sol)
+{
+	  int i, l, k, t, tau;
+	  size_t n;
+
+	  sol.resize(inst);
+
+	  for(i=0; i<inst.I; i++)
+		 for(t=0; t<inst.T; t++){
+			sol.Y[inst.it(i, t)] = x[col.y(i, t)];
+
+			for(tau = t; tau<inst.T; tau++)
+			   sol.FL[inst.itt(i, t, tau)] = x[col.fl(i, t, tau)];
+		 }
+
+	  for(l=0; l<inst.L; l++)
+		 for(t=0; t<inst.T; t++)
+			sol.Z[inst.lt(l, t)] = x[col.z(l, t)];
+
+	  for(i=0; i<inst.I; i++)
+		 for(l=0; l<inst.L; l++)
+			for(t=0; t<inst.T; t++){
+			   n = inst.ilt(i, l, t);
+
+			   sol.S[n] = x[col.s(i, l, t)];
+			   sol.Dp[n] = x[col.dp(i, l, t)];
+			   sol.Dm[n] = x[col.dm(i, l, t)];
+			   sol.W[n] = x[col.w(i, l, t)];
+
+			   for(k=0; k<inst.L; k++)
+				  if ((k != l) && (x[col.v(i, l, k, t)] > 0.00001)) sol.setV(i, l, k, t, x[col.v(i, l, k, t)]);
+			}
+}
+
+#endif
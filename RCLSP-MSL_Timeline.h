@@ -0,0 +1,343 @@
+// ************************************************************************************* //
+//      Timeline of the solves of the programs of the Facility Location Reformulation   //
+//    of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations      //
+//                                     (RCLSP-MSL)                                       //
+//	 																					 //
+//	  Each new incumbent and each new best bound of the optimization package (with	 //
+//	  the number of nodes and the time) are recorded for every solve of a MIP (the	 //
+//	  RCLSP-MSL, SHP1, SHP2, windows of RFH and FOH), through an informational		 //
+//	  callback (see TimelineCallback in RCLSP-MSL_Concert.h). The timeline gives the	 //
+//	  primal integral and the time to a target gap of each solve, and it is written	 //
+//	  as a CSV file with the option timeline=<file>. The primal integrals of the		 //
+//	  solves of the RCLSP-MSL use a best known value as the reference (the option	 //
+//	  reference=<value> or the best known solution in the cache of the runs), then	 //
+//	  they compare the heuristics														 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_TIMELINE_H
+#define RCLSPMSL_TIMELINE_H
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+
+
+//Point of the timeline: time (seconds since the beginning of the run),
+//nodes, incumbent (if there is one) and best bound of the solve
+struct RCLSPMSL_TimelinePoint {
+
+	  double time;
+	  long long nodes;
+	  bool incumbent;
+	  double OF, bound;
+
+};
+
+
+//Solve of a MIP: its points, from the beginning to the end of the solve
+struct RCLSPMSL_TimelineSolve {
+
+	  std::string name;
+	  bool comparable;												  //objective function of the RCLSP-MSL (false: SHP1)
+	  double start, end;
+	  std::vector<RCLSPMSL_TimelinePoint> points;
+
+};
+
+
+
+
+//Relative gap between an incumbent and a bound (the same as the
+//optimization package: |bound - OF| / (1e-10 + |OF|))
+inline double TimelineGap(double OF, double bound)
+{
+	  return fabs(bound - OF)/(1e-10 + fabs(OF));
+}
+
+
+//Primal gap of an incumbent to the reference value (1 without incumbent
+//or with values of different signs, Berthold's primal integral)
+inline double PrimalGap(bool incumbent, double OF, double reference)
+{
+	  if (!incumbent || (OF*reference < 0)) return 1;
+	  if ((fabs(OF) < 1e-10) && (fabs(reference) < 1e-10)) return 0;
+
+	  return fabs(OF - reference)/std::max(fabs(OF), fabs(reference));
+}
+
+
+
+
+//Primal integral of a solve (seconds): integral of the primal gap of the
+//incumbents from the beginning to the end of the solve, with the reference
+//value given (own false) or the last incumbent of the solve (own true, the
+//integral then only measures how fast the solve reached its own end). A
+//solve without incumbent has primal gap 1: the integral is its time
+inline double PrimalIntegral(const RCLSPMSL_TimelineSolve &s, bool own = true, double reference = 0)
+{
+	  const std::vector<RCLSPMSL_TimelinePoint> &p = s.points;
+	  double integral = 0, time = s.start;
+	  bool incumbent = false;
+	  double OF = 0;
+
+	  if (own)
+		 for(size_t a = 0; a < p.size(); a++)
+			if (p[a].incumbent) reference = p[a].OF;
+
+	  for(size_t a = 0; a < p.size(); a++){
+		 integral += PrimalGap(incumbent, OF, reference)*(p[a].time - time);
+		 time = p[a].time;
+		 incumbent = p[a].incumbent;
+		 OF = p[a].OF;
+	  }
+
+	  return integral + PrimalGap(incumbent, OF, reference)*std::max(0.0, s.end - time);
+}
+
+
+//Time (seconds since the beginning of the solve) in which the gap of
+//the solve reached the target (relative gap, e.g. 0.01)
+//Return -1 if the target was not reached
+inline double TimeToGap(const RCLSPMSL_TimelineSolve &s, double target)
+{
+	  for(size_t a = 0; a < s.points.size(); a++)
+		 if (s.points[a].incumbent && (TimelineGap(s.points[a].OF, s.points[a].bound) <= target))
+			return s.points[a].time - s.start;
+
+	  return -1;
+}
+
+
+
+
+//Time (seconds since the beginning of the run) of the first incumbent
+//of the solves
+//Return -1 if no solve found an incumbent
+inline double TimeToFirstIncumbent(const std::vector<RCLSPMSL_TimelineSolve> &s)
+{
+	  for(size_t a = 0; a < s.size(); a++)
+		 for(size_t b = 0; b < s[a].points.size(); b++)
+			if (s[a].points[b].incumbent) return s[a].points[b].time;
+
+	  return -1;
+}
+
+
+
+
+//Time (seconds since the beginning of the run) in which a solve first
+//reached the target gap (relative gap, e.g. 0.01)
+//Return -1 if no solve reached the target
+inline double TimeToTarget(const std::vector<RCLSPMSL_TimelineSolve> &s, double target)
+{
+	  double best = -1;
+
+	  for(size_t a = 0; a < s.size(); a++){
+		 double time = TimeToGap(s[a], target);
+		 if ((time >= 0) && ((best < 0) || (s[a].start + time < best))) best = s[a].start + time;
+	  }
+
+	  return best;
+}
+
+
+
+
+//Timeline of the solves of a run (one for each program, see Timeline())
+class RCLSPMSL_Timeline {
+
+	  std::string file;
+	  double target;												  //relative target gap
+	  bool hasRef;
+	  double reference;												  //best known value of the RCLSP-MSL
+	  std::string source;											  //where the reference comes from
+	  bool open, written;
+	  std::chrono::steady_clock::time_point origin;
+
+	  std::mutex lock;
+	  std::vector<RCLSPMSL_TimelineSolve> solves;
+
+
+	  double now() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count(); }
+
+	  //Add a point to the solve open (the lock is held); only the points with a new
+	  //incumbent or a new bound are kept, unless the point is the end of the solve
+	  void add(bool incumbent, double OF, double bound, long long nodes, bool last)
+	  {
+		  std::vector<RCLSPMSL_TimelinePoint> &p = solves.back().points;
+
+		  if (!last && !p.empty()) {
+			 const RCLSPMSL_TimelinePoint &q = p.back();
+			 bool newOF = (incumbent != q.incumbent) || (incumbent && (fabs(OF - q.OF) > 1e-9*std::max(1.0, fabs(OF))));
+			 bool newBound = fabs(bound - q.bound) > 1e-9*std::max(1.0, fabs(bound));
+			 if (!newOF && !newBound) return;
+		  }
+
+		  RCLSPMSL_TimelinePoint n = { now(), nodes, incumbent, (incumbent) ? OF : 0, bound };
+		  p.push_back(n);
+	  }
+
+public:
+
+	  RCLSPMSL_Timeline() : target(0.01), hasRef(false), reference(0), open(false), written(false),
+							origin(std::chrono::steady_clock::now()) {}
+
+	  //The CSV file is written when the program ends, if it was not written before
+	  ~RCLSPMSL_Timeline() { write(); }
+
+
+	  //File of the timeline (no file if it is empty) and target gap (percentage)
+	  void setFile(const std::string &name) { file = name; written = false; }
+	  void setTarget(double gap) { target = gap/100; }
+	  double getTarget() const { return target; }
+
+
+	  //Reference of the primal integrals: best known objective function
+	  //value of the RCLSP-MSL and where it comes from
+	  void setReference(double value, const std::string &from) { hasRef = true; reference = value; source = from; }
+	  bool hasReference() const { return hasRef; }
+	  double getReference() const { return reference; }
+	  const std::string &getSource() const { return source; }
+
+
+	  //Beginning and end of the solve of a MIP (the values at the end are
+	  //the final incumbent, bound and nodes of the solve); comparable is
+	  //false if the objective function is not the one of the RCLSP-MSL
+	  void begin(const std::string &name, bool comparable = true)
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  RCLSPMSL_TimelineSolve s;
+		  s.name = name;
+		  s.comparable = comparable;
+		  s.start = s.end = now();
+		  solves.push_back(s);
+		  open = true;
+	  }
+
+	  void end(bool incumbent, double OF, double bound, long long nodes)
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  if (!open) return;
+
+		  add(incumbent, OF, bound, nodes, true);
+		  solves.back().end = now();
+		  open = false;
+	  }
+
+
+	  //Incumbent, bound and nodes during the solve (from the callback)
+	  void record(bool incumbent, double OF, double bound, long long nodes)
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  if (open) add(incumbent, OF, bound, nodes, false);
+	  }
+
+
+	  std::vector<RCLSPMSL_TimelineSolve> getSolves()
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  return solves;
+	  }
+
+
+	  //Write the points of the solves in the CSV file
+	  //Return false if there is no file or it could not be written
+	  bool write()
+	  {
+		  if (file.empty() || written) return false;
+
+		  std::lock_guard<std::mutex> guard(lock);
+		  std::ofstream out(file.c_str());
+		  if (!out) return false;
+
+		  char line[256];
+
+		  out << "solve,time,nodes,incumbent,bound,gap" << std::endl;
+		  for(size_t s = 0; s < solves.size(); s++)
+			 for(size_t a = 0; a < solves[s].points.size(); a++){
+				const RCLSPMSL_TimelinePoint &p = solves[s].points[a];
+
+				if (p.incumbent) sprintf(line, "%.3f,%lld,%.10g,%.10g,%.6g", p.time, p.nodes, p.OF, p.bound, TimelineGap(p.OF, p.bound));
+				  else sprintf(line, "%.3f,%lld,,%.10g,", p.time, p.nodes, p.bound);
+				out << solves[s].name << "," << line << std::endl;
+			 }
+
+		  written = true;
+		  return (bool)out;
+	  }
+
+};
+
+
+
+
+//Timeline of the program
+inline RCLSPMSL_Timeline &Timeline()
+{
+	  static RCLSPMSL_Timeline timeline;
+	  return timeline;
+}
+
+
+
+
+//Print the primal integral and the time to the target gap of the solves
+//(Reference: Best - the reference of the timeline, Own - the last incumbent
+//of the solve, when there is no reference or the solve is not comparable)
+inline void PrintTimeline(std::ostream &out, RCLSPMSL_Timeline &timeline)
+{
+	  std::vector<RCLSPMSL_TimelineSolve> s = timeline.getSolves();
+	  double total = 0, time = 0;
+	  char line[200];
+
+	  out << "************************************* Timeline **************************************" << std::endl;
+	  out << std::endl << std::endl;
+	  out << "Target Gap (%) = " << 100*timeline.getTarget() << std::endl;
+	  if (timeline.hasReference())
+		 out << "Reference of the Primal Integral = " << timeline.getReference() << " (" << timeline.getSource() << ")" << std::endl;
+		else out << "Reference of the Primal Integral = last incumbent of each solve (no best known value)" << std::endl;
+	  out << std::endl;
+	  out << std::setw(20) << std::left << "Solve" << std::right << std::setw(10) << "Time" << std::setw(12) << "Nodes"
+		  << std::setw(8) << "Points" << std::setw(16) << "OF" << std::setw(16) << "Bound" << std::setw(10) << "Gap (%)"
+		  << std::setw(12) << "Integral" << std::setw(12) << "To Target" << std::setw(11) << "Reference" << std::endl;
+
+	  for(size_t a = 0; a < s.size(); a++){
+		 if (s[a].points.empty()) continue;
+
+		 const RCLSPMSL_TimelinePoint &p = s[a].points.back();
+		 bool own = !timeline.hasReference() || !s[a].comparable;
+		 double integral = PrimalIntegral(s[a], own, timeline.getReference()), target = TimeToGap(s[a], timeline.getTarget());
+
+		 sprintf(line, "%-20.20s%10.2f%12lld%8d", s[a].name.c_str(), s[a].end - s[a].start, p.nodes, (int)s[a].points.size());
+		 out << line;
+		 if (p.incumbent) sprintf(line, "%16.2f%16.2f%10.4f", p.OF, p.bound, 100*TimelineGap(p.OF, p.bound));
+		   else sprintf(line, "%16s%16s%10s", "-", "-", "-");
+		 out << line;
+		 if (target >= 0) sprintf(line, "%12.3f%12.3f%11s", integral, target, (own) ? "Own" : "Best");
+		   else sprintf(line, "%12.3f%12s%11s", integral, "-", (own) ? "Own" : "Best");
+		 out << line << std::endl;
+
+		 total += integral;
+		 time += s[a].end - s[a].start;
+	  }
+
+	  out << std::endl;
+	  out << "Solves = " << s.size() << std::endl;
+	  out << "Time of the Solves = " << time << std::endl;
+	  out << "Primal Integral = " << total << std::endl;
+	  out << std::endl << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+}
+
+
+#endif
@@ -0,0 +1,280 @@
+// ************************************************************************************* //
+//        Trace of the phases of the programs of the Facility Location Reformulation     //
+//    of the General Capacitated Lot-Sizing Problem with Multiple Storage Locations      //
+//                                     (RCLSP-MSL)                                       //
+//	 																					 //
+//	  The programs mark the beginning and the end of their phases (instance read,	 //
+//	  families of variables and constraints, extraction, LR, windows, iterations,	 //
+//	  report). With the option trace=<file> the marks are written at the end of		 //
+//	  the run as a JSON file of trace events (chrome://tracing, Perfetto). Without	 //
+//	  the option the marks do nothing												 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_TRACE_H
+#define RCLSPMSL_TRACE_H
+
+
+#include <vector>
+#include <string>
+#include <map>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include "RCLSP-MSL_Json.h"
+#include "RCLSP-MSL_Memory.h"
+
+
+
+//Event of the trace: beginning (B) or end (E) of a phase, or value of
+//a counter (C), time in microseconds since the trace was opened, and
+//thread of the event
+struct RCLSPMSL_TraceEvent {
+
+	  std::string name;
+	  const char *cat;
+	  char ph;
+	  double ts;
+	  int tid;
+	  double value;
+
+};
+
+
+//Time of a step of a track (seconds)
+struct RCLSPMSL_PhaseTime {
+
+	  std::string track, phase;
+	  double time;
+
+};
+
+
+
+
+//Trace of the phases of a run (one for each program, see Trace())
+class RCLSPMSL_Trace {
+
+	  //Phase open in a thread: step of a track (see step) or scope (empty track)
+	  struct Open { std::string track, name; const char *cat; double start; };
+
+	  std::string file, process;
+	  bool on, written;
+	  bool accounting;												  //memory at the end of the steps and solves
+	  std::vector<RCLSPMSL_PhaseMemory> phases;
+	  std::vector<RCLSPMSL_PhaseTime> times;						  //steps ended, with or without the trace file
+	  std::chrono::steady_clock::time_point origin;
+
+	  std::mutex lock;
+	  std::vector<RCLSPMSL_TraceEvent> events;
+	  std::map<std::thread::id, int> tids;
+	  std::map<std::thread::id, std::vector<Open> > opened;		  //the last one is the innermost
+
+
+	  double now() const { return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count(); }
+
+	  //Add an event of the thread (the lock is held)
+	  void add(const std::string &name, const char *cat, char ph, double value = 0)
+	  {
+		  if (!on) return;
+
+		  double ts = now();
+
+		  std::map<std::thread::id, int>::iterator it = tids.find(std::this_thread::get_id());
+		  if (it == tids.end()) it = tids.insert(std::make_pair(std::this_thread::get_id(), (int)tids.size() + 1)).first;
+
+		  RCLSPMSL_TraceEvent e = { name, cat, ph, ts, it->second, value };
+		  events.push_back(e);
+	  }
+
+	  //End the phases of the thread from position p (the innermost first); the
+	  //time of the steps is kept, and the memory at the end of the steps and
+	  //of the solves
+	  void close(std::vector<Open> &o, size_t p)
+	  {
+		  while (o.size() > p) {
+			 add(o.back().name, o.back().cat, 'E');
+
+			 if (!o.back().track.empty()) {
+				RCLSPMSL_PhaseTime d = { o.back().track, o.back().name, (now() - o.back().start)/1e6 };
+				times.push_back(d);
+			 }
+
+			 if (accounting && (!o.back().track.empty() || !strcmp(o.back().cat, "solve"))) {
+				RCLSPMSL_PhaseMemory m = { o.back().name, CurrentRSS(), PeakRSS() };
+				phases.push_back(m);
+				add("RSS (MB)", "memory", 'C', m.rss/1048576.0);
+			 }
+
+			 o.pop_back();
+		  }
+	  }
+
+public:
+
+	  RCLSPMSL_Trace() : on(false), written(false), accounting(false), origin(std::chrono::steady_clock::now()) {}
+
+	  //The trace is written when the program ends, if it was not written before
+	  ~RCLSPMSL_Trace() { write(); }
+
+
+	  //Open the trace of the program (no trace if file is empty)
+	  void open(const std::string &name, const std::string &program)
+	  {
+		  file = name;
+		  process = program;
+		  on = !file.empty();
+		  written = false;
+		  origin = std::chrono::steady_clock::now();
+	  }
+
+	  bool enabled() const { return on; }
+
+
+	  //Keep the memory of the process at the end of the steps and of the
+	  //solves (see RCLSP-MSL_Memory.h), with or without the trace file
+	  void account(bool memory) { accounting = memory; }
+
+	  std::vector<RCLSPMSL_PhaseMemory> memory()
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  return phases;
+	  }
+
+
+	  //Time of the steps ended (see step)
+	  std::vector<RCLSPMSL_PhaseTime> phaseTimes()
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  return times;
+	  }
+
+
+	  //Beginning and end of the phase of a scope (the steps opened inside
+	  //the scope end with it)
+	  void begin(const std::string &name, const char *cat)
+	  {
+		  if (!on && !accounting) return;
+
+		  std::lock_guard<std::mutex> guard(lock);
+		  Open o = { "", name, cat, now() };
+		  opened[std::this_thread::get_id()].push_back(o);
+		  add(name, cat, 'B');
+	  }
+
+	  void end(const std::string &name, const char *cat)
+	  {
+		  if (!on && !accounting) return;
+
+		  std::lock_guard<std::mutex> guard(lock);
+		  std::vector<Open> &o = opened[std::this_thread::get_id()];
+
+		  size_t p = o.size();
+		  while ((p > 0) && !(o[p-1].track.empty() && (o[p-1].name == name) && !strcmp(o[p-1].cat, cat))) p--;
+		  if (p > 0) close(o, p - 1);
+	  }
+
+
+	  //End the step of the track (and the phases opened after it) and begin the
+	  //next step of the track (no next step if name is empty). The steps mark
+	  //the sequential phases of the main programs without a scope for each one
+	  //(the time of the steps is kept even without the trace file)
+	  void step(const std::string &track, const std::string &name)
+	  {
+		  std::lock_guard<std::mutex> guard(lock);
+		  std::vector<Open> &o = opened[std::this_thread::get_id()];
+
+		  size_t p = o.size();
+		  while ((p > 0) && !o[p-1].track.empty() && (o[p-1].track != track)) p--;
+		  if ((p > 0) && (o[p-1].track == track)) close(o, p - 1);
+
+		  if (!name.empty()) {
+			 Open n = { track, name, "phase", now() };
+			 o.push_back(n);
+			 add(name, "phase", 'B');
+		  }
+	  }
+
+
+	  //Write the trace events in the file (the phases still open end now)
+	  //Return false if there is no trace or the file could not be written
+	  bool write()
+	  {
+		  if (!on || written) return false;
+
+		  std::lock_guard<std::mutex> guard(lock);
+
+		  for(std::map<std::thread::id, std::vector<Open> >::iterator it = opened.begin(); it != opened.end(); ++it)
+			 close(it->second, 0);
+
+		  std::ofstream out(file.c_str());
+		  if (!out) return false;
+
+		  char ts[32];
+
+		  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+		  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":";
+		  WriteJsonString(out, process);
+		  out << "}}";
+
+		  for(size_t a = 0; a < events.size(); a++){
+			 const RCLSPMSL_TraceEvent &e = events[a];
+
+			 out << "," << std::endl << "{\"name\":";
+			 WriteJsonString(out, e.name);
+			 sprintf(ts, "%.3f", e.ts);
+			 out << ",\"cat\":\"" << e.cat << "\",\"ph\":\"" << e.ph << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << e.tid;
+
+			 if (e.ph == 'C') {
+				out << ",\"args\":{\"MB\":";
+				WriteJsonNumber(out, e.value);
+				out << "}";
+			 }
+
+			 out << "}";
+		  }
+
+		  out << std::endl << "]}" << std::endl;
+
+		  written = true;
+		  return (bool)out;
+	  }
+
+};
+
+
+
+
+//Trace of the program
+inline RCLSPMSL_Trace &Trace()
+{
+	  static RCLSPMSL_Trace trace;
+	  return trace;
+}
+
+
+
+
+//Phase of a scope (e.g. a window or an iteration of the heuristics):
+//it begins with the object and ends when the object is destroyed
+class RCLSPMSL_TraceScope {
+
+	  std::string name;
+	  const char *cat;
+
+public:
+
+	  RCLSPMSL_TraceScope(const std::string &phase, const char *category) : name(phase), cat(category)
+	  {
+		  Trace().begin(name, cat);
+	  }
+
+	  ~RCLSPMSL_TraceScope() { Trace().end(name, cat); }
+
+};
+
+
+#endif
@@ -0,0 +1,342 @@
+// ************************************************************************************* //
+//       Validator of solutions of the Facility Location Reformulation of the General    //
+//       Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//	 																					 //
+//	  Every constraint of the RCLSP-MSL is checked over the plain C++ solution,		 //
+//	  independently of the optimization package: InflowOutFlow1, InflowOutFlow2,		 //
+//	  BalanceLocation, Setup, Capacity, InvAlloc, CapacityStorage, ItemLocatCompat,	 //
+//	  ItemItemCompat and the domain of the variables (binary and nonnegative)		 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_VALIDATOR_H
+#define RCLSPMSL_VALIDATOR_H
+
+
+#include <vector>
+#include <map>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+
+
+
+//Families of constraints checked by the Validator
+enum { VAL_INFLOWOUTFLOW1, VAL_INFLOWOUTFLOW2, VAL_BALANCELOCATION, VAL_SETUP, VAL_CAPACITY,
+	   VAL_INVALLOC, VAL_CAPACITYSTORAGE, VAL_ITEMLOCATCOMPAT, VAL_ITEMITEMCOMPAT, VAL_DOMAIN,
+	   VAL_NFAMILIES };
+
+
+inline const char *ValidationFamily(int f)
+{
+	  static const char *names[VAL_NFAMILIES] = {
+		  "InflowOutFlow1", "InflowOutFlow2", "BalanceLocation", "Setup", "Capacity",
+		  "InvAlloc", "CapacityStorage", "ItemLocatCompat", "ItemItemCompat", "Domain" };
+
+	  return names[f];
+}
+
+
+
+
+//Result of the validation of a solution
+struct RCLSPMSL_Validation {
+
+	  double tol;													  //tolerance (relative to the magnitude of the row, at least 1)
+
+	  long violations[VAL_NFAMILIES];								  //number of violated constraints of each family
+	  double maxViolation[VAL_NFAMILIES];							  //largest violation of each family
+
+	  std::vector<std::string> messages;							  //first violated constraints
+	  size_t maxMessages;
+
+	  RCLSPMSL_Costs costs;											  //recalculated costs of the solution
+
+
+	  RCLSPMSL_Validation() : tol(1e-5), maxMessages(20) {
+		  for(int f = 0; f < VAL_NFAMILIES; f++){
+			 violations[f] = 0;
+			 maxViolation[f] = 0;
+		  }
+	  }
+
+	  long total() const {
+		  long n = 0;
+		  for(int f = 0; f < VAL_NFAMILIES; f++) n += violations[f];
+		  return n;
+	  }
+
+	  bool feasible() const { return (total() == 0); }
+
+
+	  //Count the violation of the constraint (lhs <= rhs, or lhs == rhs if equal)
+	  //mag is the magnitude of the row, the sum of |a_j x_j| of its terms, since
+	  //the rounding of the values printed in the output files grows with it
+	  void check(int f, bool equal, double lhs, double rhs, double mag, const char *name, int a, int b = -1, int c = -1, int e = -1) {
+
+		  double v = equal ? fabs(lhs - rhs) : lhs - rhs;
+		  if (v <= tol*std::max(1.0, std::max(fabs(rhs), mag))) return;
+
+		  violations[f]++;
+		  if (v > maxViolation[f]) maxViolation[f] = v;
+
+		  if (messages.size() < maxMessages) {
+			 std::ostringstream m;
+			 m << name << "_" << a+1;
+			 if (b >= 0) m << "_" << b+1;
+			 if (c >= 0) m << "_" << c+1;
+			 if (e >= 0) m << "_" << e+1;
+			 m << ": " << lhs << (equal ? " == " : " <= ") << rhs;
+			 messages.push_back(m.str());
+		  }
+	  }
+
+};
+
+
+
+
+//Check all the constraints of the RCLSP-MSL in the solution
+inline RCLSPMSL_Validation Validate(const RCLSPMSL_Instance &inst, const RCLSPMSL_Solution &sol, double tol = 1e-5)
+{
+	  RCLSPMSL_Validation v;
+	  int T = inst.T, I = inst.I, L = inst.L, i, j, l, k, t, tau;
+	  size_t n;
+
+	  v.tol = tol;
+
+
+	  //Relocations into (vin) and out of (vout) each location,
+	  //and their magnitude in the balance of each location (vmag)
+	  std::vector<double> vin((size_t)I*L*T, 0), vout((size_t)I*L*T, 0), vmag((size_t)I*L*T, 0);
+
+	  for(std::map<size_t, double>::const_iterator it = sol.V.begin(); it != sol.V.end(); ++it){
+		 sol.vindex(it->first, i, l, k, t);
+
+		 vout[inst.ilt(i, l, t)] += it->second;
+		 vin[inst.ilt(i, k, t)] += it->second;
+		 vmag[inst.ilt(i, l, t)] += fabs(it->second);
+		 vmag[inst.ilt(i, k, t)] += fabs(it->second);
+
+		 v.check(VAL_DOMAIN, false, -it->second, 0, 0, "V", i, l, k, t);
+	  }
+
+
+	  //Inflow and outflow of the items
+	  for(i=0; i<I; i++)
+		 for(t=0; t<T; t++){
+			double in = 0, out = 0, flow = 0, mag_in = 0, mag_out = 0;
+
+			for(tau = 0; tau <= t; tau++){
+			   in += sol.FL[inst.itt(i, tau, t)];
+			   mag_in += fabs(sol.FL[inst.itt(i, tau, t)]);
+			}
+
+			for(tau = t; tau<T; tau++){
+			   out += sol.FL[inst.itt(i, t, tau)];
+			   mag_out += fabs(sol.FL[inst.itt(i, t, tau)]);
+			}
+
+			for(l=0; l<L; l++){
+			   flow += sol.Dp[inst.ilt(i, l, t)] - sol.Dm[inst.ilt(i, l, t)];
+			   mag_out += fabs(sol.Dp[inst.ilt(i, l, t)]) + fabs(sol.Dm[inst.ilt(i, l, t)]);
+			}
+
+			v.check(VAL_INFLOWOUTFLOW1, true, in, inst.d[inst.it(i, t)], mag_in, "InflowOutFlow1", i, t);
+			v.check(VAL_INFLOWOUTFLOW2, true, out - flow, inst.d[inst.it(i, t)], mag_out, "InflowOutFlow2", i, t);
+		 }
+
+
+	  //Balance of the inventory at the locations
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			for(t=0; t<T; t++){
+			   n = inst.ilt(i, l, t);
+
+			   double before = (t > 0) ? sol.S[n-1] : 0;
+			   v.check(VAL_BALANCELOCATION, true, before + sol.Dp[n] - sol.Dm[n] + vin[n] - vout[n], sol.S[n],
+					   fabs(before) + fabs(sol.Dp[n]) + fabs(sol.Dm[n]) + vmag[n], "BalanceLocation", i, l, t);
+			}
+
+
+	  //Setup and capacity of the production
+	  for(t=0; t<T; t++){
+		 double cap = 0, mag = 0;
+
+		 for(i=0; i<I; i++)
+			for(tau = t; tau<T; tau++){
+			   double x = sol.FL[inst.itt(i, t, tau)];
+			   cap += inst.vt[i]*x;
+			   mag += fabs(inst.vt[i]*x);
+
+			   v.check(VAL_SETUP, false, x, inst.d[inst.it(i, tau)]*sol.Y[inst.it(i, t)], fabs(x), "Setup", i, t, tau);
+			   v.check(VAL_DOMAIN, false, -x, 0, 0, "FL", i, t, tau);
+			}
+
+		 v.check(VAL_CAPACITY, false, cap, inst.Cap[t], mag, "Capacity", t);
+	  }
+
+
+	  //Allocation of the inventory, capacity of the
+	  //locations and compatibility of the items
+	  std::vector<double> used((size_t)L*T, 0), umag((size_t)L*T, 0);
+	  std::vector<int> assigned;
+
+	  for(i=0; i<I; i++)
+		 for(l=0; l<L; l++)
+			for(t=0; t<T; t++){
+			   n = inst.ilt(i, l, t);
+
+			   v.check(VAL_INVALLOC, false, sol.S[n], inst.BigM(i, l, t)*sol.W[n], fabs(sol.S[n]), "InvAlloc", i, l, t);
+			   v.check(VAL_ITEMLOCATCOMPAT, false, sol.W[n], inst.alpha[inst.il(i, l)], fabs(sol.W[n]), "ItemLocatCompat", i, l, t);
+
+			   used[inst.lt(l, t)] += inst.cs[i]*sol.S[n];
+			   umag[inst.lt(l, t)] += fabs(inst.cs[i]*sol.S[n]);
+			}
+
+	  for(l=0; l<L; l++)
+		 for(t=0; t<T; t++){
+			v.check(VAL_CAPACITYSTORAGE, false, used[inst.lt(l, t)], inst.H[l]*sol.Z[inst.lt(l, t)], umag[inst.lt(l, t)],
+					"CapacityStorage", l, t);
+
+			//Only the items assigned to the location can violate ItemItemCompat
+			assigned.clear();
+			for(i=0; i<I; i++)
+			   if (sol.W[inst.ilt(i, l, t)] > tol) assigned.push_back(i);
+
+			for(size_t a = 0; a < assigned.size(); a++)
+			   for(size_t b = a; b < assigned.size(); b++){
+				  i = assigned[a]; j = assigned[b];
+				  v.check(VAL_ITEMITEMCOMPAT, false, sol.W[inst.ilt(i, l, t)] + sol.W[inst.ilt(j, l, t)],
+						  inst.beta[inst.ij(i, j)] + 1, fabs(sol.W[inst.ilt(i, l, t)]) + fabs(sol.W[inst.ilt(j, l, t)]),
+						  "ItemItemCompat", i, j, l, t);
+			   }
+		 }
+
+
+	  //Domain of the variables: binary Y, Z and W,
+	  //nonnegative S, Dp and Dm
+	  for(n=0; n<sol.Y.size(); n++)
+		 v.check(VAL_DOMAIN, false, std::min(fabs(sol.Y[n]), fabs(sol.Y[n] - 1)), 0, 0, "Y", (int)(n/T), (int)(n%T));
+
+	  for(n=0; n<sol.Z.size(); n++)
+		 v.check(VAL_DOMAIN, false, std::min(fabs(sol.Z[n]), fabs(sol.Z[n] - 1)), 0, 0, "Z", (int)(n/T), (int)(n%T));
+
+	  for(n=0; n<sol.W.size(); n++){
+		 v.check(VAL_DOMAIN, false, std::min(fabs(sol.W[n]), fabs(sol.W[n] - 1)), 0, 0, "W", (int)(n/((size_t)L*T)), (int)(n/T%L), (int)(n%T));
+		 v.check(VAL_DOMAIN, false, -sol.S[n], 0, 0, "S", (int)(n/((size_t)L*T)), (int)(n/T%L), (int)(n%T));
+		 v.check(VAL_DOMAIN, false, -sol.Dp[n], 0, 0, "Dp", (int)(n/((size_t)L*T)), (int)(n/T%L), (int)(n%T));
+		 v.check(VAL_DOMAIN, false, -sol.Dm[n], 0, 0, "Dm", (int)(n/((size_t)L*T)), (int)(n/T%L), (int)(n%T));
+	  }
+
+
+	  v.costs = ComputeCosts(inst, sol);
+
+	  return v;
+}
+
+
+
+
+//Read the last solution printed in an output file of the programs
+//(the values not printed are zero), and its objective function value
+inline bool ReadSolution(std::istream &in, const RCLSPMSL_Instance &inst, RCLSPMSL_Solution &sol, double &OF)
+{
+	  std::string line;
+	  bool found = false;
+
+	  sol.resize(inst);
+	  OF = 0;
+
+	  while (std::getline(in, line)) {
+		 if (!line.empty() && (line[line.size()-1] == '\r')) line.erase(line.size()-1);
+
+		 size_t eq = line.find(" = ");
+		 if (eq == std::string::npos) continue;
+
+		 std::string name = line.substr(0, eq);
+		 double value = atof(line.c_str() + eq + 3);
+
+		 //A new solution begins with its objective function value
+		 if (name == "Objective Function Value") {
+			sol.resize(inst);
+			OF = value;
+			found = true;
+			continue;
+		 }
+
+		 size_t u = name.find('_');
+		 if (u == std::string::npos) continue;
+
+		 std::string var = name.substr(0, u);
+		 int x[4] = { 0, 0, 0, 0 }, nx = 0;
+
+		 for(size_t p = u; (p != std::string::npos) && (nx < 4); p = name.find('_', p+1))
+			x[nx++] = atoi(name.c_str() + p + 1) - 1;
+
+		 if (nx == 2) {
+			if ((x[0] < 0) || (x[1] < 0)) continue;
+
+			if ((var == "Y") && (x[0] < inst.I) && (x[1] < inst.T)) sol.Y[inst.it(x[0], x[1])] = value;
+			  else if ((var == "Z") && (x[0] < inst.L) && (x[1] < inst.T)) sol.Z[inst.lt(x[0], x[1])] = value;
+		 }
+		   else if (nx == 3) {
+			  if ((x[0] < 0) || (x[1] < 0) || (x[2] < 0) || (x[0] >= inst.I) || (x[2] >= inst.T)) continue;
+
+			  if (var == "FL") {
+				 if (x[1] <= x[2]) sol.FL[inst.itt(x[0], x[1], x[2])] = value;
+				 continue;
+			  }
+
+			  if (x[1] >= inst.L) continue;
+			  size_t n = inst.ilt(x[0], x[1], x[2]);
+
+			  if (var == "S") sol.S[n] = value;
+				else if (var == "W") sol.W[n] = value;
+				else if (var == "Dp") sol.Dp[n] = value;
+				else if (var == "Dm") sol.Dm[n] = value;
+		   }
+		   else if ((nx == 4) && (var == "V")) {
+			  if ((x[0] >= 0) && (x[0] < inst.I) && (x[1] >= 0) && (x[1] < inst.L) &&
+				  (x[2] >= 0) && (x[2] < inst.L) && (x[3] >= 0) && (x[3] < inst.T))
+				 sol.setV(x[0], x[1], x[2], x[3], value);
+		   }
+	  }
+
+	  return found;
+}
+
+
+
+
+//Print the validation of the solution in the output file
+inline void PrintValidation(std::ostream &out, const RCLSPMSL_Validation &v)
+{
+	  out << "****************************** Validation of the Solution ***************************" << std::endl;
+	  out << std::endl;
+	  out << "Tolerance = " << v.tol << std::endl;
+	  out << std::endl;
+
+	  for(int f = 0; f < VAL_NFAMILIES; f++)
+		 out << "Violated " << ValidationFamily(f) << " = " << v.violations[f] << " (max = " << v.maxViolation[f] << ")" << std::endl;
+
+	  out << std::endl;
+	  out << "Total Violated Constraints = " << v.total() << std::endl;
+	  out << "Recalculated Objective Function Value = " << v.costs.OF << std::endl;
+
+	  if (!v.messages.empty()) {
+		 out << std::endl;
+		 for(size_t m = 0; m < v.messages.size(); m++)
+			out << v.messages[m] << std::endl;
+	  }
+
+	  out << std::endl;
+	  out << "*************************************************************************************" << std::endl;
+}
+
+
+#endif
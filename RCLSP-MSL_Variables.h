@@ -0,0 +1,122 @@
+// ************************************************************************************* //
+//     Variables of the Facility Location Reformulation of the General Capacitated      //
+//      Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) created on       //
+//                                   demand                                             //
+//	 																					 //
+//	  A family of variables keeps only empty handles, and each variable is created	 //
+//	  the first time that a constraint or the objective function uses it. Then		 //
+//	  the memory of the optimization package grows with the variables used by the		 //
+//	  models actually solved, and not with the size of the whole family				 //
+// ************************************************************************************* //
+
+
+#ifndef RCLSPMSL_VARIABLES_H
+#define RCLSPMSL_VARIABLES_H
+
+
+#include <ilcplex/ilocplex.h>
+#include <vector>
+#include <string>
+#include <stdio.h>
+
+
+
+class RCLSPMSL_LazyVars {
+
+public:
+
+	  //Family name[n1][n2][n3][n4] of variables with bounds lb and ub
+	  //(families with less indexes have n3 = n4 = 1 or n4 = 1)
+	  RCLSPMSL_LazyVars(IloEnv environment, const char *name, IloNum lb, IloNum ub,
+						IloInt n1, IloInt n2 = 1, IloInt n3 = 1, IloInt n4 = 1)
+		  : env(environment), prefix(name), lower(lb), upper(ub), nCreated(0) {
+
+		  n[0] = n1; n[1] = n2; n[2] = n3; n[3] = n4;
+
+		  dims = 4;
+		  while ((dims > 1) && (n[dims-1] == 1)) dims--;
+
+		  var.resize((size_t)n1*n2*n3*n4);
+	  }
+
+
+	  //Variable of the indexes, created if it is used for the first time
+	  IloNumVar operator()(IloInt a, IloInt b = 0, IloInt c = 0, IloInt d = 0) {
+		  IloNumVar &x = var[index(a, b, c, d)];
+
+		  if (x.getImpl() == 0) {
+			 char varname[40];
+			 IloInt ind[4] = { a, b, c, d };
+
+			 std::string s(prefix);
+			 for(int m = 0; m < dims; m++){
+				sprintf(varname, "_%d", (int)ind[m]);
+				s += varname;
+			 }
+
+			 x = IloNumVar(env, lower, upper, s.c_str());
+			 nCreated++;
+		  }
+
+		  return x;
+	  }
+
+
+	  //Check if the variable was already created
+	  bool has(IloInt a, IloInt b = 0, IloInt c = 0, IloInt d = 0) const {
+		  return (var[index(a, b, c, d)].getImpl() != 0);
+	  }
+
+
+	  //Value of the variable in the solution of the problem
+	  //(a variable not created is not in the problem, and it is zero)
+	  IloNum value(IloCplex cplex, IloInt a, IloInt b = 0, IloInt c = 0, IloInt d = 0) const {
+		  const IloNumVar &x = var[index(a, b, c, d)];
+		  return (x.getImpl() == 0) ? 0 : cplex.getValue(x);
+	  }
+
+
+	  //Add the variables created to the array all, in the order of the indexes
+	  void collect(IloNumVarArray all) const {
+		  for(size_t m = 0; m < var.size(); m++)
+			 if (var[m].getImpl() != 0) all.add(var[m]);
+	  }
+
+
+	  //Number of variables created and size of the family
+	  size_t created() const { return nCreated; }
+	  size_t size() const { return var.size(); }
+
+
+	  //Free the variables created
+	  void end() {
+		  for(size_t m = 0; m < var.size(); m++)
+			 if (var[m].getImpl() != 0) var[m].end();
+
+		  var.clear();
+		  nCreated = 0;
+	  }
+
+
+
+private:
+
+	  IloEnv env;
+	  std::string prefix;
+	  IloNum lower, upper;
+
+	  IloInt n[4];
+	  int dims;
+
+	  std::vector<IloNumVar> var;
+	  size_t nCreated;
+
+
+	  size_t index(IloInt a, IloInt b, IloInt c, IloInt d) const {
+		  return (((size_t)a*n[1] + b)*n[2] + c)*n[3] + d;
+	  }
+
+};
+
+
+#endif
@@ -1,1606 +1,2171 @@
-// ************************************************************************************* //
-//    Program to solve the Facility Location Reformulation of the General Capacitated    //
-//             Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)            //
-//                              by a Relax-and-Fix Heuristic                             //
-//	 																					 //
-//	  Used in Gislaine Mara Melega Pos-doctoral											 //
-//    Copyright 2020 - date:  04/2022													 //
-// ************************************************************************************* //
-
-
-
-//Libraries
-//#include <stdafx.h>
-#include <ilcplex/ilocplex.h>
-#include <ilconcert/iloexpression.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include <time.h>
-#include <iostream>
-#include <cstdlib>
-#include <vector>
-
-
-
-//macro necessary for portability
-ILOSTLBEGIN	
-
-
-
-// ********************************************************************************************** //
-// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
-// ********************************************************************************************** //
-
-
-int main(int argc, char **argv)
-{
-   
-    //Input Data File
-    ifstream in(argv[1]);
-
-
-    //Output Data File 1
-    ofstream out(argv[2]);
-
-
-    //Problem enviroment: env
-    IloEnv env;
-
-
-    try{  
-
-
-          int  t, i, l,													  //indexes to: time periods, items, locations
-			 
-			   j, k, tau;												  //other indexes
-
-		  
-		  //Variables name
-		  char setupitem[15];											  //setup of item
-		  char proditem[15];											  //production of item
-		  char stockitemloc[15];										  //stock of item in location
-
-		  char setuplocation[15];									      //setuplocation
-		  char inflowitem[15];											  //inflow of item in location 
-		  char outflowitem[15];											  //outflow of item in location
-		  char assignitemlocation[15];									  //assignment of item to storage location
-		  char relocationitem[15];										  //relocation of item between locations
-
-		  char facilityref[15];											  //facility location reformulation
-
-
-
-// *********************************** // 
-//      Creation of the Parameters     //
-//    and Data Read from Input File    // 
-// *********************************** //
-
-
-		  //Indexes
-		  //Time period
-		  IloInt T;
-		  
-		  //Items
-		  IloInt I;
-
-		  //Locations
-		  IloInt L;
-
-
-
-		  //Read only the indexes
-		  //to create the parameters
-		  if (in) {
-
-				     in  >>  T;
-				     in  >>  I;
-				     in  >>  L;
-
-		  }
-	        else {
-                    cerr << "No such file: " << "dataRCLSPMSL.dat" << endl;
-                    throw(1);
-			}
-
-          // *************************************************************
-
-
-		  //Production of Items
-		  //Production cost per unit of item
-          IloNumArray vc(env, I);
-
-          //Setup cost of item 
-		  IloNumArray sc(env, I);										
-
-		  //Inventory holding cost per unit of item
-		  IloNumArray hc(env, I);
-
-		  //Production consumption of capacity per unit of item 
-		  IloNumArray vt(env, I);
-
-		  //Setup time consumption of capacity of item 
-		  //IloNumArray st(env, I);
-
-		  //Production capacity in each period
-		  IloNumArray Cap(env, T);
-
-		  //Demand to be fulfilled of item i in period t
-		  IloArray<IloNumArray> d(env, I);
-		  for(i=0; i<I; i++)
-		     d[i] = IloNumArray(env, T);					
-
-
-		  //Inventory of items
-		  //Fixed cost of having a positive
-		  //inventory level at location l
-		  IloNumArray g(env, L);
-
-		  //Unit handling cost of item i at location l
-		  IloArray<IloNumArray> ha(env, I);
-		  for(i=0; i<I; i++)
-		     ha[i] = IloNumArray(env, L);	
-
-		  //Consumption of storage capacity per unit of item
-		  IloNumArray cs(env, I);
-
-		  //Storage capacity of each location in each period
-		  IloNumArray H(env, L);
-
-		  //Compatibility between item i and locations l
-		  IloArray<IloNumArray> alpha(env, I);
-		  for(i=0; i<I; i++)
-		     alpha[i] = IloNumArray(env, L);	
-
-		  //Compatibility between item i an j
-		  IloArray<IloNumArray> beta(env, I);
-		  for(i=0; i<I; i++)
-		     beta[i] = IloNumArray(env, I);	
-
-		  //Unit moving cost of item i
-		  //from location k to location l 
-		  IloArray<IloArray<IloNumArray> > r(env, I);
-		  for(i=0; i<I; i++){
-		     r[i] = IloArray<IloNumArray> (env, L); 
-		     for(l=0; l<L; l++){
-		        r[i][l] = IloNumArray(env, L);
-			 }								
-		  }          
-
-
-		  //Big M
-		  IloInt BigM;
-
-
-
-		  //Read the remaining parameters
-		  if (in) {
-			          
-				     for(t=0; t<T; t++)
-					    in >> Cap[t];
-
-					 
-					 for(i=0; i<I; i++){
- 					    in >> vc[i];
-						in >> sc[i];
-						in >> hc[i];
-						in >> vt[i];
-						in >> cs[i];
-					 }
-
-
-					 for(i=0; i<I; i++)
-					    for(t=0; t<T; t++)
-						   in >> d[i][t];
-
-
-					 for(l=0; l<L; l++){
-					    in >> H[l];
-						in >> g[l];
-					 }
-
-
-					 for(i=0; i<I; i++)
-				        for(l=0; l<L; l++)
-						   in >> ha[i][l];
-
-
-					 for(i=0; i<I; i++)
-				        for(l=0; l<L; l++)
-						   in >> alpha[i][l];
-
-
-					 for(i=0; i<I; i++)
-                        for(j=0; j<I; j++)
-						   in >> beta[i][j];				   
-
-
-					 for(i=0; i<I; i++)
-					    for(l=0; l<L; l++)
-						   for(k=0; k<L; k++)
-						      in >> r[i][l][k];
-
-
-          }//end if(in)
-	        else {
-                    cerr << "No such file: " << "dataRCLSPMSL.dat" << endl;
-                    throw(1);
-			}
-
-// ***********************************************************************
-
-
-	 
-
-
-// ************************ // 
-//    Create the Problem    // 
-// ************************ //
-
-
-		  //Problem
-		  IloModel Pmodel(env);
-
-
-		  //All the variables are considered linear (relaxed values)
-
-		  //Production of item i in period t
-		  IloArray<IloNumVarArray> X(env, I);
-		  for(i=0; i<I; i++){
-		     X[i] = IloNumVarArray(env, T);
-			 for(t=0; t<T; t++){
-                sprintf(proditem, "X_%d_%d", i, t);
-				X[i][t] = IloNumVar(env, 0, IloInfinity, proditem);
-			 }
-		  }
-
-
-
-		  //Setup of item i in period t
-		  IloArray<IloNumVarArray> Y(env, I);
-		  for(i=0; i<I; i++){
-		     Y[i] = IloNumVarArray(env, T);
-			 for(t=0; t<T; t++){
-                sprintf(setupitem, "Y_%d_%d", i, t);
-				Y[i][t] = IloNumVar(env, 0, 1, setupitem);
-			 }
-		  }
-
-
-
-		  //Inventory of item i at location l in period t
-		  IloArray<IloArray<IloNumVarArray> > S(env, I);
-		  for(i=0; i<I; i++){
-		     S[i] = IloArray<IloNumVarArray> (env, L); 
-		     for(l=0; l<L; l++){ 
-		        S[i][l] = IloNumVarArray(env, T);								
-				for(t=0; t<T; t++){ 
-				   sprintf(stockitemloc, "S_%d_%d_%d", i, l, t);
-                   S[i][l][t] = IloNumVar(env, 0, IloInfinity, stockitemloc);
-				}
-			 }
-		  }
-
-
-
-		  //Use of location l in period t
-		  //i.e., there is a positive inventory
-		  //in location l at the end of period t
-		  IloArray<IloNumVarArray> Z(env, L);
-		  for(l=0; l<L; l++){
-		     Z[l] = IloNumVarArray(env, T);
-			 for(t=0; t<T; t++){
-                sprintf(setuplocation, "Z_%d_%d", l, t);
-				Z[l][t] = IloNumVar(env, 0, 1, setuplocation);
-			 }
-		  }
-
-
-
-		  //Inflow of item i at location l in period t
-		  IloArray<IloArray<IloNumVarArray> > Dp(env, I);
-		  for(i=0; i<I; i++){
-		     Dp[i] = IloArray<IloNumVarArray> (env, L); 
-		     for(l=0; l<L; l++){ 
-		        Dp[i][l] = IloNumVarArray(env, T);								
-				for(t=0; t<T; t++){ 
-				   sprintf(inflowitem, "Dp_%d_%d_%d", i, l, t);
-                   Dp[i][l][t] = IloNumVar(env, 0, IloInfinity, inflowitem);
-				}
-			 }
-		  }
-
-
-
-		  //Outflow of item i at location l in period t
-		  IloArray<IloArray<IloNumVarArray> > Dm(env, I);
-		  for(i=0; i<I; i++){
-		     Dm[i] = IloArray<IloNumVarArray> (env, L); 
-		     for(l=0; l<L; l++){ 
-		        Dm[i][l] = IloNumVarArray(env, T);								
-				for(t=0; t<T; t++){ 
-				   sprintf(outflowitem, "Dm_%d_%d_%d", i, l, t);
-                   Dm[i][l][t] = IloNumVar(env, 0, IloInfinity, outflowitem);
-				}
-			 }
-		  }
-
-
-
-		  //Assignment of item i at storage location l in period t
-		  IloArray<IloArray<IloNumVarArray> > W(env, I);
-		  for(i=0; i<I; i++){
-		     W[i] = IloArray<IloNumVarArray> (env, L); 
-		     for(l=0; l<L; l++){ 
-		        W[i][l] = IloNumVarArray(env, T);								
-				for(t=0; t<T; t++){ 
-				   sprintf(assignitemlocation, "W_%d_%d_%d", i, l, t);
-                   W[i][l][t] = IloNumVar(env, 0, 1, assignitemlocation);
-				}
-			 }
-		  }
-
-
-
-		  //Relocation of item i from location l to location k in period t
-		  IloArray<IloArray<IloArray<IloNumVarArray> > > V(env, I);
-		  for(i=0; i<I; i++){
-		     V[i] = IloArray<IloArray<IloNumVarArray> > (env, L); 
-			 for(l=0; l<L; l++){
-				 V[i][l] = IloArray<IloNumVarArray> (env, L); 
-				 for(k=0; k<L; k++){ 
-					V[i][l][k] = IloNumVarArray (env, T);
-					for(t=0; t<T; t++){
-					   sprintf(relocationitem, "V_%d_%d_%d_%d", i, l, k, t);
-					   V[i][l][k][t] = IloNumVar(env, 0, IloInfinity, relocationitem);
-					}
-				 }
-			  }
-		  }
-
-
-
-		  //Facility location reformulation 
-		  //number of units of item i produced in period t to
-		  //meet the demand in a posterior period tau, tau >= t
-		  IloArray<IloArray<IloNumVarArray> > FL(env, I);
-		  for(i=0; i<I; i++){
-		     FL[i] = IloArray<IloNumVarArray> (env, T); 
-		     for(t=0; t<T; t++){ 
-		        FL[i][t] = IloNumVarArray(env, T);								
-				for(tau = t; tau<T; tau++){ 
-				   sprintf(facilityref, "FL_%d_%d_%d", i, t, tau);
-                   FL[i][t][tau] = IloNumVar(env, 0, IloInfinity, facilityref);
-				}
-			 }
-		  }
-
-		  // *************************************************************
-
-
-
-		  //Objective Function
-		  IloExpr objective(env);
-
-
-		  //Costs of production
-		  for(t=0; t<T; t++)
-			 for(tau = t; tau<T; tau++)
-			    for(i=0; i<I; i++)
-		           objective += vc[i]*FL[i][t][tau];
-
-
-		  //Costs of setup of items
-		  for(t=0; t<T; t++)
-			 for(i=0; i<I; i++)
-		        objective += sc[i]*Y[i][t];
-
-
-		  //Cost of inventory and handling of items at storage locations
-		  for(t=0; t<T; t++)
-			 for(l=0; l<L; l++)
-			    for(i=0; i<I; i++)
-		           objective += (hc[i]*S[i][l][t] + ha[i][l]*Dp[i][l][t]);
-
-
-		  //Costs of using locations
-		  for(t=0; t<T; t++)
-		     for(l=0; l<L; l++)
-			    objective += g[l]*Z[l][t];
-
-
-		  //Cost of relocation of items between locations
-		  for(t=0; t<T; t++)
-			 for(l=0; l<L; l++)
-				for(k=0; k<L; k++)
-			       for(i=0; i<I; i++)
-			          objective += r[i][l][k]*V[i][l][k][t];
-
-
-		  //Problem objective function environment
-		  IloObjective Pof = IloMinimize(env, objective);
-
-
-          //Add the objective function (Pof) to the problem
-		  Pmodel.add(Pof);
-          objective.end();		     //delet the expression
-
-		  // *************************************************************
-
-
-
-		  //InflowOutFlow1 constraints environment
-		  IloArray<IloRangeArray> InflowOutFlow1(env, I);
-		  for(i=0; i<I; i++)
-		     InflowOutFlow1[i] = IloRangeArray(env, T);
-
-		  //InflowOutFlow1 constraints
-		  for(i=0; i<I; i++)
-		     for(t=0; t<T; t++){
-				IloExpr flow(env);
-				
-				for(tau=0; tau <= t; tau++)
-				   flow += FL[i][tau][t];
-
-			    InflowOutFlow1[i][t] = (flow == d[i][t]);
-				flow.end();
-			 }
-
-		  //Add the InflowOutFlow1 constraints to the problem
-		  for(i=0; i<I; i++){
-             InflowOutFlow1[i].setNames("InflowOutFlow1");
-	         Pmodel.add(InflowOutFlow1[i]);
-		  }
-
-
-
-
-
-		  //InflowOutFlow2 constraints environment
-		  IloArray<IloRangeArray> InflowOutFlow2(env, I);
-		  for(i=0; i<I; i++)
-		     InflowOutFlow2[i] = IloRangeArray(env, T);
-
-		  //InflowOutFlow2 constraints
-		  for(i=0; i<I; i++)
-		     for(t=0; t<T; t++){
-				IloExpr flow(env);
-				
-				for(tau = t; tau<T; tau++)
-				   flow += FL[i][t][tau];
-
-				flow -= d[i][t];
-
-				for(l=0; l<L; l++)
-				   flow -= Dp[i][l][t] - Dm[i][l][t];
-
-			    InflowOutFlow2[i][t] = (flow == 0);
-				flow.end();
-			 }
-
-		  //Add the InflowOutFlow2 constraints to the problem
-		  for(i=0; i<I; i++){
-             InflowOutFlow2[i].setNames("InflowOutFlow2");
-	         Pmodel.add(InflowOutFlow2[i]);
-		  }
-
-
-
-
-		  
-		  //BalanceLocation constraint environment
-		  IloArray<IloArray<IloRangeArray> > BalanceLocation(env, I);
-		  for(i=0; i<I; i++){
-		     BalanceLocation[i] = IloArray<IloRangeArray>(env,L);
-		     for(l=0; l<L; l++){
-		        BalanceLocation[i][l] = IloRangeArray(env, T);
-			 }
-		  }
-
-		  //BalanceLocation constraint
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++)
-		        for(t=0; t<T; t++){
-		           IloExpr balance(env);
-
-				   if (t == 0) {
-								  balance += Dp[i][l][t] - S[i][l][t] - Dm[i][l][t];
-
-								  for(k=0; k<L; k++)
-									 balance += V[i][k][l][t] - V[i][l][k][t];
-
-								  BalanceLocation[i][l][t] = (balance == 0);
-								  balance.end();
-					}
-					  else {
-
-								  balance += S[i][l][t-1] + Dp[i][l][t] - S[i][l][t] - Dm[i][l][t];
-
-								  for(k=0; k<L; k++)
-								     balance += V[i][k][l][t] - V[i][l][k][t];
-
-								  BalanceLocation[i][l][t] = (balance == 0);
-								  balance.end();
-					  }
-				}
-
-		  //Add the BalanceLocation constraint to the problem
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++){
-                BalanceLocation[i][l].setNames("BalanceLocation");
-	            Pmodel.add(BalanceLocation[i][l]);
-			 }
-
-
-
-
-
-		  //Setup constraints environment
-		  IloArray<IloArray<IloRangeArray> > Setup(env, I);
-		  for(i=0; i<I; i++){
-		     Setup[i] = IloArray<IloRangeArray>(env, T);
-		     for(t=0; t<T; t++){
-		        Setup[i][t] = IloRangeArray(env, T);
-			 }
-		  }
-
-		  //Setup constraints
-		  for(i=0; i<I; i++)
-		     for(t=0; t<T; t++)
-			    for(tau = t; tau<T; tau++){
-			       IloExpr set(env);
-				
-                   set += FL[i][t][tau] - d[i][tau]*Y[i][t];
-
-			    Setup[i][t][tau] = (set <= 0);
-				set.end();
-		     }
-
-		  //Add the Setup constraints to the problem
-		  for(i=0; i<I; i++)
-		     for(t=0; t<T; t++)
-			    for(tau = t; tau<T; tau++){
-                   Setup[i][t][tau].setName("Setup");
-	               Pmodel.add(Setup[i][t][tau]);
-				}
-
-
-		  
-
-
-		  //Capacity constraints environment
-		  IloRangeArray Capacity(env, T);
-
-		  //Capacity constraints
-		  for(t=0; t<T; t++){
-		     IloExpr cap(env);
-
-			 for(i=0; i<I; i++)
-			    for(tau = t; tau<T; tau++)
-			       cap += vt[i]*FL[i][t][tau]; 
-
-			 Capacity[t] = (cap <= Cap[t]);
-			 cap.end();
-		  }
-
-		  //Add the Capacity constraints to the problem
-          Capacity.setNames("Capacity");
-	      Pmodel.add(Capacity);
-
-
-
-
-
-		  //InvAlloc constraints enviroment
-		  IloArray<IloArray<IloRangeArray> > InvAlloc(env, I);
-		  for(i=0; i<I; i++){
-		     InvAlloc[i] = IloArray<IloRangeArray>(env,L);
-		     for(l=0; l<L; l++){
-		        InvAlloc[i][l] = IloRangeArray(env, T);
-			 }
-		  }
-
-		  //InvAlloc constraints
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++)
-				for(t=0; t<T; t++){
-				   IloExpr alloc(env);
-
-				   //Calculate the bigM 
-				   int sumd = 0; 
-				   double allocitem = 0;
-
-				   //Sum of the demand
-				   for(tau=t; tau<T; tau++)
-				      sumd += d[i][tau];
-
-				   //Allocation of items
-				   allocitem = (H[l]/cs[i]);
-
-				   //Choose the smallest value between the sum
-				   //of the demand and allocation of items
-				   if (sumd <= allocitem) BigM = sumd;
-				     else BigM = allocitem;
-
-
-                   alloc += S[i][l][t] - BigM*W[i][l][t];
-
-			       InvAlloc[i][l][t] = (alloc <= 0);
-				   alloc.end();
-				}
-
-		  //Add the InvAlloc constraints to the problem
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++){
-                InvAlloc[i][l].setNames("InvAlloc");
-	            Pmodel.add(InvAlloc[i][l]);
-			 }
-
-
-
-
-
-		  //CapacityStorage constraints environment
-    	  IloArray<IloRangeArray> CapacityStorage(env, L); 
-	      for(l=0; l<L; l++){
-		     CapacityStorage[l] = IloRangeArray(env, T);
-		  }
-
-		  //CapacityStorage
-		  for(l=0; l<L; l++)
-		     for(t=0; t<T; t++){
-			    IloExpr cap(env);
-
-				for(i=0; i<I; i++)
-				   cap += cs[i]*S[i][l][t];
-
-				cap -= H[l]*Z[l][t];
-			    
-				CapacityStorage[l][t] = (cap <= 0);
-				cap.end();
-			 }
-
-		  //Add the CapacityStorage constraints to the problem
-		  for(l=0; l<L; l++){
-             CapacityStorage[l].setNames("CapacityStorage");
-	         Pmodel.add(CapacityStorage[l]);
-		  }
-
-
-
-
-
-		  //ItemLocatCompat constraints enviroment
-		  IloArray<IloArray<IloRangeArray> > ItemLocatCompat(env, I);
-		  for(i=0; i<I; i++){
-		     ItemLocatCompat[i] = IloArray<IloRangeArray>(env,L);
-		     for(l=0; l<L; l++){
-		        ItemLocatCompat[i][l] = IloRangeArray(env, T);
-			 }
-		  }
-
-		  //ItemLocatCompat constraints
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++)
-				for(t=0; t<T; t++){
-				   IloExpr comp(env);
-
-                   comp += W[i][l][t];
-
-			       ItemLocatCompat[i][l][t] = (comp <= alpha[i][l]);
-				   comp.end();
-			 }
-
-		  //Add the ItemLocatCompat constraints to the problem
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++){
-                ItemLocatCompat[i][l].setNames("ItemLocatCompat");
-	            Pmodel.add(ItemLocatCompat[i][l]);
-			 }
-
-
-
-
-
-		  //ItemItemCompat constraints enviroment
-		  IloArray<IloArray<IloArray<IloRangeArray> > > ItemItemCompat(env, I);
-		  for(i=0; i<I; i++){
-             ItemItemCompat[i] = IloArray<IloArray<IloRangeArray> >(env, I);
-             for(j=i; j<I; j++){
-		        ItemItemCompat[i][j] = IloArray<IloRangeArray>(env,L);
-		        for(l=0; l<L; l++){
-		           ItemItemCompat[i][j][l] = IloRangeArray(env, T);
-				}
-			 }
-		  }
-
-		  //ItemItemCompat constraints
-		  for(i=0; i<I; i++)
-			 for(j=i; j<I; j++)
-		        for(l=0; l<L; l++)
-				   for(t=0; t<T; t++){
-				      IloExpr comp(env);
-
-                      comp += W[i][l][t] + W[j][l][t];
-
-			          ItemItemCompat[i][j][l][t] = (comp <= beta[i][j] + 1);
-				      comp.end();
-				   }
-
-		  //Add the ItemItemCompat constraints to the problem
-		  for(i=0; i<I; i++)
-			 for(j=i; j<I; j++)
-		        for(l=0; l<L; l++){
-                   ItemItemCompat[i][j][l].setNames("ItemItemCompat");
-	               Pmodel.add(ItemItemCompat[i][j][l]);
-				}
-
-		  // *************************************************************
-
-
-		  //Define CPLEX environment to the problem
-          IloCplex Pcplex(Pmodel);
-
-
-// ***********************************************************************
-
-
-
-
-
-// ************************************************************************* //
-//    Solve the Linear Relaxation of the Reformulated General Capacitated    //
-//       Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
-//                         by an Optimization Package                        //
-// ************************************************************************* //
-
-
-		  //Objective function value and computational
-		  //time of the linear relaxation problem
-		  double  OF_LR_RCLSPMSL = 0, Time_LR_RCLSPMSL = 0;
-
-
-
-          // ***** Solve the LR_CLSP-MSL *********************************
-
-		  //Add CPLEX Options
-          //Print the output and warnings 
-		  //of cplex in the output file
-          Pcplex.setOut(out);
-          Pcplex.setWarning(out);
-
-
-		  //Limite the number of threads in
-		  //the solution of the linear relation
-		  Pcplex.setParam(IloCplex::Threads, 1);
-
-
-
-		  //Extract the model
-		  //Pcplex.extract(Pmodel);
-		  //Export the model
-		  //Pcplex.exportModel("model.lp" );
-
-	 
-		  
-          // ****************************************************************************************************
-		  out << "***** The Facility Location Reformulation of the General Capacitated Lot-Sizing *****" << endl;
-		  out << "*****            Problem with Multiple Storage Locations (RCLSP-MSL)            *****" << endl;       
-		  out << "*****                    solved by a Relax-and-Fix Heuristic                    *****" << endl;
-		  out << endl << endl;
-		  out << "* Lower Bound: Linear Relaxation" << endl;
-		  out << "* Upper Bound: Relax-and-Fix Heuristic (time-oriented decomposition)" << endl;
-		  out << endl << endl << endl << endl << endl;
-		  out << "*********** Lower Bound: Solve the LR_RCLSP-MSL by an Optimization Package **********" << endl;
-		  out << endl << endl;
-
-
-		  //SOLVE the LR_RCLSP-MSL
-          Pcplex.solve();
-
-
-		  out << endl << endl << endl;
-		  // ****************************************************************************************************	  
-
-
-
-
-
-		  // ***** Check the Solution Status *****************************
-
-		  
-		  //Check if the solution of the Linear Relaxation is
-		  //Optimal-1 or Feasible-2
-		  if ((Pcplex.getStatus() == IloAlgorithm::Optimal) || 
-			  (Pcplex.getStatus() == IloAlgorithm::Feasible)) {
-	
-
-					//Recover the objective function value
-				    //of the linear relation problem
-					OF_LR_RCLSPMSL = Pcplex.getValue(Pof);
-
-
-					//Recover the time to solve 
-					//the linear relaxation problem
-					Time_LR_RCLSPMSL = Pcplex.getTime();
-
-					
-
-					// ****************************************************************************************************
-					//Print in the output file
-					out << "***** Solution to the Linear Relaxation of the Reformulated General Capacitated *****" << endl;
-					out << "*****             Lot-Sizing Problem with Multiple Storage Locations            *****" << endl;
-					out << endl << endl;
-					out << "Solution Status LR = " << Pcplex.getStatus() << endl;
-					out << "Objective Function Value LR = " << OF_LR_RCLSPMSL << endl; 
-					out << "Time LR = " << Time_LR_RCLSPMSL << endl;	 
-					out << endl << endl;
-					out << "*************************************************************************************" << endl;
-					out << endl << endl << endl << endl << endl << endl << endl << endl << endl << endl;
-					// ****************************************************************************************************
-
-
-		  }//end if Optimal-1/Feasible-2
-		    
-		    else {
-				    // ****************************************************************************************************
-					//Print in the output file
-					out << "***** Solution to the Linear Relaxation of the Reformulated General Capacitated *****" << endl;
-					out << "*****             Lot-Sizing Problem with Multiple Storage Locations            *****" << endl;
-					out << endl << endl;
-					out << "Solution Status LR = " << Pcplex.getStatus() << endl;
-					out << "NO Solution to the Linear Relaxation Problem" << endl;
-					out << endl << endl;
-					out << "*************************************************************************************" << endl;
-					out << endl << endl << endl << endl << endl << endl << endl << endl << endl << endl;
-					// ****************************************************************************************************
-
-			}//end else
-
-// ***********************************************************************
-
-
-
-
-
-// ******************************************************************* //
-//    Solve the Reformulated General Capacitated Lot-Sizing Problem    // 
-//			   with Multiple Storage Locations (RCLSP-MSL)			   //
-//                     by a Relax-and-Fix Heuristic                    //
-// ******************************************************************* //
-
-
-		  //The Relax-and-Fix Heuristic considers a time-oriented decomposition.
-		  //For each time-window the whole set of items and locations are considered 
-		  //and the resulting RCLSP-MSL problem is solved by an optimization package (CPLEX)
-
-
-		  int checkRFH_lastWindow;   									  //check in the Relax-and-Fix Heuristic if it is the last window
-																		  //(0-no; 1-yes)
-
-
-		  int T_WindowSize,												  //number of periods in the time-window (T_WindowSize = T_Fix + T_Overlap),
-			 
-			  T_Fix,													  //number of periods in the time-window that are fixed 
-		     
-			  T_Overlap;												  //number of periods in the time-window that overlap  
-		 
-
-		  int T_int_begin, T_int_end;								 	  //interval of periods where the binary variables are integer
-
-
-		  double TotalTime,
-		
-			     timeWindow,											  //time avaialable for each window (total time/number of windows)
-
-				 timeWindow_RFH,										  //time available for each window considering the time left of other windows
-			    		        
-				 timeWindow_begin,										  //beginning time to solve the window in the Relax-and-Fix Heuristic
-			    
-				 timeWindow_end,										  //end time to solve the window in the Relax-and-Fix Heuristic
-			    
-				 timeWindow_used,										  //time spent in the resolution of a window in the Relax-and-Fix Heuristic
-				
-				 timeWindow_left;										  //time left in the resolution of a window in the Relax-and-Fix Heuristic
-
-
-		  double  OF_RFH, 												  //objective function value in the Relax-and-Fix Heuristic
-				 
-			      Gap_RFH,												  //gap in the Relax-and-Fix Heuristic
-		         
-			 	  Time_RFH;												  //computational time spent in the Relax-and-Fix Heuristic
-
-
-
-
-								
-		  // *************************************************************
-		  //Assigning the main values to the Relax-and-Fix Heuristic
-		  //Procedure with a Time-Oriented Decompostion 
- 
-		  //Note: T_WindowSize = T_Fix + T_Overlap
-
-		  T_WindowSize = 5;
-		  T_Fix = 2;
-		  T_Overlap = 3;
-		  T_int_begin = 0;
-		  T_int_end = T_int_begin + T_WindowSize;
-		  TotalTime = 1800;
-		  // *************************************************************
-
-
-
-		  // ****************************************************************************************************
-		  //Print in the output file
-		  out << "*************** Upper Bound: Beginning of the Relax-and-Fix Heuristic ***************" << endl;
-          out << "***************            with Time-Oriented Decomposition           ***************" << endl;
-		  out << endl << endl;
-          out << "Parameters: time-window = " << T_WindowSize << endl;
-          out << "            time-fixed = " << T_Fix << endl; 
-          out << "            time-overlapping = " << T_Overlap << endl;  
-          out << endl << endl << endl;
-		  // ****************************************************************************************************
-
-
-
-		  //Check if the last window in the 
-		  //Relax-and-Fix Heuristic is reached
-		  //(0-no; 1-yes)
-		  checkRFH_lastWindow = 0;
-
-
-		 
-		  //Calculate the total number of windows in 
-		  //the Relax-and-Fix Heuristic in order to
-		  //calculate the time allocated to each window
-		  int nit, tt_b, tt_e;
-
-		  tt_b = 0;
-		  tt_e = tt_b + T_WindowSize;
-		  nit = 0;
-
-		  do{
-		       nit = nit + 1;
-			   tt_b = tt_e - T_Overlap;
-			   tt_e = tt_b + T_WindowSize;
-
-		  } while (tt_e < T);
-		 
-
-		  //Total number of windows
-		  nit = nit + 1;
-
-
-		  //Time available in each time-window
-		  timeWindow = TotalTime/nit;
-		  timeWindow_RFH = timeWindow;
-
-
-
-
-
-		  //Create the parameters that recover the 
-		  //binary values in the Relax-and-Fix Heuristic
- 	      IloArray<IloNumArray> Y_fix(env, I);
-		  for(i=0; i<I; i++)
-		     Y_fix[i] = IloNumArray(env, T, 0, 1, ILOINT);
-
-
- 	      IloArray<IloNumArray> Z_fix(env, L);
-		  for(l=0; l<L; l++)
-		     Z_fix[l] = IloNumArray(env, T, 0, 1, ILOINT);
-
-
-		  IloArray<IloArray<IloNumArray> > W_fix(env, I);
-		  for(i=0; i<I; i++){
-		     W_fix[i] = IloArray<IloNumArray> (env, L); 
-		     for(l=0; l<L; l++){ 
-		        W_fix[i][l] = IloNumArray(env, T, 0, 1, ILOINT);								
-			 }
-		  }
-
-
-
-		  //Initialize the parameters == 0
-		  for(t=0; t<T; t++)
-		     for(i=0; i<I; i++){
-			    Y_fix[i][t] = 0;
-
-			    for(l=0; l<L; l++){
-		           W_fix[i][l][t] = 0;
-				   Z_fix[l][t] = 0;
-				}
-			 }
-
-
-		 
-		  //Create the constraints that fix the binary variables 
-		  //to their binary values in the Relax-and-Fix Heuristic		 		
-		  IloArray<IloRangeArray> RestFixY(env, I); 
-	      for(i=0; i<I; i++)
-		     RestFixY[i] = IloRangeArray(env, T);
-
-
-		  IloArray<IloRangeArray> RestFixZ(env, L); 
-	      for(l=0; l<L; l++)
-		     RestFixZ[l] = IloRangeArray(env, T);
-
-
-    	  IloArray <IloArray<IloRangeArray> > RestFixW(env, I);
-		  for(i=0; i<I; i++){
-		     RestFixW[i] = IloArray<IloRangeArray>(env, L);
-		     for(l=0; l<L; l++){
-			    RestFixW[i][l] = IloRangeArray(env, T);
-			 }
-		  }	
-
-		  
-
-		  //Consider the integrality of the binary variables 
-		  //in the first T_Overlap periods of the time-window
-
-		  //Converte the linear variables to binary variables
-		  for(i=0; i<I; i++)
-		     for(t=T_int_begin; t<T_Overlap; t++)
-		        Pmodel.add(IloConversion(env, Y[i][t], ILOBOOL));
-
-	 
-		  for(l=0; l<L; l++)
-			 for(t=T_int_begin; t<T_Overlap; t++)
-			    Pmodel.add(IloConversion(env, Z[l][t], ILOBOOL));
-
-
-		  for(i=0; i<I; i++)
-		     for(l=0; l<L; l++)
-				for(t=T_int_begin; t<T_Overlap; t++)
-		           Pmodel.add(IloConversion(env, W[i][l][t], ILOBOOL));
-	
-
-
-
-
-		 //LOOP Relax-and-Fix Heuristic
-		 for(; ;){
-		    
-
-
-				  //Consider the integrality of the binary variables 
-			      //from (T_int_begin+T_Overlap) to T_int_end, that is,
-				  //the integrality in those variables added in each window
-
-			      //Converte the linear variables to binary variables
-				  for(i=0; i<I; i++)
-					 for(t = (T_int_begin+T_Overlap); t<T_int_end; t++)
-						Pmodel.add(IloConversion(env, Y[i][t], ILOBOOL));
-
-	 
-				  for(l=0; l<L; l++)
-					 for(t = (T_int_begin+T_Overlap); t<T_int_end; t++)
-						Pmodel.add(IloConversion(env, Z[l][t], ILOBOOL));
-
-
-				  for(i=0; i<I; i++)
-					 for(l=0; l<L; l++)
-						for(t = (T_int_begin+T_Overlap); t<T_int_end; t++)
-						   Pmodel.add(IloConversion(env, W[i][l][t], ILOBOOL));
-
-
-
-				  // ***** Solve the Resulting RCLSP-MSL *****************
-
-				  //Add CPLEX Options 
-				  //Print the output and warnings 
-		          //of cplex in the output file
-				  Pcplex.setOut(out);
-				  Pcplex.setWarning(out);
-
-
-				  //Limite the number of threads
-				  //in the solution of the problem
-				  Pcplex.setParam(IloCplex::Threads, 1);
-
-
-				  //Dedecide what CPLEX reports to the screen 
-				  //during the solution of the problem
-				  Pcplex.setParam(IloCplex::MIPDisplay, 3);
-
-
-				  //Constrol the frequency of displaying node  
-				  //logging in the solution of the problem
-				  //0 - default: CPLEX's choice; 
-				  //n > 0: display new incumbents and every n nodes
-				  Pcplex.setParam(IloCplex::MIPInterval, 1000);
-
-
-				  //Set the maximum time (sec) 
-				  //to solve the problem
-		 		  Pcplex.setParam(IloCplex::TiLim, timeWindow_RFH);
-
-
-				  //Set a relative tolerance on the gap 
-				  //between the best integer objective and 
-				  //the objective of the best node remaining
-				  //CPLEX default: 1e-04 = 0.0001
-				  //Pcplex.setParam(IloCplex::EpGap, 0.001);
-
-
-
-				  //Recover the time in
-				  //the beginning of window
-				  timeWindow_begin = Pcplex.getTime();
-
-
-
-				  // ****************************************************************************************************
-				  //Print in the output file
-				  out << "******* Solving the Resulting RCLSP-MSL problem in the Relax-and-Fix Heuristic ******" << endl;
-				  out << endl << endl;
-
-
-				  //SOLVE the resulting RCLSP-MSL problem
-				  Pcplex.solve();
-
-
-				  out << endl << endl << endl;
-				  // ****************************************************************************************************
-
-				  
-
-
-				  //Recover the time in
-				  //the end of window
-				  timeWindow_end = Pcplex.getTime();
-
-
-				  //Calculate the time used in the window
-				  timeWindow_used = timeWindow_end - timeWindow_begin;
-
-				  
-				  //Calculate the time left in the window
-				  //after the solution of the resulting problem
-				  timeWindow_left = timeWindow_RFH - timeWindow_used; 
-
-				  
-				  //Add the time left in the window to the next window
-				  timeWindow_RFH = timeWindow + timeWindow_left;
-
-
-
-				  // ***** Check the Solution ****************************
-				  
-				  //The Relax-and-Fix Heuristic stops by infeasiblity
-				  //in one of the resulting problems or by reaching
-				  //the last iteration of the Relax-and-Fix Heuristic
-
-
-				  //The Relax-and-Fix Heuristic STOPS by infeasibility
-				  if (Pcplex.getStatus() == IloAlgorithm::Infeasible) {
-
-								  // ****************************************************************************************************
-								  //Print in the output file
-								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
-								  out << endl << endl << endl << endl << endl << endl << endl;
-								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
-							      out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
-							      out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
-								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
-								  out << endl << endl;
-							  	  out << "Solution Status = " << Pcplex.getStatus() << endl;
-								  out << "The Relax-and-Fix Heuristic is INFEASIBLE" << endl;
-								  out << "   using a time-oriented decomposition   " << endl;	 
-								  out << endl << endl;
-								  out << "*************************************************************************************" << endl;
-								  // ****************************************************************************************************
-
-
-								  break;								  //STOP the Relax-and-Fix Heuristic by infeasibility
-				  
-
-				  }//end if infeasibility
-
-
-
-
-
-				  //The Relax-and-Fix Heuristic STOPS by reaching
-				  //the last iteration and return the final solution 
-				  //of the Relax-and-Fix Heuristic to the RCLSP-MSL
-				  if (checkRFH_lastWindow == 1) {
-
-
-				      //Check if the solution of the Problem is 
-					  //Optimal-1 or Feasible-2
-					  //The final solution of the Relax-and-Fix Heuristic 
-					  //is a feasible solution to the RCLSP-MSL
-					  if ((Pcplex.getStatus() == IloAlgorithm::Optimal) || 
-						  (Pcplex.getStatus() == IloAlgorithm::Feasible)) {
-
-
-			  					  //The objective function value
-								  OF_RFH = Pcplex.getValue(Pof);
-
-
-								  //Computational time 
-								  Time_RFH = Pcplex.getTime();
-
-
-								  //Calculate the gap considering the
-								  //linear relaxation as the lower bound
-								  Gap_RFH = 100*((OF_RFH - OF_LR_RCLSPMSL)/OF_RFH);
-
-
-					  
-								  // ************************ //
-								  //    Other Calculations    // 
-								  // ************************ //
-
-
-								  double CSetupItem = 0,
-										 CInventItem = 0,
-										 CHandItem = 0, 
-										 CSetupLocal = 0, 
-										 CRelocItem = 0,
-							 
-										 NSetupItem = 0,
-										 NInventItem = 0,
-										 NHandItem = 0,
-										 NLocalUsed = 0,
-										 NRelocItem = 0,
-
-										 TotalOpenSpace = 0,
-										 TotalUsedSpace = 0,
-										 PercUsedSpace = 0;
-
-
-
-								  //Cost and number of setups 
-								  //in the production of items
-								  for(t=0; t<T; t++)
-									 for(i=0; i<I; i++)
-										if (Pcplex.getValue(Y[i][t]) > 0.00001) {
-										   CSetupItem += sc[i]*(Pcplex.getValue(Y[i][t]));
-
-										   NSetupItem += Pcplex.getValue(Y[i][t]);
-										}
-
-
-								  //Inventory costs of items
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(S[i][l][t]) > 0.00001){
-											  CInventItem += hc[i]*(Pcplex.getValue(S[i][l][t]));
-
-											  NInventItem += Pcplex.getValue(S[i][l][t]);
-										   }
-
-
-								  //Number and cost of handled items
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(Dp[i][l][t]) > 0.00001) {
-											  CHandItem += ha[i][l]*(Pcplex.getValue(Dp[i][l][t]));
-
-											  NHandItem += Pcplex.getValue(Dp[i][l][t]);
-										   }
-
-
-
-								  //Number and setup cost of used locations
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										if (Pcplex.getValue(Z[l][t]) > 0.00001) {
-										   CSetupLocal += g[l]*(Pcplex.getValue(Z[l][t]));
-
-										   NLocalUsed += Pcplex.getValue(Z[l][t]);
-										}
-
-
-								  //Number and cost of relocated items
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(k=0; k<L; k++)
-										   for(i=0; i<I; i++)
-											  if ((l != k) && (Pcplex.getValue(V[i][l][k][t]) > 0.00001)) {
-												 CRelocItem += r[i][l][k]*(Pcplex.getValue(V[i][l][k][t]));
-
-												 NRelocItem += Pcplex.getValue(V[i][l][k][t]);
-											  }
-
-								  
-								  
-								  //Total available space of used locations
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										TotalOpenSpace += H[l]*(Pcplex.getValue(Z[l][t]));
-
-
-								  //Total used space in the locations;
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   TotalUsedSpace += cs[i]*(Pcplex.getValue(S[i][l][t]));
-
-
-								  //Percentage of used space
-								  //over all the opened space
-								  PercUsedSpace = 100*(TotalUsedSpace/TotalOpenSpace);
- 
-	  
-
-
-
-								  // ****************************************************************************************************
-								  //Print in the output file
-								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
-								  out << endl << endl << endl << endl << endl << endl << endl;
-								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
-								  out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
-								  out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
-								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
-								  out << endl << endl;
-								  out << "Objective Function Value = " << OF_RFH << endl; 
-								  out << "Gap = " << Gap_RFH << endl;
-								  out << "Time = " << Time_RFH << endl;
-								  out << endl << endl;
-								  out << "*************************************************************************************" << endl;
-								  out << endl << endl << endl;
-								  out << "************************************ Other Values ***********************************" << endl;
-								  out << endl;
-								  out << "Setup Cost Item = " << CSetupItem << endl;
-								  out << "Inventory Cost Item = " << CInventItem << endl;
-								  out << "Handling Cost Item = " << CHandItem << endl;
-								  out << "Setup Cost Location = " << CSetupLocal << endl;
-								  out << "Relocation Cost Item = " << CRelocItem << endl;
-								  out << endl;
-								  out << "Number Setup Item = " << NSetupItem << endl;
-								  out << "Number Inventoried Item = " << NInventItem << endl;
-								  out << "Number Handled Item = " << NHandItem << endl;
-								  out << "Number Used Location = " << NLocalUsed << endl;
-								  out << "Number Relocated Item = " << NRelocItem << endl;
-								  out << endl;
-								  out << "Total Opened Space = " << TotalOpenSpace << endl;
-								  out << "Total Used Space = " << TotalUsedSpace << endl;
-								  out << "Percentage Used Space = " << PercUsedSpace << endl;
-								  out << endl;
-								  out << "*************************************************************************************" << endl;
-								  out << endl;
-								  out << endl;
-								  out << endl;
-								  out << endl;
-								  out << endl;
-								  for(t=0; t<T; t++)
-									 for(i=0; i<I; i++)
-										if (Pcplex.getValue(Y[i][t]) > 0.00001)
-										   out << "Y_" << i+1 << "_" << t+1 << " = " << Pcplex.getValue(Y[i][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(S[i][l][t]) > 0.00001)
-											  out << "S_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(S[i][l][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										if (Pcplex.getValue(Z[l][t]) > 0.00001)
-										   out << "Z_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Z[l][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(W[i][l][t]) > 0.00001)
-											  out << "W_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(W[i][l][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(Dp[i][l][t]) > 0.00001)
-											  out << "Dp_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Dp[i][l][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(Dm[i][l][t]) > 0.00001)
-											  out << "Dm_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Dm[i][l][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(l=0; l<L; l++)  
-										for(k=0; k<L; k++)  
-										   for(i=0; i<I; i++)
-											  if ((l != k) && (Pcplex.getValue(V[i][l][k][t]) > 0.00001))
-												 out << "V_" << i+1 << "_" << l+1 << "_" << k+1 << "_" << t+1 << " = " << Pcplex.getValue(V[i][l][k][t]) << endl;
-
-								  out << endl << endl;
-
-								  for(t=0; t<T; t++)
-									 for(tau = t; tau<T; tau++)
-										for(i=0; i<I; i++)
-										   if (Pcplex.getValue(FL[i][t][tau]) > 0.00001)
-											   out << "FL_" << i+1 << "_" << t+1 << "_" << tau+1 << " = " << Pcplex.getValue(FL[i][t][tau]) << endl;
-
-								  // ******************************************************************************************************************
-
-
-								  break;								  //STOP the Relax-and-Fix Heuristic
-
-
-					  }//end if optimal/feasible
-
-					    else {
-
-								  // ****************************************************************************************************
-								  //Print in the output file
-								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
-								  out << endl << endl << endl << endl << endl << endl << endl;
-								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
-								  out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
-								  out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
-								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
-								  out << endl << endl;
-								  out << "Solution Status = " << Pcplex.getStatus() << endl;
-					              out << "NO Solution to the RCLSP-MSL" << endl;
-								  out << endl << endl;
-								  out << "*************************************************************************************" << endl;
-								  // ***************************************************************************************************
-
-
-								  break;								  //STOP the Relax-and-Fix Heuristic
-
-
-						}//end else
-
-
-
-				  }//end if (checkRF_lastWindow == 1)
-
-				  // *****************************************************
-
-
-				  
-				  //Recover the values of the binary
-				  //variables in the Relax-and-Fix Heuristic
-				  for(i=0; i<I; i++)
-				     for(t=T_int_begin; t < (T_int_begin+T_Fix); t++)
-					    Y_fix[i][t] = Pcplex.getValue(Y[i][t]);
-
-
-				  for(l=0; l<L; l++)
-				     for(t=T_int_begin; t < (T_int_begin+T_Fix); t++)
-					    Z_fix[l][t] = Pcplex.getValue(Z[l][t]);
-
-
-				  for(i=0; i<I; i++)
-				     for(l=0; l<L; l++)
-						for(t=T_int_begin; t < (T_int_begin+T_Fix); t++)
-					       W_fix[i][l][t] = Pcplex.getValue(W[i][l][t]);
-
-
-
-				  
-				  //Add the constraints that fix the binary variables 
-				  //at their values in the Relax-and-Fix Heuristic
-				  for(i=0; i<I; i++)
-				     for(t=T_int_begin; t < (T_int_begin+T_Fix); t++){
-					    IloExpr fix(env);
-						   
-						fix += Y[i][t];
-						   
-						RestFixY[i][t] = (fix == Y_fix[i][t]);
-						RestFixY[i][t].setName("FixY");
-						Pmodel.add(RestFixY[i][t]);
-
-						fix.end();
-					 }
-
-
-				  for(l=0; l<L; l++)
-				     for(t=T_int_begin; t < (T_int_begin+T_Fix); t++){
-					    IloExpr fix(env);
-						   
-						fix += Z[l][t];
-						   
-						RestFixZ[l][t] = (fix == Z_fix[l][t]);
-						RestFixZ[l][t].setName("FixZ");
-						Pmodel.add(RestFixZ[l][t]);
-
-						fix.end();
-					 }
-
-
-				  for(i=0; i<I; i++)
-				     for(l=0; l<L; l++)
-				        for(t=T_int_begin; t < (T_int_begin+T_Fix); t++){
-						   IloExpr fix(env);
-						   
-						   fix += W[i][l][t];
-						   
-						   RestFixW[i][l][t] = (fix == W_fix[i][l][t]);
-						   RestFixW[i][l][t].setName("FixW");
-						   Pmodel.add(RestFixW[i][l][t]);
-
-						   fix.end();
-						}
-
-
-
-				  //Move the time-window in 
-				  //the Relax-and-Fix Heuristic
-				  T_int_begin = T_int_end - T_Overlap;
-
-				  T_int_end   = T_int_begin + T_WindowSize;
-			  
-
-				  //Check if the last window of the
-				  //Relax-and-Fix Heuristic is reached 
-				  //If yes, the next iteration is the
-				  //last iteration of the heuristic
-				  if (T_int_end >= T) {
-										 T_int_end = T;
-										 checkRFH_lastWindow = 1;
-				  }
-
-
-
-		 }//end for ;;
-		 //Relax-and-Fix Heuristic LOOP
-
-		 // **************************************************************
-
-
-		 //End the parameters of the
-		 //Relax-and-Fix Heuristic
-		 Y_fix.end();
-		 Z_fix.end();
-		 W_fix.end();
-		 RestFixY.end();
-		 RestFixZ.end();
-		 RestFixW.end();
-
-		 
-
-// ******************************************** //
-//    The End of the Relax-and-Fix Heuristic    //
-// ******************************************** //
-
-
-
-
-
-// ********************************************************************************************** //
-// *************************************** END MAIN PROGRAM ************************************* //
-// ********************************************************************************************** //
-
-
-
-   } //end try
-
-
-      catch (IloException& ex) {
-        cerr << "Error Cplex: " << ex << endl;
-      } 
-	  catch (...) {
-        cerr << "Error Cpp" << endl;
-      }
-     
-
-	  //Finish the enviroment
-	  env.end();
-
-	
-	return 0;
-
-}
-
+// ************************************************************************************* //
+//    Program to solve the Facility Location Reformulation of the General Capacitated    //
+//             Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)            //
+//                              by a Relax-and-Fix Heuristic                             //
+//	 																					 //
+//	  Used in Gislaine Mara Melega Pos-doctoral											 //
+//    Copyright 2020 - date:  04/2022													 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+//#include <stdafx.h>
+#include <ilcplex/ilocplex.h>
+#include <ilconcert/iloexpression.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_ConcurrentLR.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Variables.h"
+#include "RCLSP-MSL_Concert.h"
+#include "RCLSP-MSL_LocalSearch.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_RunCache.h"
+#include "RCLSP-MSL_Checkpoint.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Memory.h"
+#include "RCLSP-MSL_Timeline.h"
+#include "RCLSP-MSL_Log.h"
+#include "RCLSP-MSL_Results.h"
+
+
+
+//macro necessary for portability
+ILOSTLBEGIN	
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+   
+    //Input Data File
+    ifstream in(argv[1]);
+
+
+    //Output Data File 1
+    ofstream out(argv[2]);
+
+
+	//Options of the heuristic (name=value)
+	RCLSPMSL_Options Options(argc, argv, 3);
+
+
+	//Trace of the phases (see RCLSP-MSL_Trace.h)
+	//trace - file of the trace events (no trace if it is not given)
+	//memory - 0: no memory of the phases in the output file (see RCLSP-MSL_Memory.h)
+	Trace().open(Options.getString("trace", ""), "RFH");
+	Trace().account(Options.getInt("memory", 1) != 0);
+
+
+	//Timeline of the solves of the MIPs (see RCLSP-MSL_Timeline.h)
+	//timeline - CSV file of the incumbents and bounds (no file if it is not given)
+	//target_gap - target gap (%) of the time to target of the solves
+	//reference - best known objective function value, reference of the primal integral
+	//(the best known solution in the cache of the runs if it is not given; else the
+	//last incumbent of each solve)
+	Timeline().setFile(Options.getString("timeline", ""));
+	Timeline().setTarget(Options.getNum("target_gap", 1));
+	if (Options.has("reference")) Timeline().setReference(Options.getNum("reference", 0), "option reference");
+
+
+	//Log of the optimization package (see RCLSP-MSL_Log.h)
+	//log - log file (the output data file with .log if it is not given)
+	//verbosity - 0: no log, 1: warnings, 2: also the solves, 3: also the output of cplex
+	Log().open(Options.getString("log", string(argv[2]) + ".log"), Options.getInt("verbosity", LOG_SOLVER));
+
+
+	//Record of the run (see RCLSP-MSL_Results.h)
+	//results - file of the records of the runs (the output data file with .json if it is not given)
+	//solution - CSV file of the nonzero variables of the final solution (no file if it is not given)
+	//archive - binary archive of the final solution (no archive if it is not given)
+	Results().open(Options.getString("results", string(argv[2]) + ".json"), Options.getString("solution", ""), "RFH", argv[1]);
+	Results().setArchive(Options.getString("archive", ""));
+
+
+	//Threads and random seed of cplex (seed 0: the default seed of cplex);
+	//the seed is also the seed of the order of the moves of the Local Search
+	int Threads = Options.getInt("threads", 1);
+	int Seed = Options.getInt("seed", 0);
+
+
+    //Problem enviroment: env
+    IloEnv env;
+
+
+    try{  
+
+
+          int  t, i, l,													  //indexes to: time periods, items, locations
+			 
+			   j, k, tau;												  //other indexes
+
+		  
+		  //Variables name
+		  char setupitem[15];											  //setup of item
+		  char stockitemloc[15];										  //stock of item in location
+
+		  char setuplocation[15];									      //setuplocation
+		  char inflowitem[15];											  //inflow of item in location 
+		  char outflowitem[15];											  //outflow of item in location
+		  char assignitemlocation[15];									  //assignment of item to storage location
+
+		  char facilityref[15];											  //facility location reformulation
+
+
+
+		  //Decomposition used in the Relax-and-Fix Heuristic
+		  //time     - time-oriented decomposition (windows of periods)
+		  //item     - item-oriented decomposition (windows of clusters of items)
+		  //location - location-oriented decomposition (windows of clusters of locations)
+		  //timeitem - time x item decomposition (windows of blocks of periods and items)
+		  string Decomposition = Options.getString("decomposition", "time"),
+			     DecompositionName;
+
+		  if (Decomposition == "time") DecompositionName = "time-oriented";
+		    else if (Decomposition == "item") DecompositionName = "item-oriented";
+		    else if (Decomposition == "location") DecompositionName = "location-oriented";
+		    else if (Decomposition == "timeitem") DecompositionName = "time x item";
+		    else {
+                    cerr << "No such decomposition: " << Decomposition << endl;
+                    throw(1);
+			}
+
+
+
+
+
+
+// *********************************** // 
+//      Creation of the Parameters     //
+//    and Data Read from Input File    // 
+// *********************************** //
+
+
+		  Trace().step("Run", "Read instance");
+
+
+		  //Indexes
+		  //Time period
+		  IloInt T;
+		  
+		  //Items
+		  IloInt I;
+
+		  //Locations
+		  IloInt L;
+
+
+
+		  //Read only the indexes
+		  //to create the parameters
+		  if (in) {
+
+				     in  >>  T;
+				     in  >>  I;
+				     in  >>  L;
+
+		  }
+	        else {
+                    cerr << "No such file: " << "dataRCLSPMSL.dat" << endl;
+                    throw(1);
+			}
+
+          // *************************************************************
+
+
+		  //Production of Items
+		  //Production cost per unit of item
+          IloNumArray vc(env, I);
+
+          //Setup cost of item 
+		  IloNumArray sc(env, I);										
+
+		  //Inventory holding cost per unit of item
+		  IloNumArray hc(env, I);
+
+		  //Production consumption of capacity per unit of item 
+		  IloNumArray vt(env, I);
+
+		  //Setup time consumption of capacity of item 
+		  //IloNumArray st(env, I);
+
+		  //Production capacity in each period
+		  IloNumArray Cap(env, T);
+
+		  //Demand to be fulfilled of item i in period t
+		  IloArray<IloNumArray> d(env, I);
+		  for(i=0; i<I; i++)
+		     d[i] = IloNumArray(env, T);					
+
+
+		  //Inventory of items
+		  //Fixed cost of having a positive
+		  //inventory level at location l
+		  IloNumArray g(env, L);
+
+		  //Unit handling cost of item i at location l
+		  IloArray<IloNumArray> ha(env, I);
+		  for(i=0; i<I; i++)
+		     ha[i] = IloNumArray(env, L);	
+
+		  //Consumption of storage capacity per unit of item
+		  IloNumArray cs(env, I);
+
+		  //Storage capacity of each location in each period
+		  IloNumArray H(env, L);
+
+		  //Compatibility between item i and locations l
+		  IloArray<IloNumArray> alpha(env, I);
+		  for(i=0; i<I; i++)
+		     alpha[i] = IloNumArray(env, L);	
+
+		  //Compatibility between item i an j
+		  IloArray<IloNumArray> beta(env, I);
+		  for(i=0; i<I; i++)
+		     beta[i] = IloNumArray(env, I);	
+
+		  //Unit moving cost of item i
+		  //from location k to location l 
+		  IloArray<IloArray<IloNumArray> > r(env, I);
+		  for(i=0; i<I; i++){
+		     r[i] = IloArray<IloNumArray> (env, L); 
+		     for(l=0; l<L; l++){
+		        r[i][l] = IloNumArray(env, L);
+			 }								
+		  }          
+
+
+		  //Big M
+		  IloInt BigM;
+
+
+
+		  //Read the remaining parameters
+		  if (in) {
+			          
+				     for(t=0; t<T; t++)
+					    in >> Cap[t];
+
+					 
+					 for(i=0; i<I; i++){
+ 					    in >> vc[i];
+						in >> sc[i];
+						in >> hc[i];
+						in >> vt[i];
+						in >> cs[i];
+					 }
+
+
+					 for(i=0; i<I; i++)
+					    for(t=0; t<T; t++)
+						   in >> d[i][t];
+
+
+					 for(l=0; l<L; l++){
+					    in >> H[l];
+						in >> g[l];
+					 }
+
+
+					 for(i=0; i<I; i++)
+				        for(l=0; l<L; l++)
+						   in >> ha[i][l];
+
+
+					 for(i=0; i<I; i++)
+				        for(l=0; l<L; l++)
+						   in >> alpha[i][l];
+
+
+					 for(i=0; i<I; i++)
+                        for(j=0; j<I; j++)
+						   in >> beta[i][j];				   
+
+
+					 for(i=0; i<I; i++)
+					    for(l=0; l<L; l++)
+						   for(k=0; k<L; k++)
+						      in >> r[i][l][k];
+
+
+          }//end if(in)
+	        else {
+                    cerr << "No such file: " << "dataRCLSPMSL.dat" << endl;
+                    throw(1);
+			}
+
+// ***********************************************************************
+
+
+	 
+
+
+// ************************ // 
+//    Create the Problem    // 
+// ************************ //
+
+
+		  Trace().step("Run", "Build model");
+
+
+		  //Problem
+		  IloModel Pmodel(env);
+
+
+		  //All the variables are considered linear (relaxed values)
+
+		  Trace().step("Build", "Variables Y");
+
+		  //Setup of item i in period t
+		  IloArray<IloNumVarArray> Y(env, I);
+		  for(i=0; i<I; i++){
+		     Y[i] = IloNumVarArray(env, T);
+			 for(t=0; t<T; t++){
+                sprintf(setupitem, "Y_%d_%d", i, t);
+				Y[i][t] = IloNumVar(env, 0, 1, setupitem);
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables S");
+
+		  //Inventory of item i at location l in period t
+		  IloArray<IloArray<IloNumVarArray> > S(env, I);
+		  for(i=0; i<I; i++){
+		     S[i] = IloArray<IloNumVarArray> (env, L); 
+		     for(l=0; l<L; l++){ 
+		        S[i][l] = IloNumVarArray(env, T);								
+				for(t=0; t<T; t++){ 
+				   sprintf(stockitemloc, "S_%d_%d_%d", i, l, t);
+                   S[i][l][t] = IloNumVar(env, 0, IloInfinity, stockitemloc);
+				}
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables Z");
+
+		  //Use of location l in period t
+		  //i.e., there is a positive inventory
+		  //in location l at the end of period t
+		  IloArray<IloNumVarArray> Z(env, L);
+		  for(l=0; l<L; l++){
+		     Z[l] = IloNumVarArray(env, T);
+			 for(t=0; t<T; t++){
+                sprintf(setuplocation, "Z_%d_%d", l, t);
+				Z[l][t] = IloNumVar(env, 0, 1, setuplocation);
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables Dp");
+
+		  //Inflow of item i at location l in period t
+		  IloArray<IloArray<IloNumVarArray> > Dp(env, I);
+		  for(i=0; i<I; i++){
+		     Dp[i] = IloArray<IloNumVarArray> (env, L); 
+		     for(l=0; l<L; l++){ 
+		        Dp[i][l] = IloNumVarArray(env, T);								
+				for(t=0; t<T; t++){ 
+				   sprintf(inflowitem, "Dp_%d_%d_%d", i, l, t);
+                   Dp[i][l][t] = IloNumVar(env, 0, IloInfinity, inflowitem);
+				}
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables Dm");
+
+		  //Outflow of item i at location l in period t
+		  IloArray<IloArray<IloNumVarArray> > Dm(env, I);
+		  for(i=0; i<I; i++){
+		     Dm[i] = IloArray<IloNumVarArray> (env, L); 
+		     for(l=0; l<L; l++){ 
+		        Dm[i][l] = IloNumVarArray(env, T);								
+				for(t=0; t<T; t++){ 
+				   sprintf(outflowitem, "Dm_%d_%d_%d", i, l, t);
+                   Dm[i][l][t] = IloNumVar(env, 0, IloInfinity, outflowitem);
+				}
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables W");
+
+		  //Assignment of item i at storage location l in period t
+		  IloArray<IloArray<IloNumVarArray> > W(env, I);
+		  for(i=0; i<I; i++){
+		     W[i] = IloArray<IloNumVarArray> (env, L); 
+		     for(l=0; l<L; l++){ 
+		        W[i][l] = IloNumVarArray(env, T);								
+				for(t=0; t<T; t++){ 
+				   sprintf(assignitemlocation, "W_%d_%d_%d", i, l, t);
+                   W[i][l][t] = IloNumVar(env, 0, 1, assignitemlocation);
+				}
+			 }
+		  }
+
+
+
+		  Trace().step("Build", "Variables V");
+
+		  //Relocation of item i from location l to location k in period t
+		  //(created when the models use it, see RCLSP-MSL_Variables.h)
+		  RCLSPMSL_LazyVars V(env, "V", 0, IloInfinity, I, L, L, T);
+
+
+
+		  Trace().step("Build", "Variables FL");
+
+		  //Facility location reformulation 
+		  //number of units of item i produced in period t to
+		  //meet the demand in a posterior period tau, tau >= t
+		  IloArray<IloArray<IloNumVarArray> > FL(env, I);
+		  for(i=0; i<I; i++){
+		     FL[i] = IloArray<IloNumVarArray> (env, T); 
+		     for(t=0; t<T; t++){ 
+		        FL[i][t] = IloNumVarArray(env, T);								
+				for(tau = t; tau<T; tau++){ 
+				   sprintf(facilityref, "FL_%d_%d_%d", i, t, tau);
+                   FL[i][t][tau] = IloNumVar(env, 0, IloInfinity, facilityref);
+				}
+			 }
+		  }
+
+		  // *************************************************************
+
+
+
+		  Trace().step("Build", "Objective");
+
+		  //Objective Function
+		  IloExpr objective(env);
+
+
+		  //Costs of production
+		  for(t=0; t<T; t++)
+			 for(tau = t; tau<T; tau++)
+			    for(i=0; i<I; i++)
+		           objective += vc[i]*FL[i][t][tau];
+
+
+		  //Costs of setup of items
+		  for(t=0; t<T; t++)
+			 for(i=0; i<I; i++)
+		        objective += sc[i]*Y[i][t];
+
+
+		  //Cost of inventory and handling of items at storage locations
+		  for(t=0; t<T; t++)
+			 for(l=0; l<L; l++)
+			    for(i=0; i<I; i++)
+		           objective += (hc[i]*S[i][l][t] + ha[i][l]*Dp[i][l][t]);
+
+
+		  //Costs of using locations
+		  for(t=0; t<T; t++)
+		     for(l=0; l<L; l++)
+			    objective += g[l]*Z[l][t];
+
+
+		  //Cost of relocation of items between locations
+		  for(t=0; t<T; t++)
+			 for(l=0; l<L; l++)
+				for(k=0; k<L; k++)
+			       for(i=0; i<I; i++)
+			          if ((l != k) && (r[i][l][k] != 0))
+			             objective += r[i][l][k]*V(i, l, k, t);
+
+
+		  //Problem objective function environment
+		  IloObjective Pof = IloMinimize(env, objective);
+
+
+          //Add the objective function (Pof) to the problem
+		  Pmodel.add(Pof);
+          objective.end();		     //delet the expression
+
+		  // *************************************************************
+
+
+
+		  Trace().step("Build", "Constraints InflowOutFlow1");
+
+		  //InflowOutFlow1 constraints environment
+		  IloArray<IloRangeArray> InflowOutFlow1(env, I);
+		  for(i=0; i<I; i++)
+		     InflowOutFlow1[i] = IloRangeArray(env, T);
+
+		  //InflowOutFlow1 constraints
+		  for(i=0; i<I; i++)
+		     for(t=0; t<T; t++){
+				IloExpr flow(env);
+				
+				for(tau=0; tau <= t; tau++)
+				   flow += FL[i][tau][t];
+
+			    InflowOutFlow1[i][t] = (flow == d[i][t]);
+				flow.end();
+			 }
+
+		  //Add the InflowOutFlow1 constraints to the problem
+		  for(i=0; i<I; i++){
+             InflowOutFlow1[i].setNames("InflowOutFlow1");
+	         Pmodel.add(InflowOutFlow1[i]);
+		  }
+
+
+
+
+
+		  Trace().step("Build", "Constraints InflowOutFlow2");
+
+		  //InflowOutFlow2 constraints environment
+		  IloArray<IloRangeArray> InflowOutFlow2(env, I);
+		  for(i=0; i<I; i++)
+		     InflowOutFlow2[i] = IloRangeArray(env, T);
+
+		  //InflowOutFlow2 constraints
+		  for(i=0; i<I; i++)
+		     for(t=0; t<T; t++){
+				IloExpr flow(env);
+				
+				for(tau = t; tau<T; tau++)
+				   flow += FL[i][t][tau];
+
+				flow -= d[i][t];
+
+				for(l=0; l<L; l++)
+				   flow -= Dp[i][l][t] - Dm[i][l][t];
+
+			    InflowOutFlow2[i][t] = (flow == 0);
+				flow.end();
+			 }
+
+		  //Add the InflowOutFlow2 constraints to the problem
+		  for(i=0; i<I; i++){
+             InflowOutFlow2[i].setNames("InflowOutFlow2");
+	         Pmodel.add(InflowOutFlow2[i]);
+		  }
+
+
+
+
+		  
+		  Trace().step("Build", "Constraints BalanceLocation");
+
+		  //BalanceLocation constraint environment
+		  IloArray<IloArray<IloRangeArray> > BalanceLocation(env, I);
+		  for(i=0; i<I; i++){
+		     BalanceLocation[i] = IloArray<IloRangeArray>(env,L);
+		     for(l=0; l<L; l++){
+		        BalanceLocation[i][l] = IloRangeArray(env, T);
+			 }
+		  }
+
+		  //BalanceLocation constraint
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++)
+		        for(t=0; t<T; t++){
+		           IloExpr balance(env);
+
+				   if (t == 0) {
+								  balance += Dp[i][l][t] - S[i][l][t] - Dm[i][l][t];
+
+								  for(k=0; k<L; k++)
+									 if (k != l) balance += V(i, k, l, t) - V(i, l, k, t);
+
+								  BalanceLocation[i][l][t] = (balance == 0);
+								  balance.end();
+					}
+					  else {
+
+								  balance += S[i][l][t-1] + Dp[i][l][t] - S[i][l][t] - Dm[i][l][t];
+
+								  for(k=0; k<L; k++)
+								     if (k != l) balance += V(i, k, l, t) - V(i, l, k, t);
+
+								  BalanceLocation[i][l][t] = (balance == 0);
+								  balance.end();
+					  }
+				}
+
+		  //Add the BalanceLocation constraint to the problem
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++){
+                BalanceLocation[i][l].setNames("BalanceLocation");
+	            Pmodel.add(BalanceLocation[i][l]);
+			 }
+
+
+
+
+
+		  Trace().step("Build", "Constraints Setup");
+
+		  //Setup constraints environment
+		  IloArray<IloArray<IloRangeArray> > Setup(env, I);
+		  for(i=0; i<I; i++){
+		     Setup[i] = IloArray<IloRangeArray>(env, T);
+		     for(t=0; t<T; t++){
+		        Setup[i][t] = IloRangeArray(env, T);
+			 }
+		  }
+
+		  //Setup constraints
+		  for(i=0; i<I; i++)
+		     for(t=0; t<T; t++)
+			    for(tau = t; tau<T; tau++){
+			       IloExpr set(env);
+				
+                   set += FL[i][t][tau] - d[i][tau]*Y[i][t];
+
+			    Setup[i][t][tau] = (set <= 0);
+				set.end();
+		     }
+
+		  //Add the Setup constraints to the problem
+		  for(i=0; i<I; i++)
+		     for(t=0; t<T; t++)
+			    for(tau = t; tau<T; tau++){
+                   Setup[i][t][tau].setName("Setup");
+	               Pmodel.add(Setup[i][t][tau]);
+				}
+
+
+		  
+
+
+		  Trace().step("Build", "Constraints Capacity");
+
+		  //Capacity constraints environment
+		  IloRangeArray Capacity(env, T);
+
+		  //Capacity constraints
+		  for(t=0; t<T; t++){
+		     IloExpr cap(env);
+
+			 for(i=0; i<I; i++)
+			    for(tau = t; tau<T; tau++)
+			       cap += vt[i]*FL[i][t][tau]; 
+
+			 Capacity[t] = (cap <= Cap[t]);
+			 cap.end();
+		  }
+
+		  //Add the Capacity constraints to the problem
+          Capacity.setNames("Capacity");
+	      Pmodel.add(Capacity);
+
+
+
+
+
+		  Trace().step("Build", "Constraints InvAlloc");
+
+		  //InvAlloc constraints enviroment
+		  IloArray<IloArray<IloRangeArray> > InvAlloc(env, I);
+		  for(i=0; i<I; i++){
+		     InvAlloc[i] = IloArray<IloRangeArray>(env,L);
+		     for(l=0; l<L; l++){
+		        InvAlloc[i][l] = IloRangeArray(env, T);
+			 }
+		  }
+
+		  //InvAlloc constraints
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   IloExpr alloc(env);
+
+				   //Calculate the bigM 
+				   int sumd = 0; 
+				   double allocitem = 0;
+
+				   //Sum of the demand
+				   for(tau=t; tau<T; tau++)
+				      sumd += d[i][tau];
+
+				   //Allocation of items
+				   allocitem = (H[l]/cs[i]);
+
+				   //Choose the smallest value between the sum
+				   //of the demand and allocation of items
+				   if (sumd <= allocitem) BigM = sumd;
+				     else BigM = allocitem;
+
+
+                   alloc += S[i][l][t] - BigM*W[i][l][t];
+
+			       InvAlloc[i][l][t] = (alloc <= 0);
+				   alloc.end();
+				}
+
+		  //Add the InvAlloc constraints to the problem
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++){
+                InvAlloc[i][l].setNames("InvAlloc");
+	            Pmodel.add(InvAlloc[i][l]);
+			 }
+
+
+
+
+
+		  Trace().step("Build", "Constraints CapacityStorage");
+
+		  //CapacityStorage constraints environment
+    	  IloArray<IloRangeArray> CapacityStorage(env, L); 
+	      for(l=0; l<L; l++){
+		     CapacityStorage[l] = IloRangeArray(env, T);
+		  }
+
+		  //CapacityStorage
+		  for(l=0; l<L; l++)
+		     for(t=0; t<T; t++){
+			    IloExpr cap(env);
+
+				for(i=0; i<I; i++)
+				   cap += cs[i]*S[i][l][t];
+
+				cap -= H[l]*Z[l][t];
+			    
+				CapacityStorage[l][t] = (cap <= 0);
+				cap.end();
+			 }
+
+		  //Add the CapacityStorage constraints to the problem
+		  for(l=0; l<L; l++){
+             CapacityStorage[l].setNames("CapacityStorage");
+	         Pmodel.add(CapacityStorage[l]);
+		  }
+
+
+
+
+
+		  Trace().step("Build", "Constraints ItemLocatCompat");
+
+		  //ItemLocatCompat constraints enviroment
+		  IloArray<IloArray<IloRangeArray> > ItemLocatCompat(env, I);
+		  for(i=0; i<I; i++){
+		     ItemLocatCompat[i] = IloArray<IloRangeArray>(env,L);
+		     for(l=0; l<L; l++){
+		        ItemLocatCompat[i][l] = IloRangeArray(env, T);
+			 }
+		  }
+
+		  //ItemLocatCompat constraints
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++)
+				for(t=0; t<T; t++){
+				   IloExpr comp(env);
+
+                   comp += W[i][l][t];
+
+			       ItemLocatCompat[i][l][t] = (comp <= alpha[i][l]);
+				   comp.end();
+			 }
+
+		  //Add the ItemLocatCompat constraints to the problem
+		  for(i=0; i<I; i++)
+		     for(l=0; l<L; l++){
+                ItemLocatCompat[i][l].setNames("ItemLocatCompat");
+	            Pmodel.add(ItemLocatCompat[i][l]);
+			 }
+
+
+
+
+
+		  Trace().step("Build", "Constraints ItemItemCompat");
+
+		  //ItemItemCompat constraints enviroment
+		  IloArray<IloArray<IloArray<IloRangeArray> > > ItemItemCompat(env, I);
+		  for(i=0; i<I; i++){
+             ItemItemCompat[i] = IloArray<IloArray<IloRangeArray> >(env, I);
+             for(j=i; j<I; j++){
+		        ItemItemCompat[i][j] = IloArray<IloRangeArray>(env,L);
+		        for(l=0; l<L; l++){
+		           ItemItemCompat[i][j][l] = IloRangeArray(env, T);
+				}
+			 }
+		  }
+
+		  //ItemItemCompat constraints
+		  for(i=0; i<I; i++)
+			 for(j=i; j<I; j++)
+		        for(l=0; l<L; l++)
+				   for(t=0; t<T; t++){
+				      IloExpr comp(env);
+
+                      comp += W[i][l][t] + W[j][l][t];
+
+			          ItemItemCompat[i][j][l][t] = (comp <= beta[i][j] + 1);
+				      comp.end();
+				   }
+
+		  //Add the ItemItemCompat constraints to the problem
+		  for(i=0; i<I; i++)
+			 for(j=i; j<I; j++)
+		        for(l=0; l<L; l++){
+                   ItemItemCompat[i][j][l].setNames("ItemItemCompat");
+	               Pmodel.add(ItemItemCompat[i][j][l]);
+				}
+
+		  // *************************************************************
+
+
+		  Trace().step("Build", "Extraction");
+
+		  //Define CPLEX environment to the problem
+          IloCplex Pcplex(Pmodel);
+
+
+          //Record the incumbents and bounds of the solves (RCLSP-MSL_Timeline.h)
+          Pcplex.use(TimelineCallback(env));
+
+
+// ***********************************************************************
+
+
+
+
+
+// ************************************************************************* //
+//    Solve the Linear Relaxation of the Reformulated General Capacitated    //
+//       Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      //
+//                         by an Optimization Package                        //
+// ************************************************************************* //
+
+
+		  Trace().step("Run", "LR");
+
+
+		  //Objective function value and computational
+		  //time of the linear relaxation problem
+		  double  OF_LR_RCLSPMSL = 0, Time_LR_RCLSPMSL = 0;
+
+
+
+		  //Cache of the runs of the instance (see RCLSP-MSL_RunCache.h): the bound
+		  //of the LR (and its basis, if there is one) is recovered from the cache
+		  //instead of solving the LR again, and the best known solution is the MIP start
+		  //run_cache - directory of the cache (no cache if it is not given)
+		  string RunCache = Options.getString("run_cache", "");
+
+		  RCLSPMSL_Instance inst_RC;
+		  RCLSPMSL_RunCache Cache_RC;
+		  IloNumVarArray Vars_RC(env);
+		  IloRangeArray Ranges_RC(env);
+		  bool Cached_LR = false;
+
+		  if (!RunCache.empty()) {
+			 ifstream in_RC(argv[1]);
+			 ReadInstance(in_RC, inst_RC);
+
+			 CollectVars(Vars_RC, Y); CollectVars(Vars_RC, S); CollectVars(Vars_RC, Z); CollectVars(Vars_RC, Dp);
+			 CollectVars(Vars_RC, Dm); CollectVars(Vars_RC, W); CollectVars(Vars_RC, V); CollectVars(Vars_RC, FL);
+
+			 CollectRanges(Ranges_RC, InflowOutFlow1); CollectRanges(Ranges_RC, InflowOutFlow2); CollectRanges(Ranges_RC, BalanceLocation);
+			 CollectRanges(Ranges_RC, Setup); CollectRanges(Ranges_RC, Capacity); CollectRanges(Ranges_RC, InvAlloc);
+			 CollectRanges(Ranges_RC, CapacityStorage); CollectRanges(Ranges_RC, ItemLocatCompat);
+			 CollectRanges(Ranges_RC, ItemItemCompat);
+
+			 Cached_LR = LoadRunCache(RunCache, inst_RC, Cache_RC) && Cache_RC.hasLR;
+			 if ((Cache_RC.hasIncumbent) && (!Timeline().hasReference()))
+				Timeline().setReference(Cache_RC.OF_Incumbent, "best known solution in the cache of the runs");
+			 if (Cache_RC.hasBasis()) SetBasis(env, Pcplex, Vars_RC, Ranges_RC, Cache_RC.colStatus, Cache_RC.rowStatus);
+		  }
+
+
+
+		  //LR solved apart (see RCLSP-MSL_ConcurrentLR.h): the heuristic starts at once
+		  //and waits for the bound of the LR only when the first gap is computed
+		  //lr_thread - 0: the LR is solved before the heuristic
+		  //With the cache of the runs the LR is solved on the model (its basis is
+		  //saved in the cache and it is the warm start of the next runs)
+		  RCLSPMSL_ConcurrentLR Apart_LR;
+		  bool Thread_LR = (!Cached_LR) && (RunCache.empty()) && (Options.getInt("lr_thread", 1) != 0) && Apart_LR.start(argv[1], RunCache);
+
+
+
+          // ***** Solve the LR_CLSP-MSL *********************************
+
+		  //Add CPLEX Options
+          //Print the output and warnings 
+		  //of cplex in the log (RCLSP-MSL_Log.h)
+          Pcplex.setOut(Log().channel(LOG_SOLVER));
+          Pcplex.setWarning(Log().channel(LOG_WARNING));
+
+
+		  //Limite the number of threads in
+		  //the solution of the linear relation
+		  Pcplex.setParam(IloCplex::Threads, Threads);
+		  if (Seed > 0) Pcplex.setParam(IloCplex::RandomSeed, Seed);
+
+
+
+		  //Extract the model
+		  //Pcplex.extract(Pmodel);
+		  //Export the model
+		  //Pcplex.exportModel("model.lp" );
+
+	 
+		  
+          // ****************************************************************************************************
+		  out << "***** The Facility Location Reformulation of the General Capacitated Lot-Sizing *****" << endl;
+		  out << "*****            Problem with Multiple Storage Locations (RCLSP-MSL)            *****" << endl;       
+		  out << "*****                    solved by a Relax-and-Fix Heuristic                    *****" << endl;
+		  out << endl << endl;
+		  out << "* Lower Bound: Linear Relaxation" << endl;
+		  out << "* Upper Bound: Relax-and-Fix Heuristic (" << DecompositionName << " decomposition)" << endl;
+		  out << endl << endl << endl << endl << endl;
+		  out << "*********** Lower Bound: Solve the LR_RCLSP-MSL by an Optimization Package **********" << endl;
+		  out << endl << endl;
+
+
+		  //SOLVE the LR_RCLSP-MSL (not solved again if it is in the cache of the runs,
+		  //not solved here if it is solved apart)
+          if ((!Cached_LR) && (!Thread_LR)) Pcplex.solve();
+
+
+		  out << endl << endl << endl;
+		  // ****************************************************************************************************	  
+
+
+
+
+
+		  // ***** Check the Solution Status *****************************
+
+		  
+		  //Check if the solution of the Linear Relaxation is
+		  //Optimal-1 or Feasible-2
+		  if (Thread_LR) {
+					out << "Solution Status LR = Solved apart, while the heuristic runs" << endl;
+					out << endl << endl << endl << endl << endl;
+		  }
+
+		    else if ((Cached_LR) || (Pcplex.getStatus() == IloAlgorithm::Optimal) || 
+			  (Pcplex.getStatus() == IloAlgorithm::Feasible)) {
+	
+
+					//Recover the objective function value
+				    //of the linear relation problem
+					OF_LR_RCLSPMSL = (Cached_LR) ? Cache_RC.OF_LR : Pcplex.getValue(Pof);
+
+
+					//Recover the time to solve 
+					//the linear relaxation problem
+					Time_LR_RCLSPMSL = (Cached_LR) ? 0 : Pcplex.getTime();
+
+
+					//Save the bound and the basis of the LR in the cache of the runs
+					if (!RunCache.empty() && !Cached_LR && (Pcplex.getStatus() == IloAlgorithm::Optimal)) {
+					   if (!GetBasis(env, Pcplex, Vars_RC, Ranges_RC, Cache_RC.colStatus, Cache_RC.rowStatus)) {
+						  Cache_RC.colStatus.clear();
+						  Cache_RC.rowStatus.clear();
+					   }
+					   UpdateLR(RunCache, inst_RC, OF_LR_RCLSPMSL, Cache_RC.colStatus, Cache_RC.rowStatus);
+					}
+
+					
+
+					// ****************************************************************************************************
+					//Print in the output file
+					out << "***** Solution to the Linear Relaxation of the Reformulated General Capacitated *****" << endl;
+					out << "*****             Lot-Sizing Problem with Multiple Storage Locations            *****" << endl;
+					out << endl << endl;
+					if (Cached_LR) out << "Solution Status LR = Cached in " << RunCacheFile(RunCache, inst_RC) << endl;
+					  else out << "Solution Status LR = " << Pcplex.getStatus() << endl;
+					out << "Objective Function Value LR = " << OF_LR_RCLSPMSL << endl; 
+					out << "Time LR = " << Time_LR_RCLSPMSL << endl;	 
+					out << endl << endl;
+					out << "*************************************************************************************" << endl;
+					out << endl << endl << endl << endl << endl << endl << endl << endl << endl << endl;
+					// ****************************************************************************************************
+
+
+		  }//end if Optimal-1/Feasible-2
+		    
+		    else {
+				    // ****************************************************************************************************
+					//Print in the output file
+					out << "***** Solution to the Linear Relaxation of the Reformulated General Capacitated *****" << endl;
+					out << "*****             Lot-Sizing Problem with Multiple Storage Locations            *****" << endl;
+					out << endl << endl;
+					out << "Solution Status LR = " << Pcplex.getStatus() << endl;
+					out << "NO Solution to the Linear Relaxation Problem" << endl;
+					out << endl << endl;
+					out << "*************************************************************************************" << endl;
+					out << endl << endl << endl << endl << endl << endl << endl << endl << endl << endl;
+					// ****************************************************************************************************
+
+			}//end else
+
+// ***********************************************************************
+
+
+
+
+
+// ******************************************************************* //
+//      Initial Solution to the Reformulated General Capacitated       //
+//			   Lot-Sizing Problem with Multiple Storage Locations		   //
+//                     by a Constructive Heuristic                     //
+// ******************************************************************* //
+
+
+		  Trace().step("Run", "Constructive Heuristic");
+
+
+		  //The solution of the Constructive Heuristic (without the
+		  //optimization package) is used as MIP start and as the
+		  //final solution when no solution is found
+		  //See RCLSP-MSL_Constructive.h
+		  RCLSPMSL_Instance inst_CH;
+		  RCLSPMSL_Solution sol_CH;
+		  double Time_CH;
+
+		  bool found_CH = InitialSolutionCH(argv[1], out, inst_CH, sol_CH, Time_CH);
+
+
+		  //The best known solution in the cache of the runs replaces
+		  //the solution of the Constructive Heuristic, if it is better
+		  UseIncumbent(out, inst_CH, Cache_RC, sol_CH, found_CH);
+
+
+		  //Parameters of the Local Search that improves the final solution
+		  //ls_threads - number of threads (independent move streams)
+		  //ls_time    - maximum time (seconds); 0 - no Local Search (the default)
+		  RCLSPMSL_LSParams Params_LS;
+		  Params_LS.threads = Options.getInt("ls_threads", 1);
+		  Params_LS.timeLimit = Options.getNum("ls_time", 0);
+		  if (Seed > 0) Params_LS.seed = Seed;
+
+		  //Tolerance of the validation of the final solution
+		  double Tol_Val = Options.getNum("val_tol", 0.00001);
+
+
+// ***********************************************************************
+
+
+
+
+
+// ******************************************************************* //
+//    Solve the Reformulated General Capacitated Lot-Sizing Problem    // 
+//			   with Multiple Storage Locations (RCLSP-MSL)			   //
+//                     by a Relax-and-Fix Heuristic                    //
+// ******************************************************************* //
+
+
+		  Trace().step("Run", "Relax-and-Fix");
+
+
+		  //The Relax-and-Fix Heuristic considers a decomposition of the binary variables
+		  //into blocks: periods (time-oriented), clusters of items (item-oriented), clusters
+		  //of locations (location-oriented) or periods x clusters of items (time x item).
+		  //Each window contains a sequence of blocks, the binary variables of these blocks
+		  //are integer and the resulting RCLSP-MSL problem is solved by an optimization package (CPLEX)
+
+
+		  int checkRFH_lastWindow;   									  //check in the Relax-and-Fix Heuristic if it is the last window
+																		  //(0-no; 1-yes)
+
+
+		  int T_Block,													  //number of periods in each block (time-oriented and time x item)
+			 
+			  I_Cluster,												  //number of items in each cluster (item-oriented and time x item)
+		     
+			  L_Cluster;												  //number of locations in each cluster (location-oriented)
+		 
+
+		  int NT_Blocks,												  //number of blocks of periods
+
+			  NI_Clusters,												  //number of clusters of items
+
+			  NL_Clusters,												  //number of clusters of locations
+
+			  N_Blocks;													  //number of blocks in the decomposition
+
+
+		  int B_WindowSize,												  //number of blocks in the window (B_WindowSize = B_Fix + B_Overlap),
+
+			  B_Fix,													  //number of blocks in the window that are fixed
+
+			  B_Overlap;												  //number of blocks in the window that overlap
+
+
+		  int B_int_begin, B_int_end,								 	  //interval of blocks where the binary variables are integer
+
+			  B_int_added;												  //blocks in which the integrality was already added to the problem
+
+
+		  double TotalTime,
+		
+			     timeWindow,											  //time avaialable for each window (total time/number of windows)
+
+				 timeWindow_RFH,										  //time available for each window considering the time left of other windows
+			    		        
+				 timeWindow_begin,										  //beginning time to solve the window in the Relax-and-Fix Heuristic
+			    
+				 timeWindow_end,										  //end time to solve the window in the Relax-and-Fix Heuristic
+			    
+				 timeWindow_used,										  //time spent in the resolution of a window in the Relax-and-Fix Heuristic
+				
+				 timeWindow_left;										  //time left in the resolution of a window in the Relax-and-Fix Heuristic
+
+
+		  double  OF_RFH, 												  //objective function value in the Relax-and-Fix Heuristic
+				 
+			      Gap_RFH,												  //gap in the Relax-and-Fix Heuristic
+		         
+			 	  Time_RFH;												  //computational time spent in the Relax-and-Fix Heuristic
+
+
+
+
+								
+		  // *************************************************************
+		  //Assigning the main values to the Relax-and-Fix Heuristic
+		  //Procedure according to the Decomposition
+ 
+		  //Note: B_WindowSize = B_Fix + B_Overlap
+
+		  if (Decomposition == "time") {
+						 T_Block = 1;
+						 I_Cluster = I;
+						 L_Cluster = L;
+						 B_Fix = 2;
+						 B_Overlap = 3;
+		  }
+		    else if (Decomposition == "item") {
+						 T_Block = T;
+						 I_Cluster = 5;
+						 L_Cluster = L;
+						 B_Fix = 1;
+						 B_Overlap = 1;
+			}
+		    else if (Decomposition == "location") {
+						 T_Block = T;
+						 I_Cluster = I;
+						 L_Cluster = 2;
+						 B_Fix = 1;
+						 B_Overlap = 1;
+			}
+		    else {
+						 T_Block = 5;
+						 I_Cluster = 5;
+						 L_Cluster = L;
+						 B_Fix = 1;
+						 B_Overlap = 1;
+			}
+
+
+		  //Values given in the options
+		  T_Block = Options.getInt("periods", T_Block);
+		  I_Cluster = Options.getInt("items", I_Cluster);
+		  L_Cluster = Options.getInt("locations", L_Cluster);
+		  B_Fix = Options.getInt("fix", B_Fix);
+		  B_Overlap = Options.getInt("overlap", B_Overlap);
+		  TotalTime = Options.getNum("time", 1800);
+
+
+		  //Checkpoint of the windows (see RCLSP-MSL_Checkpoint.h)
+		  //checkpoint - file written after each window (no checkpoint if it is not given)
+		  //resume     - 1: continue the run from the window of the checkpoint file
+		  string CheckpointFile = Options.getString("checkpoint", "");
+		  bool Resume = (Options.getInt("resume", 0) != 0);
+
+		  if ((T_Block < 1) || (I_Cluster < 1) || (L_Cluster < 1) || (B_Fix < 1) || (B_Overlap < 0)) {
+                    cerr << "Invalid parameters of the Relax-and-Fix Heuristic" << endl;
+                    throw(1);
+		  }
+
+		  B_WindowSize = B_Fix + B_Overlap;
+		  // *************************************************************
+
+
+
+		  //Number of blocks of periods, clusters of items and
+		  //clusters of locations in the decomposition
+		  NT_Blocks = (T + T_Block - 1)/T_Block;
+		  NI_Clusters = (I + I_Cluster - 1)/I_Cluster;
+		  NL_Clusters = (L + L_Cluster - 1)/L_Cluster;
+
+
+
+		  //Blocks of the binary variables, i.e., the
+		  //position in the sequence of blocks where the
+		  //binary variable has its integrality added
+		  //and where its binary value is fixed
+		  IloArray<IloIntArray> BlockY(env, I);
+		  for(i=0; i<I; i++)
+		     BlockY[i] = IloIntArray(env, T);
+
+
+		  IloArray<IloIntArray> BlockZ(env, L);
+		  for(l=0; l<L; l++)
+		     BlockZ[l] = IloIntArray(env, T);
+
+
+		  IloArray<IloArray<IloIntArray> > BlockW(env, I);
+		  for(i=0; i<I; i++){
+		     BlockW[i] = IloArray<IloIntArray> (env, L);
+		     for(l=0; l<L; l++){
+		        BlockW[i][l] = IloIntArray(env, T);
+			 }
+		  }
+
+
+
+		  //Time-oriented decomposition: one block per T_Block periods
+		  if (Decomposition == "time") {
+
+						 N_Blocks = NT_Blocks;
+
+						 for(t=0; t<T; t++){
+							for(i=0; i<I; i++)
+							   BlockY[i][t] = t/T_Block;
+
+							for(l=0; l<L; l++)
+							   BlockZ[l][t] = t/T_Block;
+
+							for(i=0; i<I; i++)
+							   for(l=0; l<L; l++)
+								  BlockW[i][l][t] = t/T_Block;
+						 }
+		  }
+
+
+		  //Item-oriented decomposition: one block per cluster of items
+		  //The use of the locations (Z) is shared by all items, then
+		  //its integrality is added in the last window
+		  if (Decomposition == "item") {
+
+						 N_Blocks = NI_Clusters;
+
+						 for(t=0; t<T; t++){
+							for(i=0; i<I; i++)
+							   BlockY[i][t] = i/I_Cluster;
+
+							for(l=0; l<L; l++)
+							   BlockZ[l][t] = N_Blocks - 1;
+
+							for(i=0; i<I; i++)
+							   for(l=0; l<L; l++)
+								  BlockW[i][l][t] = i/I_Cluster;
+						 }
+		  }
+
+
+		  //Location-oriented decomposition: one block per cluster of locations
+		  //The setup of items (Y) does not depend on the locations, then
+		  //its integrality is added in the first window
+		  if (Decomposition == "location") {
+
+						 N_Blocks = NL_Clusters;
+
+						 for(t=0; t<T; t++){
+							for(i=0; i<I; i++)
+							   BlockY[i][t] = 0;
+
+							for(l=0; l<L; l++)
+							   BlockZ[l][t] = l/L_Cluster;
+
+							for(i=0; i<I; i++)
+							   for(l=0; l<L; l++)
+								  BlockW[i][l][t] = l/L_Cluster;
+						 }
+		  }
+
+
+		  //Time x item decomposition: one block per block of periods and
+		  //cluster of items, ordered by periods and then by clusters of items
+		  //The use of the locations (Z) in a block of periods is shared by all
+		  //items, then its integrality is added with the last cluster of items
+		  if (Decomposition == "timeitem") {
+
+						 N_Blocks = NT_Blocks*NI_Clusters;
+
+						 for(t=0; t<T; t++){
+							for(i=0; i<I; i++)
+							   BlockY[i][t] = (t/T_Block)*NI_Clusters + i/I_Cluster;
+
+							for(l=0; l<L; l++)
+							   BlockZ[l][t] = (t/T_Block)*NI_Clusters + NI_Clusters - 1;
+
+							for(i=0; i<I; i++)
+							   for(l=0; l<L; l++)
+								  BlockW[i][l][t] = (t/T_Block)*NI_Clusters + i/I_Cluster;
+						 }
+		  }
+
+
+
+		  //First window of the Relax-and-Fix Heuristic
+		  B_int_begin = 0;
+		  B_int_end = B_int_begin + B_WindowSize;
+		  B_int_added = 0;
+
+
+
+		  // ****************************************************************************************************
+		  //Print in the output file
+		  out << "*************** Upper Bound: Beginning of the Relax-and-Fix Heuristic ***************" << endl;
+          out << "               with " << DecompositionName << " Decomposition" << endl;
+		  out << endl << endl;
+          out << "Parameters: blocks = " << N_Blocks << endl;
+          out << "            periods-block = " << T_Block << endl;
+          out << "            items-cluster = " << I_Cluster << endl;
+          out << "            locations-cluster = " << L_Cluster << endl;
+          out << "            window = " << B_WindowSize << endl;
+          out << "            fixed = " << B_Fix << endl;
+          out << "            overlapping = " << B_Overlap << endl;
+          out << endl << endl << endl;
+		  // ****************************************************************************************************
+
+
+
+		  //Check if the last window in the 
+		  //Relax-and-Fix Heuristic is reached
+		  //(0-no; 1-yes)
+		  checkRFH_lastWindow = 0;
+
+
+		  //The first window contains all the blocks
+		  if (B_int_end >= N_Blocks) {
+								 B_int_end = N_Blocks;
+								 checkRFH_lastWindow = 1;
+		  }
+
+
+		 
+		  //Calculate the total number of windows in 
+		  //the Relax-and-Fix Heuristic in order to
+		  //calculate the time allocated to each window
+		  int nit, bb_b, bb_e;
+
+		  bb_b = 0;
+		  bb_e = bb_b + B_WindowSize;
+		  nit = 1;
+
+		  while (bb_e < N_Blocks) {
+		       nit = nit + 1;
+			   bb_b = bb_e - B_Overlap;
+			   bb_e = bb_b + B_WindowSize;
+		  }
+		 
+
+		  //Time available in each window
+		  timeWindow = TotalTime/nit;
+		  timeWindow_RFH = timeWindow;
+
+
+
+
+
+		  //Create the parameters that recover the 
+		  //binary values in the Relax-and-Fix Heuristic
+ 	      IloArray<IloNumArray> Y_fix(env, I);
+		  for(i=0; i<I; i++)
+		     Y_fix[i] = IloNumArray(env, T, 0, 1, ILOINT);
+
+
+ 	      IloArray<IloNumArray> Z_fix(env, L);
+		  for(l=0; l<L; l++)
+		     Z_fix[l] = IloNumArray(env, T, 0, 1, ILOINT);
+
+
+		  IloArray<IloArray<IloNumArray> > W_fix(env, I);
+		  for(i=0; i<I; i++){
+		     W_fix[i] = IloArray<IloNumArray> (env, L); 
+		     for(l=0; l<L; l++){ 
+		        W_fix[i][l] = IloNumArray(env, T, 0, 1, ILOINT);								
+			 }
+		  }
+
+
+
+		  //Initialize the parameters == 0
+		  for(t=0; t<T; t++)
+		     for(i=0; i<I; i++){
+			    Y_fix[i][t] = 0;
+
+			    for(l=0; l<L; l++){
+		           W_fix[i][l][t] = 0;
+				   Z_fix[l][t] = 0;
+				}
+			 }
+
+
+		 
+		  //Create the constraints that fix the binary variables 
+		  //to their binary values in the Relax-and-Fix Heuristic		 		
+		  IloArray<IloRangeArray> RestFixY(env, I); 
+	      for(i=0; i<I; i++)
+		     RestFixY[i] = IloRangeArray(env, T);
+
+
+		  IloArray<IloRangeArray> RestFixZ(env, L); 
+	      for(l=0; l<L; l++)
+		     RestFixZ[l] = IloRangeArray(env, T);
+
+
+    	  IloArray <IloArray<IloRangeArray> > RestFixW(env, I);
+		  for(i=0; i<I; i++){
+		     RestFixW[i] = IloArray<IloRangeArray>(env, L);
+		     for(l=0; l<L; l++){
+			    RestFixW[i][l] = IloRangeArray(env, T);
+			 }
+		  }	
+
+		  
+
+
+	 
+		  //Checkpoint of the run: the decomposition and the parameters
+		  //of the Relax-and-Fix Heuristic identify the run
+		  double Params_CP[6] = { (double)T_Block, (double)I_Cluster, (double)L_Cluster, (double)B_Fix, (double)B_Overlap, TotalTime };
+		  string Run_CP = CheckpointRun("RFH " + Decomposition, Params_CP, 6);
+
+		  RCLSPMSL_Checkpoint Checkpoint;
+		  double Time_Offset = 0;										  //time used by the run before it was resumed
+
+
+		  //Resume the run: the binary variables of the blocks before the
+		  //window of the checkpoint are fixed again, the integrality of the
+		  //blocks until the window is added in the loop (B_int_added = 0)
+		  if ((Resume) && LoadCheckpoint(CheckpointFile, inst_CH, Run_CP, Checkpoint)) {
+
+				  FixedFromCheckpoint(inst_CH, Checkpoint, Y_fix, Z_fix, W_fix);
+
+				  for(i=0; i<I; i++)
+				     for(t=0; t<T; t++)
+						if (BlockY[i][t] < Checkpoint.begin) {
+						   RestFixY[i][t] = (Y[i][t] == Y_fix[i][t]);
+						   RestFixY[i][t].setName("FixY");
+						   Pmodel.add(RestFixY[i][t]);
+						}
+
+				  for(l=0; l<L; l++)
+				     for(t=0; t<T; t++)
+						if (BlockZ[l][t] < Checkpoint.begin) {
+						   RestFixZ[l][t] = (Z[l][t] == Z_fix[l][t]);
+						   RestFixZ[l][t].setName("FixZ");
+						   Pmodel.add(RestFixZ[l][t]);
+						}
+
+				  for(i=0; i<I; i++)
+				     for(l=0; l<L; l++)
+				        for(t=0; t<T; t++)
+						   if (BlockW[i][l][t] < Checkpoint.begin) {
+							  RestFixW[i][l][t] = (W[i][l][t] == W_fix[i][l][t]);
+							  RestFixW[i][l][t].setName("FixW");
+							  Pmodel.add(RestFixW[i][l][t]);
+						   }
+
+				  B_int_begin = Checkpoint.begin;
+				  B_int_end = Checkpoint.end;
+				  checkRFH_lastWindow = Checkpoint.last;
+				  timeWindow_RFH = Checkpoint.timeWindow;
+				  Time_Offset = Checkpoint.timeUsed - Pcplex.getTime();
+
+
+				  out << "************ Relax-and-Fix Heuristic: Resumed from the Checkpoint File ************" << endl;
+				  out << endl << endl;
+				  out << "Checkpoint File = " << CheckpointFile << endl;
+				  out << "Windows Solved = " << Checkpoint.windows << endl;
+				  out << "Next Window (blocks) = " << B_int_begin << " - " << B_int_end - 1 << endl;
+				  out << "Time Used = " << Checkpoint.timeUsed << endl;
+				  out << endl << endl;
+				  out << "*************************************************************************************" << endl;
+				  out << endl << endl << endl << endl << endl;
+		  }
+	
+
+
+
+
+		 //LOOP Relax-and-Fix Heuristic
+		 int Trace_RFH_Windows = 0;
+		 for(; ;){
+		    
+
+
+				  RCLSPMSL_TraceScope Trace_Window("RFH window " + to_string(++Trace_RFH_Windows), "window");
+
+
+				  //Consider the integrality of the binary variables 
+			      //of the blocks from B_int_added to B_int_end, that is,
+				  //the integrality in those variables added in each window
+
+			      //Converte the linear variables to binary variables
+				  for(i=0; i<I; i++)
+					 for(t=0; t<T; t++)
+						if ((BlockY[i][t] >= B_int_added) && (BlockY[i][t] < B_int_end))
+						   Pmodel.add(IloConversion(env, Y[i][t], ILOBOOL));
+
+	 
+				  for(l=0; l<L; l++)
+					 for(t=0; t<T; t++)
+						if ((BlockZ[l][t] >= B_int_added) && (BlockZ[l][t] < B_int_end))
+						   Pmodel.add(IloConversion(env, Z[l][t], ILOBOOL));
+
+
+				  for(i=0; i<I; i++)
+					 for(l=0; l<L; l++)
+						for(t=0; t<T; t++)
+						   if ((BlockW[i][l][t] >= B_int_added) && (BlockW[i][l][t] < B_int_end))
+							  Pmodel.add(IloConversion(env, W[i][l][t], ILOBOOL));
+
+
+				  B_int_added = B_int_end;
+
+
+
+				  // ***** Solve the Resulting RCLSP-MSL *****************
+
+				  //Add CPLEX Options 
+				  //Print the output and warnings 
+		          //of cplex in the log (RCLSP-MSL_Log.h)
+				  Pcplex.setOut(Log().channel(LOG_SOLVER));
+				  Pcplex.setWarning(Log().channel(LOG_WARNING));
+
+
+				  //Limite the number of threads
+				  //in the solution of the problem
+				  Pcplex.setParam(IloCplex::Threads, Threads);
+				  if (Seed > 0) Pcplex.setParam(IloCplex::RandomSeed, Seed);
+
+
+				  //Dedecide what CPLEX reports to the screen 
+				  //during the solution of the problem
+				  Pcplex.setParam(IloCplex::MIPDisplay, 3);
+
+
+				  //Constrol the frequency of displaying node  
+				  //logging in the solution of the problem
+				  //0 - default: CPLEX's choice; 
+				  //n > 0: display new incumbents and every n nodes
+				  Pcplex.setParam(IloCplex::MIPInterval, 1000);
+
+
+				  //Set the maximum time (sec) 
+				  //to solve the problem
+		 		  Pcplex.setParam(IloCplex::TiLim, timeWindow_RFH);
+
+
+				  //Set a relative tolerance on the gap 
+				  //between the best integer objective and 
+				  //the objective of the best node remaining
+				  //CPLEX default: 1e-04 = 0.0001
+				  //Pcplex.setParam(IloCplex::EpGap, 0.001);
+
+
+
+				  //The initial solution of the Constructive Heuristic
+				  //is the MIP start only in the first window
+				  if ((found_CH) && (B_int_begin == 0))
+				     AddMIPStartYZW(env, Pcplex, inst_CH, sol_CH, Y, Z, W);
+				    else if (Pcplex.getNMIPStarts() > 0)
+				       Pcplex.deleteMIPStarts(0, Pcplex.getNMIPStarts());
+
+
+
+				  //Recover the time in
+				  //the beginning of window
+				  timeWindow_begin = Pcplex.getTime();
+
+
+
+				  // ****************************************************************************************************
+				  //Print in the output file
+				  out << "******* Solving the Resulting RCLSP-MSL problem in the Relax-and-Fix Heuristic ******" << endl;
+				  out << endl << endl;
+
+
+				  //SOLVE the resulting RCLSP-MSL problem
+				  Trace().begin("Solve MIP", "solve");
+				  Log().print(LOG_INFO, "Solve RFH window " + to_string(Trace_RFH_Windows));
+				  Timeline().begin("RFH window " + to_string(Trace_RFH_Windows));
+				  Pcplex.solve();
+				  EndTimeline(Pcplex);
+				  Trace().end("Solve MIP", "solve");
+
+
+				  out << endl << endl << endl;
+				  // ****************************************************************************************************
+
+				  
+
+
+				  //Recover the time in
+				  //the end of window
+				  timeWindow_end = Pcplex.getTime();
+
+
+				  //Calculate the time used in the window
+				  timeWindow_used = timeWindow_end - timeWindow_begin;
+
+				  
+				  //Calculate the time left in the window
+				  //after the solution of the resulting problem
+				  timeWindow_left = timeWindow_RFH - timeWindow_used; 
+
+				  
+				  //Add the time left in the window to the next window
+				  timeWindow_RFH = timeWindow + timeWindow_left;
+
+
+
+				  // ***** Check the Solution ****************************
+				  
+				  //The Relax-and-Fix Heuristic stops by infeasiblity
+				  //in one of the resulting problems or by reaching
+				  //the last iteration of the Relax-and-Fix Heuristic
+
+
+				  //The Relax-and-Fix Heuristic STOPS by infeasibility
+				  if (Pcplex.getStatus() == IloAlgorithm::Infeasible) {
+
+								  // ****************************************************************************************************
+								  //Print in the output file
+								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
+								  out << endl << endl << endl << endl << endl << endl << endl;
+								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
+							      out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
+							      out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
+								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
+								  out << endl << endl;
+							  	  out << "Solution Status = " << Pcplex.getStatus() << endl;
+								  out << "The Relax-and-Fix Heuristic is INFEASIBLE" << endl;
+								  out << "   using a " << DecompositionName << " decomposition   " << endl;	 
+								  out << endl << endl;
+								  out << "*************************************************************************************" << endl;
+								  // ****************************************************************************************************
+
+
+								  //Solution of the Constructive Heuristic
+								  //as the final solution to the RCLSP-MSL
+								  Apart_LR.wait(out, OF_LR_RCLSPMSL, Time_LR_RCLSPMSL);
+								  PrintFallbackCH(out, inst_CH, sol_CH, found_CH, OF_LR_RCLSPMSL, Time_CH);
+								  if (found_CH) Results().solution("FallbackCH", inst_CH, sol_CH, OF_LR_RCLSPMSL, Time_CH, Tol_Val);
+
+
+								  break;								  //STOP the Relax-and-Fix Heuristic by infeasibility
+				  
+
+				  }//end if infeasibility
+
+
+
+
+
+				  //The Relax-and-Fix Heuristic STOPS by reaching
+				  //the last iteration and return the final solution 
+				  //of the Relax-and-Fix Heuristic to the RCLSP-MSL
+				  if (checkRFH_lastWindow == 1) {
+
+
+				      //Check if the solution of the Problem is 
+					  //Optimal-1 or Feasible-2
+					  //The final solution of the Relax-and-Fix Heuristic 
+					  //is a feasible solution to the RCLSP-MSL
+					  if ((Pcplex.getStatus() == IloAlgorithm::Optimal) || 
+						  (Pcplex.getStatus() == IloAlgorithm::Feasible)) {
+
+
+			  					  //The objective function value
+								  OF_RFH = Pcplex.getValue(Pof);
+
+
+								  //Computational time 
+								  Time_RFH = Pcplex.getTime() + Time_Offset;
+
+
+								  //Calculate the gap considering the
+								  //linear relaxation as the lower bound
+								  Apart_LR.wait(out, OF_LR_RCLSPMSL, Time_LR_RCLSPMSL);
+								  Trace().step("Run", "Report");
+								  Gap_RFH = 100*((OF_RFH - OF_LR_RCLSPMSL)/OF_RFH);
+
+
+					  
+								  // ************************ //
+								  //    Other Calculations    // 
+								  // ************************ //
+
+
+								  double CSetupItem = 0,
+										 CInventItem = 0,
+										 CHandItem = 0, 
+										 CSetupLocal = 0, 
+										 CRelocItem = 0,
+							 
+										 NSetupItem = 0,
+										 NInventItem = 0,
+										 NHandItem = 0,
+										 NLocalUsed = 0,
+										 NRelocItem = 0,
+
+										 TotalOpenSpace = 0,
+										 TotalUsedSpace = 0,
+										 PercUsedSpace = 0;
+
+
+
+								  //Cost and number of setups 
+								  //in the production of items
+								  for(t=0; t<T; t++)
+									 for(i=0; i<I; i++)
+										if (Pcplex.getValue(Y[i][t]) > 0.00001) {
+										   CSetupItem += sc[i]*(Pcplex.getValue(Y[i][t]));
+
+										   NSetupItem += Pcplex.getValue(Y[i][t]);
+										}
+
+
+								  //Inventory costs of items
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(S[i][l][t]) > 0.00001){
+											  CInventItem += hc[i]*(Pcplex.getValue(S[i][l][t]));
+
+											  NInventItem += Pcplex.getValue(S[i][l][t]);
+										   }
+
+
+								  //Number and cost of handled items
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(Dp[i][l][t]) > 0.00001) {
+											  CHandItem += ha[i][l]*(Pcplex.getValue(Dp[i][l][t]));
+
+											  NHandItem += Pcplex.getValue(Dp[i][l][t]);
+										   }
+
+
+
+								  //Number and setup cost of used locations
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										if (Pcplex.getValue(Z[l][t]) > 0.00001) {
+										   CSetupLocal += g[l]*(Pcplex.getValue(Z[l][t]));
+
+										   NLocalUsed += Pcplex.getValue(Z[l][t]);
+										}
+
+
+								  //Number and cost of relocated items
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(k=0; k<L; k++)
+										   for(i=0; i<I; i++)
+											  if ((l != k) && (V.value(Pcplex, i, l, k, t) > 0.00001)) {
+												 CRelocItem += r[i][l][k]*(V.value(Pcplex, i, l, k, t));
+
+												 NRelocItem += V.value(Pcplex, i, l, k, t);
+											  }
+
+								  
+								  
+								  //Total available space of used locations
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										TotalOpenSpace += H[l]*(Pcplex.getValue(Z[l][t]));
+
+
+								  //Total used space in the locations;
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   TotalUsedSpace += cs[i]*(Pcplex.getValue(S[i][l][t]));
+
+
+								  //Percentage of used space
+								  //over all the opened space
+								  PercUsedSpace = 100*(TotalUsedSpace/TotalOpenSpace);
+ 
+	  
+
+
+
+								  // ****************************************************************************************************
+								  //Print in the output file
+								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
+								  out << endl << endl << endl << endl << endl << endl << endl;
+								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
+								  out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
+								  out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
+								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
+								  out << endl << endl;
+								  out << "Objective Function Value = " << OF_RFH << endl; 
+								  out << "Gap = " << Gap_RFH << endl;
+								  out << "Time = " << Time_RFH << endl;
+								  out << endl << endl;
+								  out << "*************************************************************************************" << endl;
+								  out << endl << endl << endl;
+								  out << "************************************ Other Values ***********************************" << endl;
+								  out << endl;
+								  out << "Setup Cost Item = " << CSetupItem << endl;
+								  out << "Inventory Cost Item = " << CInventItem << endl;
+								  out << "Handling Cost Item = " << CHandItem << endl;
+								  out << "Setup Cost Location = " << CSetupLocal << endl;
+								  out << "Relocation Cost Item = " << CRelocItem << endl;
+								  out << endl;
+								  out << "Number Setup Item = " << NSetupItem << endl;
+								  out << "Number Inventoried Item = " << NInventItem << endl;
+								  out << "Number Handled Item = " << NHandItem << endl;
+								  out << "Number Used Location = " << NLocalUsed << endl;
+								  out << "Number Relocated Item = " << NRelocItem << endl;
+								  out << endl;
+								  out << "Total Opened Space = " << TotalOpenSpace << endl;
+								  out << "Total Used Space = " << TotalUsedSpace << endl;
+								  out << "Percentage Used Space = " << PercUsedSpace << endl;
+								  out << endl;
+								  out << "*************************************************************************************" << endl;
+								  out << endl;
+								  out << endl;
+								  out << endl;
+								  out << endl;
+								  out << endl;
+								  for(t=0; t<T; t++)
+									 for(i=0; i<I; i++)
+										if (Pcplex.getValue(Y[i][t]) > 0.00001)
+										   out << "Y_" << i+1 << "_" << t+1 << " = " << Pcplex.getValue(Y[i][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(S[i][l][t]) > 0.00001)
+											  out << "S_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(S[i][l][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										if (Pcplex.getValue(Z[l][t]) > 0.00001)
+										   out << "Z_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Z[l][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(W[i][l][t]) > 0.00001)
+											  out << "W_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(W[i][l][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(Dp[i][l][t]) > 0.00001)
+											  out << "Dp_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Dp[i][l][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(Dm[i][l][t]) > 0.00001)
+											  out << "Dm_" << i+1 << "_" << l+1 << "_" << t+1 << " = " << Pcplex.getValue(Dm[i][l][t]) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(l=0; l<L; l++)  
+										for(k=0; k<L; k++)  
+										   for(i=0; i<I; i++)
+											  if ((l != k) && (V.value(Pcplex, i, l, k, t) > 0.00001))
+												 out << "V_" << i+1 << "_" << l+1 << "_" << k+1 << "_" << t+1 << " = " << V.value(Pcplex, i, l, k, t) << endl;
+
+								  out << endl << endl;
+
+								  for(t=0; t<T; t++)
+									 for(tau = t; tau<T; tau++)
+										for(i=0; i<I; i++)
+										   if (Pcplex.getValue(FL[i][t][tau]) > 0.00001)
+											   out << "FL_" << i+1 << "_" << t+1 << "_" << tau+1 << " = " << Pcplex.getValue(FL[i][t][tau]) << endl;
+
+								  // ******************************************************************************************************************
+
+
+								  //Check the final solution against all the constraints of the RCLSP-MSL,
+								  //independently of the optimization package. See RCLSP-MSL_Validator.h
+								  RCLSPMSL_Solution sol_Final;
+								  SolutionFromCplex(Pcplex, inst_CH, sol_Final, Y, S, Z, Dp, Dm, W, V, FL);
+								  Results().solution("Feasible", inst_CH, sol_Final, OF_LR_RCLSPMSL, Time_RFH, Tol_Val);
+
+								  out << endl << endl << endl << endl << endl;
+								  PrintValidation(out, Validate(inst_CH, sol_Final, Tol_Val));
+								  UpdateIncumbent(RunCache, inst_CH, sol_Final, "RFH");
+
+
+								  //Improve the final solution by the Local Search
+								  //See RCLSP-MSL_LocalSearch.h
+								  if (Params_LS.timeLimit > 0) {
+								     RCLSPMSL_Solution sol_LS = sol_Final;
+								     RCLSPMSL_LSResult res_LS = LocalSearch(inst_CH, sol_LS, Params_LS);
+
+								     PrintLocalSearch(out, inst_CH, sol_LS, res_LS, OF_LR_RCLSPMSL);
+								     out << endl << endl << endl << endl << endl;
+								     PrintValidation(out, Validate(inst_CH, sol_LS, Tol_Val));
+								     UpdateIncumbent(RunCache, inst_CH, sol_LS, "RFH");
+								     if (res_LS.OF_end < res_LS.OF_begin) Results().solution("LocalSearch", inst_CH, sol_LS, OF_LR_RCLSPMSL, Time_RFH + res_LS.Time, Tol_Val);
+								  }
+
+
+								  break;								  //STOP the Relax-and-Fix Heuristic
+
+
+					  }//end if optimal/feasible
+
+					    else {
+
+								  // ****************************************************************************************************
+								  //Print in the output file
+								  out << "****************** Upper Bound: The End of Relax-and-Fix Heuristic ******************" << endl;
+								  out << endl << endl << endl << endl << endl << endl << endl;
+								  out << "*************** Final Solution to the Facility Location Reformulation ***************" << endl;
+								  out << "***************     of the General Capacitated Lot-Sizing Problem     ***************" << endl;
+								  out << "***************      with Multiple Storage Locations (RCLSP-MSL)      ***************" << endl;
+								  out << "***************          solved by a Relax-and-Fix Heuristic          ***************" << endl;
+								  out << endl << endl;
+								  out << "Solution Status = " << Pcplex.getStatus() << endl;
+					              out << "NO Solution to the RCLSP-MSL" << endl;
+								  out << endl << endl;
+								  out << "*************************************************************************************" << endl;
+								  // ***************************************************************************************************
+
+
+								  //Solution of the Constructive Heuristic
+								  //as the final solution to the RCLSP-MSL
+								  Apart_LR.wait(out, OF_LR_RCLSPMSL, Time_LR_RCLSPMSL);
+								  PrintFallbackCH(out, inst_CH, sol_CH, found_CH, OF_LR_RCLSPMSL, Time_CH);
+								  if (found_CH) Results().solution("FallbackCH", inst_CH, sol_CH, OF_LR_RCLSPMSL, Time_CH, Tol_Val);
+
+
+								  break;								  //STOP the Relax-and-Fix Heuristic
+
+
+						}//end else
+
+
+
+				  }//end if (checkRF_lastWindow == 1)
+
+				  // *****************************************************
+
+
+				  
+				  //Recover the values of the binary variables of the
+				  //fixed blocks in the Relax-and-Fix Heuristic
+				  for(i=0; i<I; i++)
+				     for(t=0; t<T; t++)
+						if ((BlockY[i][t] >= B_int_begin) && (BlockY[i][t] < (B_int_begin+B_Fix)))
+					       Y_fix[i][t] = Pcplex.getValue(Y[i][t]);
+
+
+				  for(l=0; l<L; l++)
+				     for(t=0; t<T; t++)
+						if ((BlockZ[l][t] >= B_int_begin) && (BlockZ[l][t] < (B_int_begin+B_Fix)))
+					       Z_fix[l][t] = Pcplex.getValue(Z[l][t]);
+
+
+				  for(i=0; i<I; i++)
+				     for(l=0; l<L; l++)
+						for(t=0; t<T; t++)
+						   if ((BlockW[i][l][t] >= B_int_begin) && (BlockW[i][l][t] < (B_int_begin+B_Fix)))
+					          W_fix[i][l][t] = Pcplex.getValue(W[i][l][t]);
+
+
+
+				  
+				  //Add the constraints that fix the binary variables 
+				  //at their values in the Relax-and-Fix Heuristic
+				  for(i=0; i<I; i++)
+				     for(t=0; t<T; t++)
+						if ((BlockY[i][t] >= B_int_begin) && (BlockY[i][t] < (B_int_begin+B_Fix))) {
+						   IloExpr fix(env);
+						   
+						   fix += Y[i][t];
+						   
+						   RestFixY[i][t] = (fix == Y_fix[i][t]);
+						   RestFixY[i][t].setName("FixY");
+						   Pmodel.add(RestFixY[i][t]);
+
+						   fix.end();
+						}
+
+
+				  for(l=0; l<L; l++)
+				     for(t=0; t<T; t++)
+						if ((BlockZ[l][t] >= B_int_begin) && (BlockZ[l][t] < (B_int_begin+B_Fix))) {
+						   IloExpr fix(env);
+						   
+						   fix += Z[l][t];
+						   
+						   RestFixZ[l][t] = (fix == Z_fix[l][t]);
+						   RestFixZ[l][t].setName("FixZ");
+						   Pmodel.add(RestFixZ[l][t]);
+
+						   fix.end();
+						}
+
+
+				  for(i=0; i<I; i++)
+				     for(l=0; l<L; l++)
+				        for(t=0; t<T; t++)
+						   if ((BlockW[i][l][t] >= B_int_begin) && (BlockW[i][l][t] < (B_int_begin+B_Fix))) {
+							  IloExpr fix(env);
+						   
+							  fix += W[i][l][t];
+						   
+							  RestFixW[i][l][t] = (fix == W_fix[i][l][t]);
+							  RestFixW[i][l][t].setName("FixW");
+							  Pmodel.add(RestFixW[i][l][t]);
+
+							  fix.end();
+						   }
+
+
+
+				  //Move the window in the
+				  //Relax-and-Fix Heuristic
+				  B_int_begin = B_int_end - B_Overlap;
+
+				  B_int_end   = B_int_begin + B_WindowSize;
+			  
+
+				  //Check if the last window of the
+				  //Relax-and-Fix Heuristic is reached 
+				  //If yes, the next iteration is the
+				  //last iteration of the heuristic
+				  if (B_int_end >= N_Blocks) {
+										 B_int_end = N_Blocks;
+										 checkRFH_lastWindow = 1;
+				  }
+
+
+
+				  //Write the checkpoint: fixed binary
+				  //variables, next window and time used
+				  if (!CheckpointFile.empty()) {
+					  FixedToCheckpoint(inst_CH, Y_fix, Z_fix, W_fix, Checkpoint);
+
+					  Checkpoint.windows++;
+					  Checkpoint.begin = B_int_begin;
+					  Checkpoint.end = B_int_end;
+					  Checkpoint.last = checkRFH_lastWindow;
+					  Checkpoint.timeLimit = TotalTime;
+					  Checkpoint.timeWindow = timeWindow_RFH;
+					  Checkpoint.timeUsed = Pcplex.getTime() + Time_Offset;
+					  Checkpoint.OF = Pcplex.getValue(Pof);
+
+					  if (!SaveCheckpoint(CheckpointFile, inst_CH, Run_CP, Checkpoint))
+						 cerr << "The checkpoint file " << CheckpointFile << " could not be written" << endl;
+				  }
+
+
+
+		 }//end for ;;
+		 //Relax-and-Fix Heuristic LOOP
+
+		 // **************************************************************
+
+
+		 //End the parameters of the
+		 //Relax-and-Fix Heuristic
+		 Y_fix.end();
+		 Z_fix.end();
+		 W_fix.end();
+		 RestFixY.end();
+		 RestFixZ.end();
+		 RestFixW.end();
+		 BlockY.end();
+		 BlockZ.end();
+		 BlockW.end();
+
+		 
+
+// ******************************************** //
+//    The End of the Relax-and-Fix Heuristic    //
+// ******************************************** //
+
+
+
+
+
+		  //Primal integral and time to target of the solves of the MIPs
+		  out << endl << endl << endl << endl << endl;
+		  PrintTimeline(out, Timeline());
+		  Timeline().write();
+		  Log().close();
+
+
+
+		  //Memory of the phases and sizes of the families of the model
+		  Trace().step("Run", "");
+		  if (Options.getInt("memory", 1) != 0) {
+			 out << endl << endl << endl << endl << endl;
+			 PrintMemory(out, Trace().memory(), T, I, L, V.created());
+		  }
+
+
+
+		  //Record of the run (see RCLSP-MSL_Results.h)
+		  Results().size(T, I, L);
+		  Results().write();
+
+
+
+// ********************************************************************************************** //
+// *************************************** END MAIN PROGRAM ************************************* //
+// ********************************************************************************************** //
+
+
+
+   } //end try
+
+
+      catch (IloException& ex) {
+        cerr << "Error Cplex: " << ex << endl;
+      } 
+	  catch (...) {
+        cerr << "Error Cpp" << endl;
+      }
+     
+
+	  //Finish the enviroment
+	  env.end();
+
+	
+	return 0;
+
+}
+
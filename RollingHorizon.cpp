@@ -0,0 +1,373 @@
+// ************************************************************************************* //
+//   Rolling-horizon re-planning of the Facility Location Reformulation of the General   //
+//      Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)       //
+//	 																					 //
+//	  The model of the instance is loaded once and kept with the last plan. For each	 //
+//	  demand update (periods executed, realised demand and forecast) only the values	 //
+//	  that depend on the demand are changed (ChangeDemand), the executed periods	 //
+//	  (binary variables, production and storage) are frozen at the plan, and the	 //
+//	  periods affected by the update are solved again by time-windows, as in the	 //
+//	  Fix-and-Optimize Heuristic (SH_v4_FO.cpp): the binary variables of the		 //
+//	  window are free, the others are fixed at the last plan, which is the MIP		 //
+//	  start of each window												 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <ilcplex/cplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Callable.h"
+#include "RCLSP-MSL_Cache.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Results.h"
+
+
+using namespace std;
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+//Result of a plan (initial plan or re-plan of a demand update)
+struct ReplanResult {
+
+	int executed;													  //periods executed (frozen)
+	int first;														  //first period solved again (T: none)
+	int windows;													  //time-windows solved
+	bool solved;													  //the plan has a solution
+	bool full;														  //all the affected periods were solved at once (a window had no solution)
+	bool frozen;													  //production and storage of the executed periods frozen (else only the binary variables)
+	double OF, Time;
+	bool feasible;													  //plan accepted by the validator
+
+	ReplanResult() : executed(0), first(0), windows(0), solved(false), full(false), frozen(false), OF(0), Time(0), feasible(false) {}
+
+};
+
+
+
+
+//First period in which the demand of some item changed
+//Return T if the demand did not change
+static int FirstChanged(const RCLSPMSL_Instance &inst, const vector<double> &before, const vector<double> &after)
+{
+	for(int t = 0; t < inst.T; t++)
+	   for(int i = 0; i < inst.I; i++)
+		  if (fabs(before[inst.it(i, t)] - after[inst.it(i, t)]) > 1e-9) return t;
+
+	return inst.T;
+}
+
+
+
+
+//Print a plan in the output file
+static void PrintReplan(ostream &out, const char *step, const ReplanResult &res, int T)
+{
+	out << setw(8) << step << setw(10) << res.executed;
+
+	if (res.first < T) out << setw(8) << res.first;
+	  else out << setw(8) << "-";
+
+	out << setw(9) << res.windows << setw(10) << ((!res.solved) ? "NoSol" : (res.full) ? "Full" : "Windows");
+	out << setw(9) << ((res.executed == 0) ? "-" : (res.frozen) ? "All" : "Binary");
+
+	if (res.solved) out << fixed << setprecision(2) << setw(16) << res.OF << setw(9) << ((res.feasible) ? "Yes" : "No");
+	  else out << setw(16) << "-" << setw(9) << "-";
+
+	out << fixed << setprecision(2) << setw(10) << res.Time << endl;
+	out.unsetf(ios::floatfield);
+	out << setprecision(6);
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 4) {
+		cerr << "Usage: RollingHorizon <input data file> <demand update file or -> <output data file> [fix=n] "
+				"[overlap=n] [time=s] [initial_time=s] [threads=n] [gap=g] [cache=file] [plan=file] [trace=file] "
+				"[results=file] [solution=file] [archive=file]" << endl;
+		return 1;
+	}
+
+
+	//Input Data File and Demand Update File (- : standard input,
+	//the updates are solved as they arrive)
+	ifstream in(argv[1]);
+	ifstream inup;
+	string Updates = argv[2];
+	if (Updates != "-") inup.open(argv[2]);
+	istream &updates = (Updates != "-") ? (istream &)inup : cin;
+
+
+	//Output Data File
+	ofstream out(argv[3]);
+
+
+	//Options: fix, overlap - periods fixed and overlapping in each time-window
+	//(time-window = fix + overlap periods, as in the Fix-and-Optimize Heuristic)
+	//time         - time limit of each re-plan (seconds)
+	//initial_time - time limit of the initial plan (seconds)
+	//threads      - threads of the optimization package
+	//gap          - relative gap of each problem
+	//cache        - file of the cache of the sparse rows (RCLSP-MSL_Cache.h)
+	//plan         - file of the last plan, written after each re-plan
+	//trace        - file of the trace events of the phases (RCLSP-MSL_Trace.h)
+	//results      - file of the records of the runs (the output data file with .json if it is not given)
+	//solution     - CSV file of the nonzero variables of the last plan (RCLSP-MSL_Results.h)
+	RCLSPMSL_Options Options(argc, argv, 4);
+	int T_Fix = Options.getInt("fix", 1);
+	int T_Overlap = Options.getInt("overlap", 2);
+	double TimeLimit = Options.getNum("time", 10);
+	double TimeLimit_Initial = Options.getNum("initial_time", 1800);
+	int Threads = Options.getInt("threads", 1);
+	double Gap = Options.getNum("gap", 0.0001);
+	string Cache = Options.getString("cache", "");
+	string PlanFile = Options.getString("plan", "");
+	Trace().open(Options.getString("trace", ""), "RollingHorizon");
+	Results().open(Options.getString("results", string(argv[3]) + ".json"), Options.getString("solution", ""), "RollingHorizon", argv[1]);
+	Results().setArchive(Options.getString("archive", ""));
+
+	if ((T_Fix < 1) || (T_Overlap < 0)) {
+		cerr << "Invalid parameters of the time-windows" << endl;
+		return 1;
+	}
+
+
+
+	//Read the instance
+	Trace().step("Run", "Read instance");
+	RCLSPMSL_Instance inst;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+	if ((Updates != "-") && !inup) {
+		cerr << "No such file: " << argv[2] << endl;
+		return 1;
+	}
+
+	int T = inst.T;
+
+
+
+	// ***** Build and load the model once (demand of the instance) *****
+
+	Trace().step("Run", "Build model");
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	RCLSPMSL_Columns col;
+	vector<RCLSPMSL_Rows> rows(ROW_NFAMILIES);
+
+	if (!Cache.empty()) CachedModel(Cache, inst, col, rows, Threads);
+	  else {
+		col.build(inst, true);
+		BuildModel(inst, col, rows, Threads);
+	}
+
+	int status = 0;
+	CPXENVptr env = CPXopenCPLEX(&status);
+	CPXLPptr lp = NULL;
+
+	if (env != NULL) {
+		CPXsetintparam(env, CPX_PARAM_SCRIND, CPX_OFF);
+		CPXsetintparam(env, CPX_PARAM_THREADS, Threads);
+		CPXsetdblparam(env, CPX_PARAM_EPGAP, Gap);
+		lp = CPXcreateprob(env, &status, "RCLSP-MSL");
+	}
+
+	if (lp != NULL) status = LoadModel(env, lp, col, rows, true);
+
+	if ((env == NULL) || (lp == NULL) || status) {
+		cerr << "Could not load the model, status " << status << endl;
+		if (lp != NULL) CPXfreeprob(env, &lp);
+		if (env != NULL) CPXcloseCPLEX(&env);
+		return 1;
+	}
+
+	double Time_Build = Elapsed(begin);
+
+
+
+	// ****************************************************************************************************
+	//Print in the output file
+	out << "***** Rolling-Horizon Re-Planning of the Facility Location Reformulation of the General *****" << endl;
+	out << "*****      Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)      *****" << endl;
+	out << endl << endl;
+	out << "T = " << inst.T << "  I = " << inst.I << "  L = " << inst.L << endl;
+	out << "Time-window = " << T_Fix + T_Overlap << "  Fixed = " << T_Fix << "  Overlap = " << T_Overlap << endl;
+	out << "Time Limit = " << TimeLimit << "  Initial Time Limit = " << TimeLimit_Initial << "  Gap = " << Gap << endl;
+	out << endl;
+	out << "Build Time = " << Time_Build << endl;
+	out << endl << endl;
+	out << "************************************** Plans ****************************************" << endl;
+	out << endl;
+
+	out << setw(8) << "Step" << setw(10) << "Executed" << setw(8) << "First" << setw(9) << "Windows"
+		<< setw(10) << "Solved" << setw(9) << "Frozen" << setw(16) << "OF" << setw(9) << "Valid" << setw(10) << "Time" << endl;
+	// ****************************************************************************************************
+
+
+
+	// ***** Initial plan: the whole horizon, from the Constructive Heuristic *****
+
+	RCLSPMSL_Solution plan;
+	ReplanResult res;
+	string message;
+
+	Trace().step("Run", "Initial plan");
+	begin = std::chrono::steady_clock::now();
+
+	bool start = ConstructiveHeuristic(inst, plan, message);
+
+	res.solved = SolveColumns(env, lp, inst, col, plan, start, TimeLimit_Initial);
+	res.full = true;
+	res.windows = 1;
+	res.Time = Elapsed(begin);
+
+	if (res.solved) {
+		res.OF = ComputeCosts(inst, plan).OF;
+		res.feasible = Validate(inst, plan).feasible();
+	}
+
+	PrintReplan(out, "Initial", res, T);
+	out.flush();
+
+	if (!res.solved) {
+		cerr << "No initial plan" << endl;
+		CPXfreeprob(env, &lp);
+		CPXcloseCPLEX(&env);
+		return 2;
+	}
+
+
+
+	// ***** Re-plan of each demand update *****
+
+	int executed = 0, step = 0, Solved = 0;
+	vector<double> demand;
+
+	while (ReadDemandUpdate(updates, inst, executed, demand)) {
+
+		begin = std::chrono::steady_clock::now();
+		res = ReplanResult();
+		res.executed = executed;
+		step++;
+
+		Trace().step("Run", "Re-plan " + to_string(step));
+
+
+		//Periods affected by the update: from the first period with a new
+		//demand, with the overlap of a window before it (the setups before
+		//a period produce for it), but never an executed period
+		int changed = FirstChanged(inst, inst.d, demand);
+
+		res.first = (changed < T) ? max(executed, changed - T_Overlap) : T;
+
+		inst.d = demand;
+		status = ChangeDemand(env, lp, inst, col, rows);
+
+
+		//Solve the time-windows from the first affected period: binary
+		//variables of the window free, executed periods and the other
+		//periods fixed at the plan (FixAndOptimizeColumns); the production
+		//and storage of the executed periods are also fixed at the plan
+		if (status == 0) status = FixExecuted(env, lp, inst, col, plan, executed, true);
+
+		res.frozen = true;
+		res.solved = (status == 0) &&
+					 FixAndOptimizeColumns(env, lp, inst, col, plan, res.first, T_Fix, T_Overlap, TimeLimit, res.windows, res.full);
+
+
+		//The frozen executed periods have no solution if the realised demand of an
+		//executed period is not the planned one, or if the forecast of a period is
+		//below the production already made for it: the update is solved again
+		//with only the binary variables of the executed periods frozen
+		if ((!res.solved) && (status == 0) && (executed > 0)) {
+			status = FixExecuted(env, lp, inst, col, plan, executed, false);
+
+			res.frozen = false;
+			res.solved = (status == 0) &&
+						 FixAndOptimizeColumns(env, lp, inst, col, plan, res.first, T_Fix, T_Overlap, TimeLimit, res.windows, res.full);
+		}
+
+
+		//If the demand of the open periods did not change the
+		//plan is kept (its executed periods are frozen when the
+		//next update is solved)
+
+		res.Time = Elapsed(begin);
+
+		if (res.solved) {
+			res.OF = ComputeCosts(inst, plan).OF;
+			res.feasible = Validate(inst, plan).feasible();
+			Solved++;
+
+			if (!PlanFile.empty()) {
+				ofstream outplan(PlanFile.c_str());
+				PrintSolution(outplan, inst, plan);
+			}
+		}
+
+		PrintReplan(out, to_string(step).c_str(), res, T);
+		out.flush();
+	}
+
+
+
+	// ****************************************************************************************************
+	//Print in the output file
+	Trace().step("Run", "Report");
+	out << endl << endl;
+	out << "Demand Updates = " << step << endl;
+	out << "Solved Updates = " << Solved << endl;
+	out << endl << endl;
+	out << "*************************************************************************************" << endl;
+	// ****************************************************************************************************
+
+
+	//Record of the run: the last plan, with the time of the last re-plan
+	//(status Partial if some update had no solution)
+	Trace().step("Run", "");
+	Results().solution((Solved == step) ? "Feasible" : "Partial", inst, plan, NAN, res.Time);
+	Results().write();
+
+
+	CPXfreeprob(env, &lp);
+	CPXcloseCPLEX(&env);
+
+	return (Solved == step) ? 0 : 2;
+
+}
@@ -0,0 +1,421 @@
+// ************************************************************************************* //
+//     Scaling study of the Facility Location Reformulation of the General Capacitated  //
+//          Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)              //
+//	 																					 //
+//	  From a base size, the instances are generated along each axis (I, L and T,		 //
+//	  the other two at the base size, RCLSP-MSL_Generator.h) and each instance is		 //
+//	  run by CSR (construction by Concert and by the sparse rows, linear relaxation	 //
+//	  and peak memory) and by a heuristic (time, gap to the linear relaxation, time	 //
+//	  to the target gap and peak memory). For each axis and measure the exponent b	 //
+//	  of the growth a*x^b is fitted (least squares of the logarithms), and the		 //
+//	  measures are projected to the target size with the exponents of the three		 //
+//	  axes, with the rows and nonzeros of each family at the target size				 //
+//																						 //
+//	  Study file, one list in each line (# begins a comment):						 //
+//	     base <T> <I> <L>															 //
+//	     I <values> / L <values> / T <values> (the sizes of each axis)				 //
+//	     target <T> <I> <L>															 //
+//	     heuristic <program> (no heuristic if it is not given)						 //
+//	     options <name=value> ... (given to the runs of the heuristic)				 //
+//	     generator <name=value> ... (parameters of InstanceGenerator)				 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Json.h"
+#include "RCLSP-MSL_Generator.h"
+#include "RCLSP-MSL_Memory.h"
+
+
+using namespace std;
+
+
+
+//Measures of the study
+enum { M_CONCERT_BUILD, M_CSR_BUILD, M_LR, M_LR_MEMORY, M_HEUR_TIME, M_HEUR_GAP, M_HEUR_TARGET, M_HEUR_MEMORY, M_N };
+
+static const char *MeasureName[M_N] = { "concert_build", "csr_build", "lr", "lr_memory_mb", "heuristic_time",
+										"heuristic_gap", "time_to_target", "heuristic_memory_mb" };
+
+
+
+
+//Point of the study: size and measures (NAN if the run has no such measure)
+struct StudyPoint {
+
+	string axis;
+	int T, I, L;
+	long long rows, nonzeros;
+	string largest;													  //family of constraints with most nonzeros
+	double m[M_N];
+
+	StudyPoint() : T(0), I(0), L(0), rows(0), nonzeros(0) { for(int a = 0; a < M_N; a++) m[a] = NAN; }
+
+	int size(const string &ax) const { return (ax == "T") ? T : (ax == "I") ? I : L; }
+
+};
+
+
+
+
+//Read the lists of the study file
+//Return false if there is no base size
+static bool ReadStudy(istream &in, map<string, vector<string> > &lists)
+{
+	string line, word, name;
+
+	while (getline(in, line)) {
+		if (line.find('#') != string::npos) line.erase(line.find('#'));
+
+		istringstream words(line);
+		if (!(words >> name)) continue;
+
+		while (words >> word)
+			lists[name].push_back(word);
+	}
+
+	return lists["base"].size() == 3;
+}
+
+
+
+
+//Last record of the results file of a run (false if there is none)
+static bool ReadRecord(const string &file, RCLSPMSL_Json &rec)
+{
+	ifstream in(file.c_str());
+	string line, last;
+
+	while (getline(in, line))
+		if (!line.empty()) last = line;
+
+	return !last.empty() && ReadJson(last, rec);
+}
+
+
+//Time of a phase of the record (0 if the record does not have it)
+static double PhaseTime(const RCLSPMSL_Json &rec, const string &phase)
+{
+	const RCLSPMSL_Json *phases = rec.get("phases");
+	return (phases != NULL) ? phases->getNum(phase, 0) : 0;
+}
+
+
+
+
+//Write a value of the tables (empty if it is NAN)
+static string Value(double v)
+{
+	if (std::isnan(v)) return "";
+
+	char text[40];
+	sprintf(text, "%.10g", v);
+	return text;
+}
+
+
+
+
+//Fit of y = a*x^b by least squares of log y over log x: exponent b and R^2
+//Return false if there are less than two points with positive values
+static bool FitExponent(const vector<double> &x, const vector<double> &y, double &b, double &r2)
+{
+	double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0;
+
+	for(size_t a = 0; a < x.size(); a++){
+		if (!(x[a] > 0) || !(y[a] > 0)) continue;
+
+		double lx = log(x[a]), ly = log(y[a]);
+		n++; sx += lx; sy += ly; sxx += lx*lx; sxy += lx*ly; syy += ly*ly;
+	}
+
+	double vx = n*sxx - sx*sx, vy = n*syy - sy*sy;
+	if ((n < 2) || (vx <= 0)) return false;
+
+	b = (n*sxy - sx*sy)/vx;
+	if (fabs(b) < 1e-9) b = 0;
+	r2 = (vy > 0) ? (n*sxy - sx*sy)*(n*sxy - sx*sy)/(vx*vy) : 1;
+	return true;
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 3) {
+		cerr << "Usage: ScalingStudy <study file> <output table> [fit=file] [bin=directory] [work=directory] [target_gap=%]" << endl;
+		return 1;
+	}
+
+
+	//Study File
+	ifstream in(argv[1]);
+	map<string, vector<string> > lists;
+
+	if (!in || !ReadStudy(in, lists)) {
+		cerr << "No base size in the file: " << argv[1] << endl;
+		return 1;
+	}
+
+
+	//Options: fit - table of the exponents and of the projection (the output table with .fit.csv)
+	//bin - directory of the programs; work - directory of the instances and of the runs
+	//target_gap - target gap (%) of the runs of the heuristic
+	RCLSPMSL_Options Options(argc, argv, 3);
+	string Fit = Options.getString("fit", string(argv[2]) + ".fit.csv");
+	string Bin = Options.getString("bin", ".");
+	string Work = Options.getString("work", ".");
+	double TargetGap = Options.getNum("target_gap", 1);
+
+	string Heuristic = (lists["heuristic"].empty()) ? "" : lists["heuristic"][0];
+	string HeurOptions;
+	for(size_t a = 0; a < lists["options"].size(); a++)
+		HeurOptions += " " + lists["options"][a];
+
+
+	//Parameters of the generator
+	RCLSPMSL_Options Gen(0, NULL, 0);
+	for(size_t a = 0; a < lists["generator"].size(); a++){
+		string g = lists["generator"][a];
+		if (g.find('=') != string::npos) Gen.set(g.substr(0, g.find('=')), g.substr(g.find('=') + 1));
+	}
+
+	RCLSPMSL_GeneratorParams par;
+	par.seed = (unsigned)Gen.getInt("seed", par.seed);
+	par.capacity = Gen.getNum("capacity", par.capacity);
+	par.storage = Gen.getNum("storage", par.storage);
+	par.alpha = Gen.getNum("alpha", par.alpha);
+	par.beta = Gen.getNum("beta", par.beta);
+	par.demand = Gen.getNum("demand", par.demand);
+	par.dmin = Gen.getInt("dmin", par.dmin);
+	par.dmax = Gen.getInt("dmax", par.dmax);
+	par.relocation = max(0, RelocationStructure(Gen.getString("relocation", RelocationName(par.relocation))));
+
+
+	//Sizes of the study: the base and the values of each axis
+	int Base[3] = { atoi(lists["base"][0].c_str()), atoi(lists["base"][1].c_str()), atoi(lists["base"][2].c_str()) };
+	int Target[3] = { Base[0], Base[1], Base[2] };
+	if (lists["target"].size() == 3)
+		for(int a = 0; a < 3; a++) Target[a] = atoi(lists["target"][a].c_str());
+
+	const char *Axes[3] = { "T", "I", "L" };
+	vector<StudyPoint> points;
+
+	for(int ax = 0; ax < 3; ax++){
+		vector<string> &values = lists[Axes[ax]];
+		if (find(values.begin(), values.end(), lists["base"][ax]) == values.end()) values.push_back(lists["base"][ax]);
+
+		for(size_t v = 0; v < values.size(); v++){
+			StudyPoint p;
+			p.axis = Axes[ax];
+			p.T = (ax == 0) ? atoi(values[v].c_str()) : Base[0];
+			p.I = (ax == 1) ? atoi(values[v].c_str()) : Base[1];
+			p.L = (ax == 2) ? atoi(values[v].c_str()) : Base[2];
+			if ((p.T > 0) && (p.I > 0) && (p.L > 0)) points.push_back(p);
+		}
+	}
+
+
+
+	// ***** Runs of the points (the base, in every axis, is run once) *****
+
+	map<string, StudyPoint> done;
+
+	for(size_t a = 0; a < points.size(); a++){
+		StudyPoint &p = points[a];
+		ostringstream name;
+		name << Work << "/scaling_" << p.T << "x" << p.I << "x" << p.L;
+
+		vector<RCLSPMSL_FamilySize> fam = FamilySizes(p.T, p.I, p.L);
+		long long largest = -1;
+		for(size_t f = 0; f < fam.size(); f++)
+			if (!fam[f].variables) {
+				p.rows += fam[f].objects;
+				p.nonzeros += fam[f].nonzeros;
+				if (fam[f].nonzeros > largest) {
+					largest = fam[f].nonzeros;
+					p.largest = fam[f].name;
+				}
+			}
+
+		if (done.count(name.str())) {
+			for(int b = 0; b < M_N; b++) p.m[b] = done[name.str()].m[b];
+			continue;
+		}
+
+		cout << "Point " << p.T << " x " << p.I << " x " << p.L << endl;
+
+
+		//Instance
+		RCLSPMSL_GeneratorParams gp = par;
+		gp.T = p.T; gp.I = p.I; gp.L = p.L;
+		RCLSPMSL_Instance inst;
+		GenerateInstance(gp, inst);
+
+		string Data = name.str() + ".dat";
+		ofstream outdata(Data.c_str());
+		WriteInstance(outdata, inst);
+		outdata.close();
+
+
+		//Construction and linear relaxation
+		string Record = name.str() + "_csr.json";
+		remove(Record.c_str());
+		string command = Bin + "/CSR " + Data + " " + name.str() + "_csr.out solve=1 results=" + Record + " > " + name.str() + "_csr.stdout 2>&1";
+		if (system(command.c_str()) != 0) cout << "    CSR did not end normally" << endl;
+
+		RCLSPMSL_Json rec;
+		if (ReadRecord(Record, rec)) {
+			p.m[M_CONCERT_BUILD] = PhaseTime(rec, "Concert build") + PhaseTime(rec, "Concert extraction");
+			p.m[M_CSR_BUILD] = PhaseTime(rec, "CSR build") + PhaseTime(rec, "CSR load");
+			p.m[M_LR] = PhaseTime(rec, "CSR LR");
+			p.m[M_LR_MEMORY] = rec.getNum("peak_rss_mb", NAN);
+		}
+		double LR = rec.getNum("bound", NAN);
+
+
+		//Heuristic: time, gap to the linear relaxation and time to the target gap
+		if (!Heuristic.empty()) {
+			Record = name.str() + "_heur.json";
+			remove(Record.c_str());
+			ostringstream heur;
+			heur << Bin << "/" << Heuristic << " " << Data << " " << name.str() << "_heur.out results=" << Record
+				 << " target_gap=" << TargetGap << " verbosity=0" << HeurOptions << " > " << name.str() << "_heur.stdout 2>&1";
+			if (system(heur.str().c_str()) != 0) cout << "    " << Heuristic << " did not end normally" << endl;
+
+			RCLSPMSL_Json hrec;
+			if (ReadRecord(Record, hrec) && hrec.getBool("solved", false)) {
+				double OF = hrec.getNum("OF", NAN);
+				p.m[M_HEUR_TIME] = hrec.getNum("time", NAN);
+				p.m[M_HEUR_GAP] = (!std::isnan(LR) && (OF != 0)) ? 100*(OF - LR)/OF : NAN;
+				p.m[M_HEUR_TARGET] = hrec.getNum("time_to_target", NAN);
+				p.m[M_HEUR_MEMORY] = hrec.getNum("peak_rss_mb", NAN);
+			}
+		}
+
+		done[name.str()] = p;
+	}
+
+
+
+	// ***** Fits: exponent of each measure along each axis, and projection to the target *****
+
+	double Exponent[3][M_N + 2], R2[3][M_N + 2];
+	bool Fitted[3][M_N + 2];
+	double BaseValue[M_N + 2];
+
+	//Measures M_N and M_N + 1: rows and nonzeros of the model
+	for(int b = 0; b < M_N + 2; b++){
+		BaseValue[b] = NAN;
+
+		for(int ax = 0; ax < 3; ax++){
+			vector<double> x, y;
+
+			for(size_t a = 0; a < points.size(); a++)
+				if (points[a].axis == Axes[ax]) {
+					const StudyPoint &p = points[a];
+					double v = (b < M_N) ? p.m[b] : (b == M_N) ? p.rows : p.nonzeros;
+					x.push_back(p.size(Axes[ax]));
+					y.push_back(v);
+					if ((p.T == Base[0]) && (p.I == Base[1]) && (p.L == Base[2])) BaseValue[b] = v;
+				}
+
+			Fitted[ax][b] = FitExponent(x, y, Exponent[ax][b], R2[ax][b]);
+		}
+	}
+
+
+	//Table of the points
+	ofstream out(argv[2]);
+	out << "axis,T,I,L,rows,nonzeros,largest_family";
+	for(int b = 0; b < M_N; b++) out << "," << MeasureName[b];
+	out << endl;
+
+	for(size_t a = 0; a < points.size(); a++){
+		const StudyPoint &p = points[a];
+		out << p.axis << "," << p.T << "," << p.I << "," << p.L << "," << p.rows << "," << p.nonzeros << "," << p.largest;
+		for(int b = 0; b < M_N; b++)
+			out << "," << Value(p.m[b]);
+		out << endl;
+	}
+
+
+	//Table of the exponents and of the projection to the target size
+	ofstream outfit(Fit.c_str());
+	outfit << "measure,exponent_T,r2_T,exponent_I,r2_I,exponent_L,r2_L,base,projection" << endl;
+
+	cout << endl;
+	cout << "Base = " << Base[0] << " x " << Base[1] << " x " << Base[2] << "  Target = " << Target[0] << " x " << Target[1] << " x " << Target[2]
+		 << " (T x I x L)" << endl;
+	cout << endl;
+	cout << setw(22) << left << "Measure" << right << setw(10) << "b(T)" << setw(10) << "b(I)" << setw(10) << "b(L)"
+		 << setw(16) << "Base" << setw(16) << "Projection" << endl;
+
+	for(int b = 0; b < M_N + 2; b++){
+		string measure = (b < M_N) ? MeasureName[b] : (b == M_N) ? "rows" : "nonzeros";
+		double projection = BaseValue[b];
+		char line[200];
+
+		outfit << measure;
+		cout << setw(22) << left << measure << right;
+
+		for(int ax = 0; ax < 3; ax++){
+			if (Fitted[ax][b]) {
+				outfit << "," << Value(Exponent[ax][b]) << "," << Value(R2[ax][b]);
+				sprintf(line, "%10.2f", Exponent[ax][b]);
+				projection *= pow((double)Target[ax]/Base[ax], Exponent[ax][b]);
+			}
+			  else {
+				outfit << ",,";
+				sprintf(line, "%10s", "-");
+				if (Target[ax] != Base[ax]) projection = NAN;
+			  }
+			cout << line;
+		}
+
+		outfit << "," << Value(BaseValue[b]) << "," << Value(projection) << endl;
+
+		sprintf(line, "%16.4g%16.4g", BaseValue[b], projection);
+		cout << line << endl;
+	}
+
+
+	//Families at the target size (exact counts): the variables by
+	//number and the constraints by nonzeros
+	vector<RCLSPMSL_FamilySize> fam = FamilySizes(Target[0], Target[1], Target[2]);
+	sort(fam.begin(), fam.end(), [](const RCLSPMSL_FamilySize &a, const RCLSPMSL_FamilySize &b) {
+		if (a.variables != b.variables) return a.variables;
+		return (a.variables) ? (a.objects > b.objects) : (a.nonzeros > b.nonzeros);
+	});
+
+	cout << endl;
+	cout << "Families at the Target Size" << endl;
+	cout << endl;
+	PrintFamilies(cout, fam);
+
+
+	return 0;
+
+}
@@ -0,0 +1,409 @@
+// ************************************************************************************* //
+//    Program to solve demand scenarios of the Facility Location Reformulation of the    //
+//    General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) //
+//	 																					 //
+//	  The model of the instance is built once, in compressed sparse rows, and it is	 //
+//	  loaded in the problem of each worker. For each scenario, only the values that	 //
+//	  depend on the demand are changed (see ChangeDemand in RCLSP-MSL_Callable.h),	 //
+//	  and the scenarios are solved in parallel by the workers. Each scenario starts	 //
+//	  from the binary variables of the nearest scenario already solved (smallest	 //
+//	  sum of the differences of the demand), or from the Constructive Heuristic		 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <ilcplex/cplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Callable.h"
+#include "RCLSP-MSL_Cache.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Results.h"
+
+
+using namespace std;
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+//Result of a scenario
+struct ScenarioResult {
+
+	bool solved;													  //the scenario has a solution
+	bool optimal;
+	int start;														  //scenario of the MIP start (-1: Constructive Heuristic, -2: none)
+	double OF, Bound, Gap, Time;
+	RCLSPMSL_Costs costs;
+	bool feasible;													  //solution accepted by the validator
+
+	RCLSPMSL_Solution sol;											  //binary variables (Y, Z and W) of the solution
+
+	ScenarioResult() : solved(false), optimal(false), start(-2), OF(0), Bound(0), Gap(0), Time(0), feasible(false) {}
+
+};
+
+
+
+
+//Data shared by the workers
+struct ScenarioPool {
+
+	const RCLSPMSL_Instance *inst;
+	const vector<vector<double> > *demand;
+	const RCLSPMSL_Columns *col;
+	const vector<RCLSPMSL_Rows> *rows;
+
+	int threads;													  //threads of the optimization package in each worker
+	double timeLimit, gap;
+
+	atomic<int> next;												  //next scenario to be solved
+	mutex lock;														  //access to the results
+	vector<ScenarioResult> result;
+
+};
+
+
+
+
+//Nearest scenario already solved (with the lock of the pool)
+//Return -1 if there is no scenario solved
+static int NearestSolved(const ScenarioPool &pool, int s)
+{
+	const vector<vector<double> > &demand = *pool.demand;
+	int nearest = -1;
+	double best = 0;
+
+	for(size_t a = 0; a < pool.result.size(); a++)
+	   if (pool.result[a].solved) {
+		  double dist = 0;
+		  for(size_t n = 0; n < demand[s].size(); n++)
+			 dist += fabs(demand[s][n] - demand[a][n]);
+
+		  if ((nearest < 0) || (dist < best)) {
+			 nearest = (int)a;
+			 best = dist;
+		  }
+	   }
+
+	return nearest;
+}
+
+
+
+
+//Worker: load the model in its own problem and solve
+//the scenarios taken in order from the pool
+static void SolveScenarios(ScenarioPool &pool)
+{
+	const RCLSPMSL_Columns &col = *pool.col;
+	const vector<RCLSPMSL_Rows> &rows = *pool.rows;
+	int S = (int)pool.demand->size(), s, status = 0;
+
+	CPXENVptr env = CPXopenCPLEX(&status);
+	CPXLPptr lp = NULL;
+
+	if (env != NULL) {
+		CPXsetintparam(env, CPX_PARAM_SCRIND, CPX_OFF);
+		CPXsetintparam(env, CPX_PARAM_THREADS, pool.threads);
+		CPXsetdblparam(env, CPX_PARAM_TILIM, pool.timeLimit);
+		CPXsetdblparam(env, CPX_PARAM_EPGAP, pool.gap);
+		lp = CPXcreateprob(env, &status, "RCLSP-MSL");
+	}
+
+	if (lp != NULL) status = LoadModel(env, lp, col, rows, true);
+
+	if ((env == NULL) || (lp == NULL) || status) {
+		lock_guard<mutex> guard(pool.lock);
+		cerr << "Could not load the model of the worker, status " << status << endl;
+		if (lp != NULL) CPXfreeprob(env, &lp);
+		if (env != NULL) CPXcloseCPLEX(&env);
+		return;
+	}
+
+
+	//Instance of the scenario (same data, demand of the scenario)
+	RCLSPMSL_Instance inst = *pool.inst;
+	vector<double> x(col.size());
+
+	for(s = pool.next++; s < S; s = pool.next++){
+
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		RCLSPMSL_TraceScope Trace_Scenario("Scenario " + to_string(s), "window");
+		ScenarioResult res;
+
+		inst.d = (*pool.demand)[s];
+		status = ChangeDemand(env, lp, inst, col, rows);
+
+
+		//MIP start: nearest scenario already solved, or Constructive Heuristic
+		RCLSPMSL_Solution start;
+		{
+			lock_guard<mutex> guard(pool.lock);
+			res.start = NearestSolved(pool, s);
+			if (res.start >= 0) start = pool.result[res.start].sol;
+		}
+
+		if (res.start < 0) {
+			string message;
+			res.start = (ConstructiveHeuristic(inst, start, message)) ? -1 : -2;
+		}
+
+		if ((status == 0) && (res.start != -2)) AddMIPStartColumns(env, lp, inst, col, start);
+
+
+		//Solve the scenario and recover its solution
+		if (status == 0) status = CPXmipopt(env, lp);
+
+		if ((status == 0) && (CPXgetx(env, lp, &x[0], 0, col.size() - 1) == 0)) {
+			int stat = CPXgetstat(env, lp);
+
+			res.solved = true;
+			res.optimal = ((stat == CPXMIP_OPTIMAL) || (stat == CPXMIP_OPTIMAL_TOL));
+			CPXgetobjval(env, lp, &res.OF);
+			CPXgetbestobjval(env, lp, &res.Bound);
+			CPXgetmiprelgap(env, lp, &res.Gap);
+
+			SolutionFromColumns(inst, col, x, res.sol);
+			res.costs = ComputeCosts(inst, res.sol);
+			res.feasible = Validate(inst, res.sol).feasible();
+
+			//Only the binary variables are kept, for the MIP starts
+			res.sol.S.clear(); res.sol.Dp.clear(); res.sol.Dm.clear(); res.sol.FL.clear(); res.sol.V.clear();
+		}
+
+		res.Time = Elapsed(begin);
+
+		lock_guard<mutex> guard(pool.lock);
+		pool.result[s] = res;
+	}
+
+	CPXfreeprob(env, &lp);
+	CPXcloseCPLEX(&env);
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 4) {
+		cerr << "Usage: Scenarios <input data file> <scenario file> <output data file> [workers=n] [threads=n] "
+				"[time=s] [gap=g] [cache=file] [trace=file] [results=file]" << endl;
+		return 1;
+	}
+
+
+	//Input Data File and Scenario File
+	ifstream in(argv[1]);
+	ifstream insc(argv[2]);
+
+
+	//Output Data File
+	ofstream out(argv[3]);
+
+
+	//Options: workers - number of scenarios solved at the same time
+	//threads - threads of the optimization package in each worker
+	//time    - time limit of each scenario (seconds)
+	//gap     - relative gap of each scenario
+	//cache   - file of the cache of the sparse rows (RCLSP-MSL_Cache.h)
+	//trace   - file of the trace events of the phases (RCLSP-MSL_Trace.h)
+	//results - file of the records of the scenarios (the output data file with .json if it is not given)
+	RCLSPMSL_Options Options(argc, argv, 4);
+	int Workers = Options.getInt("workers", 1);
+	int Threads = Options.getInt("threads", 1);
+	double TimeLimit = Options.getNum("time", 1800);
+	double Gap = Options.getNum("gap", 0.0001);
+	string Cache = Options.getString("cache", "");
+	Trace().open(Options.getString("trace", ""), "Scenarios");
+	string ResultsFile = Options.getString("results", string(argv[3]) + ".json");
+
+
+
+	//Read the instance and the demand scenarios
+	Trace().step("Run", "Read instance");
+	RCLSPMSL_Instance inst;
+	vector<vector<double> > demand;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+	if (!insc || !ReadScenarios(insc, inst, demand)) {
+		cerr << "No such file: " << argv[2] << endl;
+		return 1;
+	}
+
+	int S = (int)demand.size();
+	if (Workers > S) Workers = S;
+	if (Workers < 1) Workers = 1;
+
+
+
+	// ***** Build the model once (demand of the instance) *****
+
+	Trace().step("Run", "Build model");
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	RCLSPMSL_Columns col;
+	vector<RCLSPMSL_Rows> rows(ROW_NFAMILIES);
+
+	if (!Cache.empty()) CachedModel(Cache, inst, col, rows, Workers);
+	  else {
+		col.build(inst, true);
+		BuildModel(inst, col, rows, Workers);
+	}
+
+	double Time_Build = Elapsed(begin);
+
+
+
+	// ***** Solve the scenarios by the workers *****
+
+	Trace().step("Run", "Scenarios");
+	ScenarioPool pool;
+	pool.inst = &inst;
+	pool.demand = &demand;
+	pool.col = &col;
+	pool.rows = &rows;
+	pool.threads = Threads;
+	pool.timeLimit = TimeLimit;
+	pool.gap = Gap;
+	pool.next = 0;
+	pool.result.resize(S);
+
+	begin = std::chrono::steady_clock::now();
+
+	vector<thread> workers;
+	for(int w = 1; w < Workers; w++)
+		workers.push_back(thread(SolveScenarios, ref(pool)));
+
+	SolveScenarios(pool);
+
+	for(size_t w = 0; w < workers.size(); w++)
+		workers[w].join();
+
+	double Time_Scenarios = Elapsed(begin);
+
+
+
+	// ****************************************************************************************************
+	//Print in the output file
+	Trace().step("Run", "Report");
+	int Solved = 0, Optimal = 0, Feasible = 0;
+	double OF_Sum = 0, OF_Min = 0, OF_Max = 0;
+
+	out << "***** Demand Scenarios of the Facility Location Reformulation of the General Capacitated *****" << endl;
+	out << "*****          Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)          *****" << endl;
+	out << endl << endl;
+	out << "T = " << inst.T << "  I = " << inst.I << "  L = " << inst.L << endl;
+	out << "Scenarios = " << S << endl;
+	out << "Workers = " << Workers << "  Threads = " << Threads << endl;
+	out << "Time Limit = " << TimeLimit << "  Gap = " << Gap << endl;
+	out << endl;
+	out << "Build Time = " << Time_Build << endl;
+	out << "Scenarios Time = " << Time_Scenarios << endl;
+	out << endl << endl;
+	out << "************************************* Scenarios *************************************" << endl;
+	out << endl;
+
+	out << setw(8) << "Scenario" << setw(10) << "Status" << setw(7) << "Start"
+		<< setw(16) << "OF" << setw(16) << "Bound" << setw(10) << "Gap"
+		<< setw(14) << "Production" << setw(14) << "SetupItem" << setw(14) << "Inventory"
+		<< setw(14) << "Handling" << setw(14) << "SetupLocation" << setw(14) << "Relocation"
+		<< setw(9) << "Valid" << setw(10) << "Time" << endl;
+
+	for(int s = 0; s < S; s++){
+		const ScenarioResult &res = pool.result[s];
+
+		out << setw(8) << s;
+
+		if (!res.solved) {
+			out << setw(10) << "NoSol" << setw(7) << "-" << endl;
+			continue;
+		}
+
+		out << setw(10) << ((res.optimal) ? "Optimal" : "Feasible");
+		if (res.start >= 0) out << setw(7) << res.start;
+		  else out << setw(7) << ((res.start == -1) ? "CH" : "-");
+
+		out << fixed << setprecision(2)
+			<< setw(16) << res.OF << setw(16) << res.Bound << setprecision(4) << setw(10) << res.Gap << setprecision(2)
+			<< setw(14) << res.costs.CProdItem << setw(14) << res.costs.CSetupItem << setw(14) << res.costs.CInventItem
+			<< setw(14) << res.costs.CHandItem << setw(14) << res.costs.CSetupLocal << setw(14) << res.costs.CRelocItem
+			<< setw(9) << ((res.feasible) ? "Yes" : "No") << setw(10) << res.Time << endl;
+		out.unsetf(ios::floatfield);
+		out << setprecision(6);
+
+		if ((Solved == 0) || (res.OF < OF_Min)) OF_Min = res.OF;
+		if ((Solved == 0) || (res.OF > OF_Max)) OF_Max = res.OF;
+		OF_Sum += res.OF;
+		Solved++;
+		if (res.optimal) Optimal++;
+		if (res.feasible) Feasible++;
+	}
+
+	out << endl << endl;
+	out << "Solved Scenarios = " << Solved << endl;
+	out << "Optimal Scenarios = " << Optimal << endl;
+	out << "Validated Scenarios = " << Feasible << endl;
+	if (Solved > 0) {
+		out << "Average Objective Function Value = " << OF_Sum/Solved << endl;
+		out << "Minimum Objective Function Value = " << OF_Min << endl;
+		out << "Maximum Objective Function Value = " << OF_Max << endl;
+	}
+	out << endl << endl;
+	out << "*************************************************************************************" << endl;
+	// ****************************************************************************************************
+
+
+
+	//Records of the scenarios, one for each scenario (RCLSP-MSL_Results.h)
+	Trace().step("Run", "");
+
+	for(int s = 0; s < S; s++){
+		const ScenarioResult &res = pool.result[s];
+
+		Results().open(ResultsFile, "", "Scenarios", argv[1]);
+		Results().setScenario(s);
+		Results().size(inst.T, inst.I, inst.L);
+		if (res.solved) Results().values((res.optimal) ? "Optimal" : "Feasible", res.costs, res.feasible, res.Bound, res.Time);
+		Results().write();
+	}
+
+
+	return (Solved == S) ? 0 : 2;
+
+}
@@ -0,0 +1,522 @@
+// ************************************************************************************* //
+//    Solver service of the Facility Location Reformulation of the General Capacitated   //
+//            Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL)             //
+//	 																					 //
+//	  The service is started once and keeps the instances and their models (loaded	 //
+//	  through the Callable Library) in memory. It reads one request in JSON by line	 //
+//	  from the standard input and writes one reply in JSON by line to the standard	 //
+//	  output:																			 //
+//																						 //
+//	  {"op":"load","name":"a","file":"data.dat"}										 //
+//	  {"op":"solve","name":"a","method":"RFH","time":60,"params":{"fix":1},			 //
+//	   "start":"CH","demand":[...],"solution":true}									 //
+//	  {"op":"list"}  {"op":"unload","name":"a"}  {"op":"quit"}						 //
+//																						 //
+//	  Methods: LR (linear relaxation), MIP (RCLSP-MSL), RFH (Relax-and-Fix with a	 //
+//	  time-oriented decomposition), SH (Sequential Heuristic - Version 4), FO		 //
+//	  (Fix-and-Optimize) and SH_FO (Sequential Heuristic with Fix-and-Optimize).		 //
+//	  The member "id" of a request is returned in its reply							 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <ilcplex/cplex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Sparse.h"
+#include "RCLSP-MSL_Callable.h"
+#include "RCLSP-MSL_Constructive.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Json.h"
+#include "RCLSP-MSL_Trace.h"
+
+
+using namespace std;
+
+
+
+//Wall-clock time (seconds) since begin
+static double Elapsed(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+
+
+//Instance kept in memory by the service, with its model
+struct Resident {
+
+	RCLSPMSL_Instance inst;											  //instance (demand of the last request)
+	vector<double> demand;											  //demand of the data file
+	RCLSPMSL_Columns col;
+	vector<RCLSPMSL_Rows> rows;
+	CPXLPptr lp;
+
+	bool hasLast;													  //solution of the last request solved
+	RCLSPMSL_Solution last;
+
+	Resident() : lp(NULL), hasLast(false) {}
+
+};
+
+
+
+
+//Result of a solve request
+struct ServiceResult {
+
+	bool solved;
+	double OF, Bound, Time;
+	int windows;
+	bool feasible;
+	RCLSPMSL_Costs costs;
+
+	ServiceResult() : solved(false), OF(0), Bound(0), Time(0), windows(0), feasible(false) {}
+
+};
+
+
+
+
+//Fix the setup of items (Y) at their values in the solution
+//Return the status of the Callable Library (0 - success)
+static int FixSetups(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+					 const RCLSPMSL_Solution &sol)
+{
+	vector<int> ind;
+	vector<char> lu;
+	vector<double> bd;
+
+	for(int i = 0; i < inst.I; i++)
+	   for(int t = 0; t < inst.T; t++)
+		  BinaryBounds(col.y(i, t), sol.Y[inst.it(i, t)], false, ind, lu, bd);
+
+	return CPXchgbds(env, lp, (int)ind.size(), &ind[0], &lu[0], &bd[0]);
+}
+
+
+
+
+//Relax-and-Fix Heuristic with a time-oriented decomposition: in each
+//time-window (fix + overlap periods) the binary variables are integer, the
+//ones after it are continuous and the ones before it are fixed
+//Return true if a solution was found
+static bool RelaxAndFix(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+						RCLSPMSL_Solution &sol, bool start, int fix, int overlap, double timeLimit, int &windows)
+{
+	int T = inst.T, size = fix + overlap, nit = 0, b, e;
+	bool solved = true;
+
+	for(b = 0; b < T; b += fix){
+		nit++;
+		if (b + size >= T) break;
+	}
+
+	double timeWindow = timeLimit/nit, timeWindow_left = 0;
+	windows = 0;
+
+	for(b = 0; (b < T) && (solved); b += fix){
+		std::chrono::steady_clock::time_point window = std::chrono::steady_clock::now();
+
+		e = min(T, b + size);
+		solved = (SetBinaryTypes(env, lp, inst, col, 0, e) == 0) && (FixBinaries(env, lp, inst, col, sol, b, T) == 0) &&
+				 SolveColumns(env, lp, inst, col, sol, (start) && (b == 0), timeWindow + timeWindow_left);
+		windows++;
+
+		timeWindow_left += timeWindow - Elapsed(window);
+
+		if (e == T) break;
+	}
+
+	return solved;
+}
+
+
+
+
+//Sequential Heuristic - Version 4: Problem 1 with the setup of items (Y)
+//integer, then Problem 2 with Y fixed and the other binary variables integer
+//Return true if a solution was found
+static bool Sequential(CPXENVptr env, CPXLPptr lp, const RCLSPMSL_Instance &inst, const RCLSPMSL_Columns &col,
+					   RCLSPMSL_Solution &sol, bool start, double timeLimit)
+{
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	if (SetBinaryTypes(env, lp, inst, col, 0, inst.T, true, false) || FixBinaries(env, lp, inst, col, sol, 0, inst.T) ||
+		!SolveColumns(env, lp, inst, col, sol, start, timeLimit/2)) return false;
+
+	return (SetBinaryTypes(env, lp, inst, col, 0, inst.T) == 0) && (FixSetups(env, lp, inst, col, sol) == 0) &&
+		   SolveColumns(env, lp, inst, col, sol, false, timeLimit - Elapsed(begin));
+}
+
+
+
+
+//Solve a request with the method on the model of the instance
+//Return false if the request is not valid (message)
+static bool SolveRequest(CPXENVptr env, Resident &r, const RCLSPMSL_Json &req, ServiceResult &res, string &message)
+{
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	const RCLSPMSL_Instance &inst = r.inst;
+	string method = req.getString("method", "SH_FO");
+	double timeLimit = req.getNum("time", 1800);
+
+	RCLSPMSL_Json none;
+	const RCLSPMSL_Json *params = req.get("params");
+	if (params == NULL) params = &none;
+
+
+	if ((params->getNum("fix", 1) < 1) || (params->getNum("overlap", 1) < 0)) {
+		message = "Invalid parameters of the time-windows (fix >= 1, overlap >= 0)";
+		return false;
+	}
+
+
+	//Options of the optimization package for the request
+	CPXsetintparam(env, CPX_PARAM_THREADS, (int)req.getNum("threads", 1));
+	CPXsetdblparam(env, CPX_PARAM_EPGAP, req.getNum("gap", 0.0001));
+
+
+	//Initial solution: Constructive Heuristic (CH), solution
+	//of the last request of the instance (last) or none
+	string startFrom = req.getString("start", "CH");
+	RCLSPMSL_Solution sol;
+	bool start = false;
+
+	if ((startFrom == "last") && (r.hasLast)) {
+		sol = r.last;
+		start = true;
+	}
+	  else if (startFrom != "none") start = ConstructiveHeuristic(inst, sol, message);
+
+	if (!start) sol.resize(inst);
+	message.clear();
+
+
+	//All the binary variables free, then each method changes their types and bounds
+	bool ok = (FixBinaries(env, r.lp, inst, r.col, sol, 0, inst.T) == 0);
+	bool full = false;
+
+	if (method == "LR") {
+		res.solved = ok && (SetBinaryTypes(env, r.lp, inst, r.col, 0, 0) == 0) &&
+					 SolveColumns(env, r.lp, inst, r.col, sol, false, timeLimit);
+		if (res.solved) CPXgetobjval(env, r.lp, &res.Bound);
+	}
+	  else if (method == "MIP") {
+		res.solved = ok && (SetBinaryTypes(env, r.lp, inst, r.col, 0, inst.T) == 0) &&
+					 SolveColumns(env, r.lp, inst, r.col, sol, start, timeLimit);
+		if (res.solved) CPXgetbestobjval(env, r.lp, &res.Bound);
+	}
+	  else if (method == "RFH") {
+		res.solved = ok && RelaxAndFix(env, r.lp, inst, r.col, sol, start, (int)params->getNum("fix", 1),
+									   (int)params->getNum("overlap", 1), timeLimit, res.windows);
+	}
+	  else if ((method == "SH") || (method == "SH_v4")) {
+		res.solved = ok && Sequential(env, r.lp, inst, r.col, sol, start, timeLimit);
+		res.windows = 2;
+	}
+	  else if (method == "FO") {
+		if (!start) {
+			message = "FO needs an initial solution (start CH or last)";
+			return false;
+		}
+		res.solved = ok && (SetBinaryTypes(env, r.lp, inst, r.col, 0, inst.T) == 0) &&
+					 FixAndOptimizeColumns(env, r.lp, inst, r.col, sol, 0, (int)params->getNum("fix", 1),
+										   (int)params->getNum("overlap", 2), timeLimit, res.windows, full);
+	}
+	  else if ((method == "SH_FO") || (method == "SH_v4_FO")) {
+		//The Fix-and-Optimize Heuristic has the time left by the Sequential Heuristic
+		res.solved = ok && Sequential(env, r.lp, inst, r.col, sol, start, timeLimit);
+
+		double timeLeft = timeLimit - Elapsed(begin);
+		if ((res.solved) && (timeLeft > 1)) {
+			RCLSPMSL_Solution last = sol;
+			if (!((SetBinaryTypes(env, r.lp, inst, r.col, 0, inst.T) == 0) &&
+				  FixAndOptimizeColumns(env, r.lp, inst, r.col, sol, 0, (int)params->getNum("fix", 1),
+										(int)params->getNum("overlap", 2), timeLeft, res.windows, full)))
+			   sol = last;
+		}
+		res.windows += 2;
+	}
+	  else {
+		message = "Unknown method " + method + " (LR, MIP, RFH, SH, FO or SH_FO)";
+		return false;
+	}
+
+	res.Time = Elapsed(begin);
+
+	if (res.solved) {
+		res.costs = ComputeCosts(inst, sol);
+		res.OF = res.costs.OF;
+		res.feasible = Validate(inst, sol).feasible();
+
+		r.last = sol;
+		r.hasLast = true;
+	}
+
+	return true;
+}
+
+
+
+
+//Write the member id of the request (a number or a string) in the reply
+static void WriteId(ostream &out, const RCLSPMSL_Json &req)
+{
+	const RCLSPMSL_Json *id = req.get("id");
+	if (id == NULL) return;
+
+	out << "\"id\":";
+	if (id->type == RCLSPMSL_Json::String) WriteJsonString(out, id->text);
+	  else WriteJsonNumber(out, id->number);
+	out << ",";
+}
+
+
+
+
+//Reply of an error
+static string ErrorReply(const RCLSPMSL_Json &req, const string &message)
+{
+	ostringstream out;
+
+	out << "{";
+	WriteId(out, req);
+	out << "\"ok\":false,\"error\":";
+	WriteJsonString(out, message);
+	out << "}";
+
+	return out.str();
+}
+
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	//Options: threads - threads used to build the models
+	//trace - file of the trace events of the requests (RCLSP-MSL_Trace.h),
+	//written when the service stops
+	RCLSPMSL_Options Options(argc, argv, 1);
+	int Threads = Options.getInt("threads", 1);
+	Trace().open(Options.getString("trace", ""), "Service");
+
+
+	//Environment of the optimization package (opened once)
+	int status = 0;
+	CPXENVptr env = CPXopenCPLEX(&status);
+
+	if (env == NULL) {
+		cerr << "Could not open the optimization package, status " << status << endl;
+		return 1;
+	}
+
+	CPXsetintparam(env, CPX_PARAM_SCRIND, CPX_OFF);
+
+
+	map<string, Resident> resident;
+	string line;
+
+	while (getline(cin, line)) {
+
+		if (line.find_first_not_of(" \t\r") == string::npos) continue;
+
+		RCLSPMSL_Json req;
+		if (!ReadJson(line, req) || (req.type != RCLSPMSL_Json::Object)) {
+			cout << ErrorReply(req, "The request is not a JSON object") << endl;
+			continue;
+		}
+
+		string op = req.getString("op", "");
+		string name = req.getString("name", "");
+		ostringstream reply;
+		RCLSPMSL_TraceScope Trace_Request(op + " " + name, "request");
+
+
+		//Stop the service
+		if (op == "quit") {
+			reply << "{";
+			WriteId(reply, req);
+			reply << "\"ok\":true}";
+			cout << reply.str() << endl;
+			break;
+		}
+
+
+		//Read the instance and load its model (a resident
+		//instance with the same name is replaced)
+		if (op == "load") {
+			std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+			string file = req.getString("file", "");
+			ifstream in(file.c_str());
+			Resident r;
+
+			if (name.empty() || !in || !ReadInstance(in, r.inst)) {
+				cout << ErrorReply(req, "No such file: " + file) << endl;
+				continue;
+			}
+
+			r.demand = r.inst.d;
+			r.rows.resize(ROW_NFAMILIES);
+			r.col.build(r.inst, true);
+			BuildModel(r.inst, r.col, r.rows, Threads);
+
+			r.lp = CPXcreateprob(env, &status, name.c_str());
+			if ((r.lp == NULL) || LoadModel(env, r.lp, r.col, r.rows, true)) {
+				if (r.lp != NULL) CPXfreeprob(env, &r.lp);
+				cout << ErrorReply(req, "Could not load the model of " + file) << endl;
+				continue;
+			}
+
+			if (resident.count(name)) CPXfreeprob(env, &resident[name].lp);
+			resident[name] = r;
+
+			reply << "{";
+			WriteId(reply, req);
+			reply << "\"ok\":true,\"name\":";
+			WriteJsonString(reply, name);
+			reply << ",\"T\":" << r.inst.T << ",\"I\":" << r.inst.I << ",\"L\":" << r.inst.L << ",\"time\":";
+			WriteJsonNumber(reply, Elapsed(begin));
+			reply << "}";
+			cout << reply.str() << endl;
+			continue;
+		}
+
+
+		//Names of the resident instances
+		if (op == "list") {
+			reply << "{";
+			WriteId(reply, req);
+			reply << "\"ok\":true,\"instances\":[";
+			for(map<string, Resident>::iterator it = resident.begin(); it != resident.end(); ++it){
+				if (it != resident.begin()) reply << ",";
+				WriteJsonString(reply, it->first);
+			}
+			reply << "]}";
+			cout << reply.str() << endl;
+			continue;
+		}
+
+
+		if ((op != "unload") && (op != "solve")) {
+			cout << ErrorReply(req, "Unknown operation " + op + " (load, solve, list, unload or quit)") << endl;
+			continue;
+		}
+
+		map<string, Resident>::iterator it = resident.find(name);
+		if (it == resident.end()) {
+			cout << ErrorReply(req, "No instance " + name + " in the service") << endl;
+			continue;
+		}
+
+
+		//Free the model of the instance
+		if (op == "unload") {
+			CPXfreeprob(env, &it->second.lp);
+			resident.erase(it);
+
+			reply << "{";
+			WriteId(reply, req);
+			reply << "\"ok\":true}";
+			cout << reply.str() << endl;
+			continue;
+		}
+
+
+		//Solve the instance: demand of the request (what-if) or of the data file
+		Resident &r = it->second;
+		const RCLSPMSL_Json *demand = req.get("demand");
+		vector<double> d = r.demand;
+
+		if (demand != NULL) {
+			if ((demand->type != RCLSPMSL_Json::Array) || (demand->items.size() != r.demand.size())) {
+				cout << ErrorReply(req, "The demand must have I*T values") << endl;
+				continue;
+			}
+
+			for(size_t n = 0; n < d.size(); n++) d[n] = demand->items[n].number;
+		}
+
+		if (d != r.inst.d) {
+			r.inst.d = d;
+
+			if (ChangeDemand(env, r.lp, r.inst, r.col, r.rows)) {
+				cout << ErrorReply(req, "Could not change the demand") << endl;
+				continue;
+			}
+		}
+
+		ServiceResult res;
+		string message;
+
+		if (!SolveRequest(env, r, req, res, message)) {
+			cout << ErrorReply(req, message) << endl;
+			continue;
+		}
+
+		reply << "{";
+		WriteId(reply, req);
+		reply << "\"ok\":true,\"name\":";
+		WriteJsonString(reply, name);
+		reply << ",\"method\":";
+		WriteJsonString(reply, req.getString("method", "SH_FO"));
+		reply << ",\"solved\":" << ((res.solved) ? "true" : "false") << ",\"time\":";
+		WriteJsonNumber(reply, res.Time);
+		reply << ",\"windows\":" << res.windows;
+
+		if (res.solved) {
+			const RCLSPMSL_Costs &c = res.costs;
+
+			reply << ",\"OF\":"; WriteJsonNumber(reply, res.OF);
+			if (res.Bound != 0) { reply << ",\"bound\":"; WriteJsonNumber(reply, res.Bound); }
+			reply << ",\"feasible\":" << ((res.feasible) ? "true" : "false");
+
+			reply << ",\"costs\":{\"production\":"; WriteJsonNumber(reply, c.CProdItem);
+			reply << ",\"setup_item\":"; WriteJsonNumber(reply, c.CSetupItem);
+			reply << ",\"inventory\":"; WriteJsonNumber(reply, c.CInventItem);
+			reply << ",\"handling\":"; WriteJsonNumber(reply, c.CHandItem);
+			reply << ",\"setup_location\":"; WriteJsonNumber(reply, c.CSetupLocal);
+			reply << ",\"relocation\":"; WriteJsonNumber(reply, c.CRelocItem);
+			reply << "}";
+
+			if (req.getBool("solution", true)) {
+				reply << ",\"solution\":{\"Y\":"; WriteJsonArray(reply, r.last.Y);
+				reply << ",\"Z\":"; WriteJsonArray(reply, r.last.Z);
+				reply << ",\"W\":"; WriteJsonArray(reply, r.last.W);
+				reply << ",\"S\":"; WriteJsonArray(reply, r.last.S);
+				reply << "}";
+			}
+		}
+
+		reply << "}";
+		cout << reply.str() << endl;
+	}
+
+
+	for(map<string, Resident>::iterator it = resident.begin(); it != resident.end(); ++it)
+		CPXfreeprob(env, &it->second.lp);
+	CPXcloseCPLEX(&env);
+
+	return 0;
+
+}
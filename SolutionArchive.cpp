@@ -0,0 +1,118 @@
+// ************************************************************************************* //
+//    Program to convert the solutions of the Facility Location Reformulation of the     //
+//    General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) //
+//	 																					 //
+//	  Between the binary archive (RCLSP-MSL_Archive.h, option archive=<file> of the	 //
+//	  programs) and the text of the output files: an archive is converted to the		 //
+//	  text of the solution (read by Validator), and the last solution printed in an	 //
+//	  output file is converted to an archive										 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Archive.h"
+
+
+using namespace std;
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 4) {
+		cerr << "Usage: SolutionArchive <input data file> <archive or output data file> <output data file or archive>" << endl;
+		return 1;
+	}
+
+
+	//Input Data File
+	ifstream in(argv[1]);
+	RCLSPMSL_Instance inst;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+
+	//The file to be converted is an archive if it begins with the identification of the archives
+	ifstream from(argv[2], ios::binary);
+	char magic[sizeof(ARCHIVE_MAGIC)] = { 0 };
+
+	if (!from || !from.read(magic, sizeof(magic))) {
+		cerr << "No such file: " << argv[2] << endl;
+		return 1;
+	}
+
+	bool archive = (memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) == 0);
+	from.clear();
+	from.seekg(0);
+
+
+	//Read the solution
+	RCLSPMSL_Solution sol;
+	double OF = 0;
+	clock_t begin = clock();
+
+	if ((archive && !ReadSolutionArchive(from, inst, sol, OF)) || (!archive && !ReadSolution(from, inst, sol, OF))) {
+		cerr << "No solution in the file: " << argv[2] << endl;
+		return 1;
+	}
+
+	double Time_Read = (double)(clock() - begin)/CLOCKS_PER_SEC;
+
+
+	//Write the solution: the text of the output files (10 significant
+	//digits) or the archive
+	begin = clock();
+	ofstream out(argv[3], (archive) ? ios::out : ios::out | ios::binary);
+
+	if (archive) {
+		out.precision(10);
+		out << "Objective Function Value = " << OF << endl;
+		out << endl;
+		PrintSolution(out, inst, sol);
+	}
+	  else WriteSolutionArchive(out, sol, OF);
+
+	out.close();
+	double Time_Write = (double)(clock() - begin)/CLOCKS_PER_SEC;
+
+	if (!out) {
+		cerr << "The file could not be written: " << argv[3] << endl;
+		return 1;
+	}
+
+
+
+	// ****************************************************************************************************
+	//Print in the standard output
+	cout << ((archive) ? "Archive to text" : "Text to archive") << endl;
+	cout << "Objective Function Value = " << OF << endl;
+	cout << "Relocations = " << sol.V.size() << endl;
+	cout << "Time Read = " << Time_Read << endl;
+	cout << "Time Write = " << Time_Write << endl;
+	// ****************************************************************************************************
+
+
+	return 0;
+
+}
@@ -0,0 +1,123 @@
+// ************************************************************************************* //
+//    Program to validate a solution of the Facility Location Reformulation of the       //
+//    General Capacitated Lot-Sizing Problem with Multiple Storage Locations (RCLSP-MSL) //
+//	 																					 //
+//	  The last solution printed in an output file of the programs is checked			 //
+//	  against all the constraints of the instance, without an optimization package.	 //
+//	  See RCLSP-MSL_Validator.h														 //
+// ************************************************************************************* //
+
+
+
+//Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "RCLSP-MSL_Instance.h"
+#include "RCLSP-MSL_Solution.h"
+#include "RCLSP-MSL_Validator.h"
+#include "RCLSP-MSL_Options.h"
+#include "RCLSP-MSL_Trace.h"
+#include "RCLSP-MSL_Results.h"
+
+
+using namespace std;
+
+
+
+// ********************************************************************************************** //
+// ******************************** BEGINING OF THE MAIN PROGRAM ******************************** //
+// ********************************************************************************************** //
+
+
+int main(int argc, char **argv)
+{
+
+	if (argc < 3) {
+		cerr << "Usage: Validator <input data file> <output data file> [tolerance] [trace=file] [results=file]" << endl;
+		return 1;
+	}
+
+
+	//Input Data File
+	ifstream in(argv[1]);
+
+
+	//Output Data File of the program to be validated
+	ifstream sol_in(argv[2]);
+
+
+	//Tolerance of the constraints, relative to the magnitude of each row
+	//(the values in the output files are printed with 6 significant digits)
+	double tol = ((argc > 3) && (strchr(argv[3], '=') == NULL)) ? atof(argv[3]) : 0.0001;
+
+
+	//Options: trace - file of the trace events of the phases (RCLSP-MSL_Trace.h)
+	//results - file of the records of the runs (RCLSP-MSL_Results.h), no record if it is not given
+	RCLSPMSL_Options Options(argc, argv, 3);
+	Trace().open(Options.getString("trace", ""), "Validator");
+	Results().open(Options.getString("results", ""), "", "Validator", argv[1]);
+
+
+
+	//Read the instance and the solution
+	Trace().step("Run", "Read instance");
+	RCLSPMSL_Instance inst;
+
+	if (!in || !ReadInstance(in, inst)) {
+		cerr << "No such file: " << argv[1] << endl;
+		return 1;
+	}
+
+	RCLSPMSL_Solution sol;
+	double OF;
+
+	if (!sol_in || !ReadSolution(sol_in, inst, sol, OF)) {
+		cerr << "No solution in the file: " << argv[2] << endl;
+		return 1;
+	}
+
+
+
+	// ***** Validate the solution *****
+
+	Trace().step("Run", "Validate");
+	clock_t begin = clock();
+
+	RCLSPMSL_Validation v = Validate(inst, sol, tol);
+
+	double Time_Val = (double)(clock() - begin)/CLOCKS_PER_SEC;
+
+
+
+	// ****************************************************************************************************
+	//Print in the standard output
+	PrintValidation(cout, v);
+	cout << endl;
+	cout << "Objective Function Value = " << OF << endl;
+	cout << "Difference of the Objective Function Value = " << v.costs.OF - OF << endl;
+	cout << "Time = " << Time_Val << endl;
+	// ****************************************************************************************************
+
+
+
+	//The solution is valid if no constraint is violated and
+	//the objective function value is the reported one
+	bool valid = v.feasible() && (fabs(v.costs.OF - OF) <= tol*max(1.0, fabs(OF)));
+
+
+	//Record of the validation (status Valid or Invalid)
+	Trace().step("Run", "");
+	Results().size(inst.T, inst.I, inst.L);
+	Results().values((valid) ? "Valid" : "Invalid", v.costs, v.feasible(), NAN, Time_Val);
+	Results().write();
+
+	return (valid) ? 0 : 3;
+
+}